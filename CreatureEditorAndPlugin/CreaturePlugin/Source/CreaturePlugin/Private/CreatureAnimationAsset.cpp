@@ -75,6 +75,16 @@ FString& UCreatureAnimationAsset::GetJsonString()
 	return CreatureFileJSonData;
 }
 
+TArray<uint8>* UCreatureAnimationAsset::GetCookedBinary()
+{
+	if (CreatureCookedBinary.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	return &CreatureCookedBinary;
+}
+
 void UCreatureAnimationAsset::SetNewJsonString(FString & str_in)
 {
 	CreatureRawJSONString = str_in;
@@ -128,19 +138,29 @@ void UCreatureAnimationAsset::LoadPointCacheForClip(const FName &animName, class
 		}
 
 		check(forCore->GetCreatureManager()->GetCreature());
-		int32 arraySize = forCore->GetCreatureManager()->GetCreature()->GetTotalNumPoints() * 3;
-		auto &pts = anim->getCachePts();
-		int32 sourcePtIdx = 0;
-		ensure(cacheForAnim->m_numArrays * arraySize == cacheForAnim->m_points.Num());
-		for (int32 i = 0; i < cacheForAnim->m_numArrays; i++)
+		int32 numPts = forCore->GetCreatureManager()->GetCreature()->GetTotalNumPoints();
+		auto &sharedCache = m_sharedPointCaches.FindOrAdd(animName);
+		if (!sharedCache.IsValid() || (sharedCache->getNumPts() != numPts))
 		{
-			auto new_pts = new glm::float32[arraySize];
-			for (int32 j = 0; j < arraySize; j++)
+			if (!ensure(cacheForAnim->m_numArrays * numPts * 3 == cacheForAnim->m_points.Num()))
+			{
+				return;
+			}
+
+			sharedCache = MakeShareable(new CreatureModule::CreaturePointCache(
+				numPts, (int32)anim->getStartTime(), cacheForAnim->m_numArrays));
+			for (int32 i = 0; i < cacheForAnim->m_numArrays; i++)
+			{
+				sharedCache->addFrame(cacheForAnim->m_points.GetData() + (i * numPts * 3));
+			}
+
+			if (m_pointsCacheQuantize)
 			{
-				new_pts[j] = cacheForAnim->m_points[sourcePtIdx++];
+				sharedCache->quantize();
 			}
-			pts.Add(new_pts);
 		}
+
+		anim->setPointCache(sharedCache);
 	}
 }
 
@@ -148,13 +168,16 @@ void UCreatureAnimationAsset::Serialize(FArchive& Ar)
 {
 	if (Ar.IsSaving() && !Ar.IsCooking())
 	{
-		// when saving non-cooked asset, don't include the datacache as it's huge
+		// when saving non-cooked asset, don't include the datacache or binary data as they're huge
 		TArray<FCreatureAnimationDataCache> cacheCopy = m_dataCache;
+		TArray<uint8> binaryCopy = CreatureCookedBinary;
 		m_dataCache.Reset();
+		CreatureCookedBinary.Reset();
 
 		Super::Serialize(Ar);
 
 		m_dataCache = cacheCopy;
+		CreatureCookedBinary = binaryCopy;
 	}
 	else
 	{
@@ -220,6 +243,18 @@ void UCreatureAnimationAsset::GatherAnimationData()
 	// ensure the filenames are synced
 	creature_filename = UpdateAndGetCreatureFilename();
 	
+	// cook the JSON data into the binary format so runtime loads skip parsing
+	CreatureCookedBinary.Reset();
+	{
+		CreatureModule::CreatureLoadDataPacket json_packet;
+		CreatureModule::LoadCreatureJSONDataFromString(GetJsonString(), json_packet);
+		if (!CreatureModule::SaveCreatureBinaryData(json_packet, CreatureCookedBinary))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UCreatureAnimationAsset::Could not cook binary data for %s"), *creature_filename.ToString());
+			CreatureCookedBinary.Reset();
+		}
+	}
+
 	// load the JSON data into creature so we can extract the animation names and generate the point caches for the anims
 	CreatureCore creature_core;
 	creature_core.pJsonData = &GetJsonString();
@@ -231,6 +266,7 @@ void UCreatureAnimationAsset::GatherAnimationData()
 	int32 arraySize = creature_core.GetCreatureManager()->GetCreature()->GetTotalNumPoints() * 3;
 
 	m_dataCache.Reset(all_animation_names.Num());
+	m_sharedPointCaches.Empty();
 
 	for (auto& cur_name : all_animation_names)
 	{
@@ -247,20 +283,13 @@ void UCreatureAnimationAsset::GatherAnimationData()
 				creature_core.GetCreatureManager()->MakePointCache(cur_name, m_pointsCacheApproximationLevel);
 				if (anim->hasCachePts())
 				{
-					auto &pts = anim->getCachePts();
-
-					float startTime = anim->getStartTime();
-					float endTime = anim->getEndTime();
-
-					animDataCache.m_numArrays = pts.Num();
-					animDataCache.m_points.Reserve(animDataCache.m_numArrays * arraySize);
+					auto &pointCache = anim->getPointCache();
+					animDataCache.m_numArrays = pointCache->getNumFrames();
+					animDataCache.m_points.SetNumUninitialized(animDataCache.m_numArrays * arraySize);
 
-					for (float *pt : pts)
+					for (int32 i = 0; i < animDataCache.m_numArrays; i++)
 					{
-						for (int32 i = 0; i < arraySize; i++)
-						{
-							animDataCache.m_points.Add(pt[i]);
-						}
+						pointCache->getFramePts(i, animDataCache.m_points.GetData() + (i * arraySize));
 					}
 				}
 			}
@@ -23,6 +23,7 @@ void UCreatureAnimationClipsStore::LoadAnimationDataToComponent(class UCreatureM
 			CollectionData.creature_filename = FName(*ShortClip.SourceAsset->GetName());
 			//ֱӸJsonStringãҪٴ
 			CollectionData.creature_core.pJsonData = &(ShortClip.SourceAsset->GetJsonString());
+			CollectionData.creature_core.pCookedData = ShortClip.SourceAsset->GetCookedBinary();
 			
 			CollectionData.animation_speed = ShortClip.SourceAsset->animation_speed;
 			CollectionData.collection_material = ShortClip.SourceAsset->collection_material;
@@ -31,6 +32,7 @@ void UCreatureAnimationClipsStore::LoadAnimationDataToComponent(class UCreatureM
 			int32 Index = MeshComponent->collectionData.AddUnique(CollectionData);
 			FCreatureMeshCollection &addedCollectionData = MeshComponent->collectionData[Index];
 			addedCollectionData.creature_core.pJsonData = CollectionData.creature_core.pJsonData;
+			addedCollectionData.creature_core.pCookedData = CollectionData.creature_core.pCookedData;
 			addedCollectionData.source_asset = ShortClip.SourceAsset;
 
 			FCreatureMeshCollectionToken Token = FCreatureMeshCollectionToken();
@@ -14,6 +14,17 @@ DECLARE_CYCLE_STAT(TEXT("CreatureCore_SetActiveAnimation"), STAT_CreatureCore_Se
 
 static TMap<FName, TSharedPtr<CreatureModule::CreatureAnimation> > global_animations;
 static TMap<FName, TSharedPtr<CreatureModule::CreatureLoadDataPacket> > global_load_data_packets;
+// Rest mesh, skeleton and weights shared by every creature loaded from the same file
+static TMap<FName, TSharedPtr<CreatureModule::CreatureTemplate> > global_creature_templates;
+// Clips of the files loaded on demand
+static TMap<FName, TSharedPtr<CreatureModule::CreatureAnimationLibrary> > global_animation_libraries;
+static int64 global_on_demand_animation_budget = 0;
+// Data packets loading in the background, see CreatureCore::RequestAsyncLoad()
+static CreatureModule::CreatureAsyncLoader global_async_loader;
+// Memory budget of the loaded files, see CreatureCore::SetDataPacketBudget()
+static int64 global_data_packet_budget = 0;
+static TMap<FName, uint64> global_data_packet_last_used;
+static uint64 global_data_packet_use_counter = 0;
 
 // Misc Functions
 static FName GetAnimationToken(const FName& filename_in, const FName& name_in)
@@ -21,6 +32,71 @@ static FName GetAnimationToken(const FName& filename_in, const FName& name_in)
 	return FName(*FString::Printf(TEXT("%s_%s"), *filename_in.ToString(), *name_in.ToString()));
 }
 
+static TSharedPtr<CreatureModule::CreatureAnimationLibrary> GetAnimationLibrary(const FName& filename_in)
+{
+	if (global_animation_libraries.Contains(filename_in))
+	{
+		return global_animation_libraries[filename_in];
+	}
+
+	if (!global_load_data_packets.Contains(filename_in) || !global_creature_templates.Contains(filename_in))
+	{
+		return TSharedPtr<CreatureModule::CreatureAnimationLibrary>();
+	}
+
+	TSharedPtr<CreatureModule::CreatureAnimationLibrary> new_library =
+		TSharedPtr<CreatureModule::CreatureAnimationLibrary>(new CreatureModule::CreatureAnimationLibrary(
+			global_load_data_packets[filename_in],
+			global_creature_templates[filename_in]->GetAnimationNames()));
+	new_library->SetMemoryBudget(global_on_demand_animation_budget);
+	global_animation_libraries.Add(filename_in, new_library);
+
+	return new_library;
+}
+
+// Frees the json DOM of a file once its creature and every animation have been built. Files with
+// clips loaded on demand keep it to decode evicted clips again
+static void ReleaseBuiltJsonData(const FName& filename_in)
+{
+	auto load_data = global_load_data_packets.FindRef(filename_in);
+	auto creature_template = global_creature_templates.FindRef(filename_in);
+	if (!load_data.IsValid()
+		|| !load_data->HasJsonData()
+		|| !creature_template.IsValid()
+		|| global_animation_libraries.Contains(filename_in))
+	{
+		return;
+	}
+
+	for (auto& cur_name : creature_template->GetAnimationNames())
+	{
+		if (!global_animations.Contains(GetAnimationToken(filename_in, cur_name)))
+		{
+			return;
+		}
+	}
+
+	load_data->ReleaseJsonData();
+}
+
+// Adds a finished background load to the global tables, unless the file was loaded in the meantime
+static void AddAsyncLoadResult(const CreatureModule::CreatureAsyncLoadResult& result_in)
+{
+	if (!result_in.success || global_load_data_packets.Contains(result_in.filename))
+	{
+		return;
+	}
+
+	global_load_data_packets.Add(result_in.filename, result_in.load_data);
+	global_creature_templates.Add(result_in.filename, result_in.creature_template);
+	for (auto& cur_animation : result_in.animations)
+	{
+		global_animations.Add(GetAnimationToken(result_in.filename, cur_animation->getName()), cur_animation);
+	}
+
+	ReleaseBuiltJsonData(result_in.filename);
+}
+
 std::string ConvertToString(const FString &str)
 {
 	std::string t = TCHAR_TO_UTF8(*str);
@@ -66,7 +142,10 @@ int CreatureMeshDataModifier::numPoints() const
 CreatureCore::CreatureCore()
 {
 	pJsonData = nullptr;
+	pCookedData = nullptr;
 	smooth_transitions = false;
+	bone_space_blending = false;
+	load_animations_on_demand = false;
 	bone_data_size = 0.01f;
 	bone_data_length_factor = 0.02f;
 	should_play = true;
@@ -82,11 +161,15 @@ CreatureCore::CreatureCore()
 	should_process_animation_start = false;
 	should_process_animation_end = false;
 	should_update_render_indices = false;
+	should_update_render_uvs = true;
+	should_update_render_colors = true;
+	had_render_uv_changes = false;
 	meta_data = nullptr;
 	global_indices_copy = nullptr;
 	skin_swap_active = false;
 	region_order_indices_num = 0;
 	run_morph_targets = false;
+	crowd_tick_queued = false;
 	update_lock = TSharedPtr<FCriticalSection, ESPMode::ThreadSafe>(new FCriticalSection());
 }
 
@@ -210,6 +293,16 @@ void CreatureCore::UpdateCreatureRender()
 		cur_creature->GetRenderComposition()->getRegions();
 	float region_z = 0.0f, delta_z = region_overlap_z_delta;
 
+	// uvs only move while uv warps or item swaps run, and on the frame they stop
+	bool has_uv_changes = (cur_creature->GetActiveItemSwaps().Num() > 0);
+	for (int32 i = 0; (i < cur_regions.Num()) && !has_uv_changes; i++)
+	{
+		has_uv_changes = cur_regions[i]->getUseUvWarp();
+	}
+
+	should_update_render_uvs |= (has_uv_changes || had_render_uv_changes);
+	had_render_uv_changes = has_uv_changes;
+
 	if (region_custom_order.Num() != cur_regions.Num())
 	{
 		// Normal update in default order
@@ -300,17 +393,14 @@ void CreatureCore::UpdateCreatureRender()
 	ProcessRenderRegions();
 }
 
-bool CreatureCore::InitCreatureRender()
+bool CreatureCore::ResolveLoadFilename(FName& load_filename_out)
 {
 	FName cur_creature_filename = creature_filename;
-	bool init_success = false;
-	FName load_filename;
-	is_animation_loaded = false;
 
 	//////////////////////////////////////////////////////////////////////////
 	//Changed by God of Pen
 	//////////////////////////////////////////////////////////////////////////
-	if (pJsonData != nullptr)
+	if ((pJsonData != nullptr) || (pCookedData != nullptr))
 	{
 		if (cur_creature_filename.IsNone())
 		{
@@ -318,36 +408,120 @@ bool CreatureCore::InitCreatureRender()
 		}
 
 		absolute_creature_filename = cur_creature_filename;
-		load_filename = cur_creature_filename;
+		load_filename_out = cur_creature_filename;
+		return true;
+	}
+
+	FString curCreatureFilenameString = cur_creature_filename.ToString();
+	bool does_exist = FPlatformFileManager::Get().GetPlatformFile().FileExists(*curCreatureFilenameString);
+	if (!does_exist)
+	{
+		// see if it is in the content directory
+		cur_creature_filename = FName(*(FPaths::ProjectContentDir() + FString(TEXT("/")) + curCreatureFilenameString));
+		does_exist = FPlatformFileManager::Get().GetPlatformFile().FileExists(*curCreatureFilenameString);
+	}
+
+	if (does_exist)
+	{
+		absolute_creature_filename = cur_creature_filename;
+		load_filename_out = cur_creature_filename;
+		return true;
+	}
+
+	if (do_file_warning && (!load_filename_out.IsNone())) {
+		UE_LOG(LogTemp, Warning, TEXT("ACreatureActor::BeginPlay() - ERROR! Could not load creature file: %s"), *creature_filename.ToString());
+		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("ACreatureActor::BeginPlay() - ERROR! Could not load creature file: %s"), *creature_filename.ToString()));
+	}
 
-		// try to load creature
-		init_success = CreatureCore::LoadDataPacket(load_filename, pJsonData);
+	return false;
+}
+
+bool CreatureCore::RequestAsyncLoad(std::function<void (bool)> ready_callback)
+{
+	FName load_filename;
+	if (!ResolveLoadFilename(load_filename) || IsDataPacketLoaded(load_filename))
+	{
+		return false;
 	}
-	else{
-		FString curCreatureFilenameString = cur_creature_filename.ToString();
-		bool does_exist = FPlatformFileManager::Get().GetPlatformFile().FileExists(*curCreatureFilenameString);
-		if (!does_exist)
+
+	FString * cur_json_data = pJsonData;
+	const TArray<uint8> * cur_cooked_data = pCookedData;
+	auto load_func = [load_filename, cur_json_data, cur_cooked_data](CreatureModule::CreatureLoadDataPacket& load_data)
+	{
+		// same order as InitCreatureRender(), the asset data outlives the load
+		if ((cur_cooked_data != nullptr) && (cur_cooked_data->Num() > 0)
+			&& CreatureModule::LoadCreatureBinaryDataFromBuffer(cur_cooked_data->GetData(), cur_cooked_data->Num(), load_data))
 		{
-			// see if it is in the content directory
-			cur_creature_filename = FName(*(FPaths::ProjectContentDir() + FString(TEXT("/")) + curCreatureFilenameString));
-			does_exist = FPlatformFileManager::Get().GetPlatformFile().FileExists(*curCreatureFilenameString);
+			return true;
 		}
 
-		if (does_exist)
+		if ((cur_json_data != nullptr) && (cur_json_data->Len() > 0))
 		{
-			absolute_creature_filename = cur_creature_filename;
-			load_filename = cur_creature_filename;
+			CreatureModule::LoadCreatureJSONDataFromString(*cur_json_data, load_data);
+			return load_data.base_node.getTag() == JSON_TAG_OBJECT;
+		}
 
-			// try to load creature
-			CreatureCore::LoadDataPacket(load_filename);
-			init_success = true;
+		if ((cur_json_data != nullptr) || (cur_cooked_data != nullptr))
+		{
+			return false;
 		}
-		else {
 
-			if (do_file_warning && (!load_filename.IsNone())) {
-				UE_LOG(LogTemp, Warning, TEXT("ACreatureActor::BeginPlay() - ERROR! Could not load creature file: %s"), *creature_filename.ToString());
-				GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("ACreatureActor::BeginPlay() - ERROR! Could not load creature file: %s"), *creature_filename.ToString()));
+		if (CreatureModule::IsCreatureBinaryFile(load_filename)
+			&& CreatureModule::LoadCreatureBinaryData(load_filename, load_data))
+		{
+			return true;
+		}
+
+		CreatureModule::LoadCreatureJSONData(load_filename, load_data);
+		return load_data.base_node.getTag() == JSON_TAG_OBJECT;
+	};
+
+	global_async_loader.Request(load_filename, load_func, !load_animations_on_demand,
+		[ready_callback](const CreatureModule::CreatureAsyncLoadResult& result_in)
+	{
+		AddAsyncLoadResult(result_in);
+		ready_callback(result_in.success);
+	});
+
+	return true;
+}
+
+void CreatureCore::UpdateAsyncLoads()
+{
+	global_async_loader.Update();
+}
+
+bool CreatureCore::IsDataPacketLoaded(const FName& filename_in)
+{
+	return global_load_data_packets.Contains(filename_in);
+}
+
+bool CreatureCore::InitCreatureRender()
+{
+	bool init_success = false;
+	FName load_filename;
+	is_animation_loaded = false;
+
+	if (ResolveLoadFilename(load_filename))
+	{
+		if ((pJsonData != nullptr) || (pCookedData != nullptr))
+		{
+			// try to load creature, cooked binary data skips json parsing
+			if (pCookedData != nullptr)
+			{
+				init_success = CreatureCore::LoadDataPacket(load_filename, pCookedData);
 			}
+
+			if (!init_success)
+			{
+				init_success = CreatureCore::LoadDataPacket(load_filename, pJsonData);
+			}
+		}
+		else
+		{
+			// try to load creature
+			CreatureCore::LoadDataPacket(load_filename);
+			init_success = true;
 		}
 	}
 	
@@ -355,13 +529,27 @@ bool CreatureCore::InitCreatureRender()
 	{
 		LoadCreature(load_filename);
 
-		// try to load all animations
 		auto all_animation_names = creature_manager->GetCreature()->GetAnimationNames();
 		auto first_animation_name = all_animation_names[0];
-		for (auto& cur_name : all_animation_names)
+		auto cur_load_data = global_load_data_packets[load_filename];
+		// a file already fully built by someone else may have freed its json
+		if (load_animations_on_demand && (cur_load_data->IsBinary() || cur_load_data->HasJsonData()))
 		{
-			CreatureCore::LoadAnimation(load_filename, cur_name);
-			AddLoadedAnimation(load_filename, cur_name);
+			// clips are decoded when first played, starting with the active one below
+			creature_manager->SetAnimationLibrary(GetAnimationLibrary(load_filename));
+			creature_manager->SetIsPlaying(true);
+			creature_manager->SetShouldLoop(is_looping);
+		}
+		else
+		{
+			// try to load all animations
+			for (auto& cur_name : all_animation_names)
+			{
+				CreatureCore::LoadAnimation(load_filename, cur_name);
+				AddLoadedAnimation(load_filename, cur_name);
+			}
+
+			ReleaseBuiltJsonData(load_filename);
 		}
 
 		auto cur_str = start_animation_name;
@@ -477,16 +665,10 @@ void CreatureCore::ParseEvents(float deltaTime)
 	float cur_runtime = (creature_manager->getActualRunTime());
 	animation_frame = cur_runtime;
 
-	auto load_filename = absolute_creature_filename;
-
 	auto cur_animation_name = creature_manager->GetActiveAnimationName();
 
-	auto cur_token = GetAnimationToken(load_filename, cur_animation_name);
-	CreatureModule::CreatureAnimation * cur_animation = NULL;
-	if (global_animations.Contains(cur_token))
-	{
-		cur_animation = global_animations[cur_token].Get();
-	}
+	// also finds clips loaded on demand
+	CreatureModule::CreatureAnimation * cur_animation = creature_manager->GetAnimation(cur_animation_name);
 
 
 	if (cur_animation)
@@ -530,11 +712,28 @@ void CreatureCore::ProcessRenderRegions()
 	if (region_colors.Num() != cur_creature->GetTotalNumPoints())
 	{
 		region_colors.Init(FColor(255, 255, 255, 255), cur_creature->GetTotalNumPoints());
+		should_update_render_colors = true;
 	}
 
+	// only flag the colours for upload when they actually changed
+	auto set_region_color = [this](int32 idx, const FColor& color_in)
+	{
+		if (region_colors[idx] != color_in)
+		{
+			region_colors[idx] = color_in;
+			should_update_render_colors = true;
+		}
+	};
+
 	// fill up animation alphas
 	for (auto& cur_region_pair : regions_map)
 	{
+		if (region_colors_map.Contains(cur_region_pair.Key))
+		{
+			// written by the user overwrite below
+			continue;
+		}
+
 		auto cur_region = cur_region_pair.Value;
 		auto start_pt_index = cur_region->getStartPtIndex();
 		auto end_pt_index = cur_region->getEndPtIndex();
@@ -546,7 +745,7 @@ void CreatureCore::ProcessRenderRegions()
 
 		for (auto i = start_pt_index; i <= end_pt_index; i++)
 		{
-			region_colors[i] = FColor(cur_r, cur_g, cur_b, cur_alpha);
+			set_region_color(i, FColor(cur_r, cur_g, cur_b, cur_alpha));
 		}
 	}
 
@@ -567,7 +766,7 @@ void CreatureCore::ProcessRenderRegions()
 
 				for (auto i = start_pt_index; i <= end_pt_index; i++)
 				{
-					region_colors[i] = FColor(cur_alpha, cur_alpha, cur_alpha, cur_alpha);;
+					set_region_color(i, FColor(cur_alpha, cur_alpha, cur_alpha, cur_alpha));
 				}
 			}
 		}
@@ -588,8 +787,13 @@ CreatureCore::LoadDataPacket(const FName& filename_in)
 	TSharedPtr<CreatureModule::CreatureLoadDataPacket> new_packet =
 		TSharedPtr<CreatureModule::CreatureLoadDataPacket>(new CreatureModule::CreatureLoadDataPacket());
 
-	// load regular JSON
-	CreatureModule::LoadCreatureJSONData(filename_in, *new_packet);
+	// cooked binary files are memory mapped, everything else is regular JSON
+	if (!CreatureModule::IsCreatureBinaryFile(filename_in)
+		|| !CreatureModule::LoadCreatureBinaryData(filename_in, *new_packet))
+	{
+		CreatureModule::LoadCreatureJSONData(filename_in, *new_packet);
+	}
+
 	global_load_data_packets[filename_in] = new_packet;
 
 	return true;
@@ -625,15 +829,55 @@ bool CreatureCore::LoadDataPacket(const FName& filename_in, FString* pSourceData
 	return true;
 }
 
+bool CreatureCore::LoadDataPacket(const FName& filename_in, const TArray<uint8>* pCookedData)
+{
+	if ((pCookedData == nullptr) || (pCookedData->Num() == 0))
+	{
+		return false;
+	}
+
+	if (global_load_data_packets.Contains(filename_in))
+	{
+		// file already loaded, just return
+		return true;
+	}
+
+	TSharedPtr<CreatureModule::CreatureLoadDataPacket> new_packet =
+		TSharedPtr<CreatureModule::CreatureLoadDataPacket>(new CreatureModule::CreatureLoadDataPacket);
+
+	if (!CreatureModule::LoadCreatureBinaryDataFromBuffer(pCookedData->GetData(), pCookedData->Num(), *new_packet))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CreatureCore::LoadDataPacket() - Invalid cooked data for %s, falling back to json"), *filename_in.ToString());
+		return false;
+	}
+
+	global_load_data_packets.Add(filename_in, new_packet);
+
+	return true;
+}
+
 void 
 CreatureCore::ClearAllDataPackets()
 {
+	// finish background loads first, or they would add their packets back later
+	global_async_loader.Flush();
+
+	// background decodes read from the packets
+	for (auto& cur_library : global_animation_libraries)
+	{
+		cur_library.Value->FlushPrefetches();
+	}
+
+	global_animation_libraries.Empty();
+
 	for (auto& cur_packet : global_load_data_packets)
 	{
 		cur_packet.Value->allocator.deallocate();
 	}
 
 	global_load_data_packets.Empty();
+	global_creature_templates.Empty();
+	global_data_packet_last_used.Empty();
 }
 
 void CreatureCore::FreeDataPacket(const FName & filename_in)
@@ -655,7 +899,15 @@ void CreatureCore::FreeDataPacket(const FName & filename_in)
 			global_animations.Remove(cur_key);
 		}
 
+		if (global_animation_libraries.Contains(filename_in))
+		{
+			global_animation_libraries[filename_in]->FlushPrefetches();
+			global_animation_libraries.Remove(filename_in);
+		}
+
 		global_load_data_packets.Remove(filename_in);
+		global_creature_templates.Remove(filename_in);
+		global_data_packet_last_used.Remove(filename_in);
 	}
 }
 
@@ -684,16 +936,185 @@ CreatureCore::LoadAnimation(const FName& filename_in, const FName& name_in)
 	global_animations.Add(cur_token, new_animation);
 }
 
+void
+CreatureCore::PrefetchAnimation(const FName& filename_in, const FName& name_in)
+{
+	auto cur_library = GetAnimationLibrary(filename_in);
+	if (!cur_library.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CreatureCore::PrefetchAnimation() - Prefetching animation but %s was not loaded!"), *filename_in.ToString());
+		return;
+	}
+
+	cur_library->Prefetch(name_in);
+}
+
+void
+CreatureCore::SetOnDemandAnimationBudget(int64 bytes_in)
+{
+	global_on_demand_animation_budget = bytes_in;
+	for (auto& cur_library : global_animation_libraries)
+	{
+		cur_library.Value->SetMemoryBudget(bytes_in);
+	}
+}
+
+void
+CreatureCore::SetDataPacketBudget(int64 bytes_in)
+{
+	global_data_packet_budget = bytes_in;
+	TrimDataPackets();
+}
+
+void
+CreatureCore::TrimDataPackets()
+{
+	while ((global_data_packet_budget > 0) && (GetDataPacketResidentBytes() > global_data_packet_budget))
+	{
+		FName evict_filename;
+		uint64 evict_last_used = 0;
+		bool found_evict = false;
+		for (auto& cur_packet : global_load_data_packets)
+		{
+			if (IsDataPacketInUse(cur_packet.Key))
+			{
+				continue;
+			}
+
+			uint64 cur_last_used = global_data_packet_last_used.FindRef(cur_packet.Key);
+			if (!found_evict || (cur_last_used < evict_last_used))
+			{
+				evict_filename = cur_packet.Key;
+				evict_last_used = cur_last_used;
+				found_evict = true;
+			}
+		}
+
+		if (!found_evict)
+		{
+			break;
+		}
+
+		FreeDataPacket(evict_filename);
+	}
+}
+
+bool
+CreatureCore::IsDataPacketInUse(const FName& filename_in)
+{
+	// every user holds on to the shared template, animations or clip library
+	auto creature_template = global_creature_templates.FindRef(filename_in);
+	if (!creature_template.IsValid())
+	{
+		// still being set up
+		return global_load_data_packets.Contains(filename_in);
+	}
+
+	if (creature_template.GetSharedReferenceCount() > 2)
+	{
+		return true;
+	}
+
+	auto cur_library = global_animation_libraries.FindRef(filename_in);
+	if (cur_library.IsValid() && (cur_library.GetSharedReferenceCount() > 2))
+	{
+		return true;
+	}
+
+	for (auto& cur_name : creature_template->GetAnimationNames())
+	{
+		auto cur_animation = global_animations.FindRef(GetAnimationToken(filename_in, cur_name));
+		if (cur_animation.IsValid() && (cur_animation.GetSharedReferenceCount() > 2))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void
+CreatureCore::GetDataPacketStats(TArray<FCreatureDataPacketStats>& out_stats)
+{
+	out_stats.Reset();
+	for (auto& cur_packet : global_load_data_packets)
+	{
+		FCreatureDataPacketStats new_stats;
+		new_stats.filename = cur_packet.Key;
+		new_stats.json_bytes = cur_packet.Value->GetJsonBytes();
+		if (cur_packet.Value->IsBinary())
+		{
+			new_stats.binary_bytes = cur_packet.Value->binary_storage->GetSize();
+			new_stats.is_mapped = cur_packet.Value->binary_storage->IsMapped();
+		}
+
+		auto creature_template = global_creature_templates.FindRef(cur_packet.Key);
+		if (creature_template.IsValid())
+		{
+			// less the global table and this local reference
+			new_stats.ref_count = creature_template.GetSharedReferenceCount() - 2;
+			new_stats.template_bytes = creature_template->GetAllocatedSize();
+			for (auto& cur_name : creature_template->GetAnimationNames())
+			{
+				auto cur_animation = global_animations.FindRef(GetAnimationToken(cur_packet.Key, cur_name));
+				if (cur_animation.IsValid())
+				{
+					new_stats.animation_bytes += cur_animation->getAllocatedSize();
+				}
+			}
+		}
+
+		auto cur_library = global_animation_libraries.FindRef(cur_packet.Key);
+		if (cur_library.IsValid())
+		{
+			new_stats.animation_bytes += cur_library->GetResidentBytes();
+		}
+
+		out_stats.Add(new_stats);
+	}
+}
+
+int64
+CreatureCore::GetDataPacketResidentBytes()
+{
+	TArray<FCreatureDataPacketStats> all_stats;
+	GetDataPacketStats(all_stats);
+
+	int64 ret_bytes = 0;
+	for (auto& cur_stats : all_stats)
+	{
+		ret_bytes += cur_stats.GetTotalBytes();
+	}
+
+	return ret_bytes;
+}
+
 TArray<FProceduralMeshTriangle>&
 CreatureCore::LoadCreature(const FName& filename_in)
 {
-	auto load_data = global_load_data_packets[filename_in];
+	TSharedPtr<CreatureModule::CreatureTemplate> creature_template;
+	if (global_creature_templates.Contains(filename_in))
+	{
+		creature_template = global_creature_templates[filename_in];
+	}
+	else
+	{
+		auto load_data = global_load_data_packets[filename_in];
+		creature_template = TSharedPtr<CreatureModule::CreatureTemplate>(
+			new CreatureModule::CreatureTemplate(*load_data));
+		global_creature_templates.Add(filename_in, creature_template);
+	}
 
 	TSharedPtr<CreatureModule::Creature> new_creature =
-		TSharedPtr<CreatureModule::Creature>(new CreatureModule::Creature(*load_data));
+		TSharedPtr<CreatureModule::Creature>(new CreatureModule::Creature(creature_template));
 
 	creature_manager = TSharedPtr<CreatureModule::CreatureManager>(
 		new CreatureModule::CreatureManager(new_creature));
+	creature_manager->SetBoneBlending(bone_space_blending);
+
+	// this file is now in use, others may have to make room
+	global_data_packet_last_used.Add(filename_in, ++global_data_packet_use_counter);
+	TrimDataPackets();
 
 	draw_triangles.SetNum(creature_manager->GetCreature()->GetTotalNumIndices() / 3, true);
 
@@ -733,6 +1154,39 @@ CreatureCore::SetBluePrintBlendActiveAnimation(FName name_in, float factor)
 	SetAutoBlendActiveAnimation(name_in, factor);
 }
 
+bool
+CreatureCore::SetBluePrintBlendSpace(const TArray<FName>& names_in, bool sync_phase)
+{
+	auto cur_creature_manager = GetCreatureManager();
+	if (!cur_creature_manager)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CreatureCore::SetBluePrintBlendSpace() - ERROR! no CreatureManager"));
+		return false;
+	}
+
+	return cur_creature_manager->SetBlendSpace(names_in, sync_phase);
+}
+
+void
+CreatureCore::SetBluePrintBlendSpaceWeights(const TArray<float>& weights_in)
+{
+	auto cur_creature_manager = GetCreatureManager();
+	if (cur_creature_manager)
+	{
+		cur_creature_manager->SetBlendSpaceWeights(weights_in);
+	}
+}
+
+void
+CreatureCore::ClearBluePrintBlendSpace()
+{
+	auto cur_creature_manager = GetCreatureManager();
+	if (cur_creature_manager)
+	{
+		cur_creature_manager->ClearBlendSpace();
+	}
+}
+
 void 
 CreatureCore::SetBluePrintAnimationCustomTimeRange(FName name_in, int32 start_time, int32 end_time)
 {
@@ -787,6 +1241,43 @@ CreatureCore::MakeBluePrintPointCache(FName name_in, int32 approximation_level)
 	cur_creature_manager->MakePointCache(name_in, real_approximation_level);
 }
 
+void
+CreatureCore::MakeBluePrintPointCacheInBackground(FName name_in, int32 approximation_level)
+{
+	auto cur_creature_manager = GetCreatureManager();
+	if (!cur_creature_manager)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CreatureCore::MakeBluePrintPointCacheInBackground - ERROR! Could not generate point cache for %s"), *name_in.ToString());
+		return;
+	}
+
+	cur_creature_manager->MakePointCacheAsync(name_in, FMath::Clamp(approximation_level, 1, 10));
+}
+
+void
+CreatureCore::MakeBluePrintPointCacheLazy(FName name_in)
+{
+	auto cur_creature_manager = GetCreatureManager();
+	if (!cur_creature_manager)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CreatureCore::MakeBluePrintPointCacheLazy - ERROR! Could not generate point cache for %s"), *name_in.ToString());
+		return;
+	}
+
+	cur_creature_manager->MakePointCacheLazy(name_in);
+}
+
+void
+CreatureCore::CollectPointCaches()
+{
+	FScopeLock scope_lock(update_lock.Get());
+	auto cur_creature_manager = GetCreatureManager();
+	if (cur_creature_manager)
+	{
+		cur_creature_manager->CollectPointCaches();
+	}
+}
+
 void 
 CreatureCore::ClearBluePrintPointCache(FName name_in, int32 approximation_level)
 {
@@ -936,6 +1427,54 @@ CreatureCore::RunTick(float delta_time)
 	return true;
 }
 
+bool
+CreatureCore::QueueCrowdTick(float delta_time, CreatureModule::CreatureCrowd& crowd_in)
+{
+	if (!is_animation_loaded)
+	{
+		return false;
+	}
+
+	FScopeLock scope_lock(update_lock.Get());
+
+	bool morph_targets_valid = false;
+	if (run_morph_targets && meta_data) {
+		morph_targets_valid = meta_data->morph_data.isValid();
+	}
+
+	if (is_driven || morph_targets_valid || !creature_manager.Get())
+	{
+		return RunTick(delta_time);
+	}
+
+	if (is_disabled)
+	{
+		return false;
+	}
+
+	ParseEvents(delta_time);
+
+	if (should_play) {
+		crowd_in.AddManager(creature_manager.Get(), delta_time);
+	}
+
+	crowd_tick_queued = true;
+	return true;
+}
+
+void
+CreatureCore::FinishCrowdTick()
+{
+	FScopeLock scope_lock(update_lock.Get());
+
+	if (crowd_tick_queued)
+	{
+		UpdateCreatureRender();
+		FillBoneData();
+		crowd_tick_queued = false;
+	}
+}
+
 void 
 CreatureCore::SetBluePrintAnimationLoop(bool flag_in)
 {
@@ -1068,9 +1607,11 @@ CreatureCore::SetActiveAnimation(const FName& name_in)
 void 
 CreatureCore::SetAutoBlendActiveAnimation(const FName& name_in, float factor)
 {
-	auto all_animations = creature_manager->GetAllAnimations();
+	auto& all_animations = creature_manager->GetAllAnimations();
+	auto cur_library = creature_manager->GetAnimationLibrary();
 
-	if (all_animations.Contains(name_in) == false)
+	if ((all_animations.Contains(name_in) == false)
+		&& ((cur_library == nullptr) || (cur_library->HasAnimation(name_in) == false)))
 	{
 		return;
 	}
@@ -8,6 +8,7 @@
 #include "CreatureAnimationClipsStore.h"
 #include "CreatureAnimStateMachineInstance.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "DrawDebugHelpers.h"
 #include <math.h>
 
@@ -30,6 +31,15 @@ DECLARE_CYCLE_STAT(TEXT("CreatureMesh_UpdateCoreValues"), STAT_CreatureMesh_Upda
 DECLARE_CYCLE_STAT(TEXT("CreatureMesh_MeshUpdate"), STAT_CreatureMesh_MeshUpdate, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureMesh_ProcessCreatureCoreResults"), STAT_CreatureMesh_ProcessCreatureCoreResults, STATGROUP_Creature);
 
+// Components using crowd updates, queued per world until the first of them processes its results
+struct FCreatureCrowdQueue
+{
+	CreatureModule::CreatureCrowd crowd;
+	TArray<UCreatureMeshComponent *> components;
+};
+
+static TMap<UWorld *, FCreatureCrowdQueue> creature_crowd_queues;
+
 // UCreatureMeshComponent
 UCreatureMeshComponent::UCreatureMeshComponent(const FObjectInitializer& ObjectInitializer)
 	: UCustomProceduralMeshComponent(ObjectInitializer)
@@ -74,6 +84,31 @@ void UCreatureMeshComponent::SetBluePrintBlendActiveAnimation_Name(FName name_in
 	ResetFrameCallbacks();
 }
 
+bool UCreatureMeshComponent::SetBluePrintBlendSpace(const TArray<FName>& names_in, bool sync_phase)
+{
+	bool ret_success = creature_core.SetBluePrintBlendSpace(names_in, sync_phase);
+	ResetFrameCallbacks();
+	return ret_success;
+}
+
+void UCreatureMeshComponent::SetBluePrintBlendSpaceWeights(const TArray<float>& weights_in)
+{
+	creature_core.SetBluePrintBlendSpaceWeights(weights_in);
+}
+
+void UCreatureMeshComponent::ClearBluePrintBlendSpace()
+{
+	creature_core.ClearBluePrintBlendSpace();
+}
+
+void UCreatureMeshComponent::PrefetchBluePrintAnimation(FName name_in)
+{
+	if (load_animations_on_demand)
+	{
+		CreatureCore::PrefetchAnimation(creature_core.absolute_creature_filename, name_in);
+	}
+}
+
 FName UCreatureMeshComponent::GetBluePrintActiveAnimationName()
 {
 	return creature_core.creature_manager->GetActiveAnimationName();
@@ -123,6 +158,16 @@ void UCreatureMeshComponent::MakeBluePrintPointCache_Name(FName name_in, int32 a
 	creature_core.MakeBluePrintPointCache(name_in, approximation_level);
 }
 
+void UCreatureMeshComponent::MakeBluePrintPointCacheInBackground_Name(FName name_in, int32 approximation_level)
+{
+	creature_core.MakeBluePrintPointCacheInBackground(name_in, approximation_level);
+}
+
+void UCreatureMeshComponent::MakeBluePrintPointCacheLazy_Name(FName name_in)
+{
+	creature_core.MakeBluePrintPointCacheLazy(name_in);
+}
+
 void UCreatureMeshComponent::ClearBluePrintPointCache(FString name_in, int32 approximation_level)
 {
 	creature_core.ClearBluePrintPointCache(FName(*name_in), approximation_level);
@@ -341,6 +386,11 @@ void UCreatureMeshComponent::EnableRegionColors()
 void UCreatureMeshComponent::SetMorphTargetsActive(bool flag_in)
 {
 	creature_core.run_morph_targets = flag_in;
+	if (!flag_in && creature_core.GetCreatureManager())
+	{
+		// back to the active animation
+		creature_core.GetCreatureManager()->ClearBlendSpace();
+	}
 }
 
 void UCreatureMeshComponent::SetMorphTargetsWorldPt(FVector pt_in, FVector base_pt, float radius, bool z_up)
@@ -511,6 +561,12 @@ void UCreatureMeshComponent::InitStandardValues()
 
 	animation_speed = 2.0f;
 	smooth_transitions = false;
+	bone_space_blending = false;
+	flat_tangents = false;
+	load_animations_on_demand = false;
+	load_in_background = false;
+	is_loading_async = false;
+	async_load_id = 0;
 	bone_data_size = 0.01f;
 	bone_data_length_factor = 0.02f;
 	creature_bounds_scale = 1.0f;
@@ -529,6 +585,8 @@ void UCreatureMeshComponent::InitStandardValues()
 	completely_disable = false;
 	fixed_timestep = 0.0f;
 	run_task_multicore = false;
+	use_crowd_update = false;
+	crowdTickResult = false;
 	use_anchor_points = false;
 
 	// Generate a single dummy triangle
@@ -546,10 +604,17 @@ void UCreatureMeshComponent::UpdateCoreValues()
 	FScopeLock scope_lock(creature_core.update_lock.Get());
 
 	creature_core.creature_filename = creature_filename;
+	creature_core.load_animations_on_demand = load_animations_on_demand;
+	creature_core.bone_space_blending = bone_space_blending;
+	if (creature_core.GetCreatureManager())
+	{
+		creature_core.GetCreatureManager()->SetBoneBlending(bone_space_blending);
+	}
 
 	if (creature_animation_asset && creature_core.creature_asset_filename != creature_animation_asset->GetCreatureFilename())
 	{
 		creature_core.pJsonData = &creature_animation_asset->GetJsonString();
+		creature_core.pCookedData = creature_animation_asset->GetCookedBinary();
 		creature_core.creature_asset_filename = creature_animation_asset->GetCreatureFilename();
 
 		creature_animation_asset->LoadPointCacheForAllClips(&creature_core);
@@ -615,7 +680,10 @@ void UCreatureMeshComponent::RunTick(float DeltaTime)
 	}
 
 	// Run the animation
-	if (run_task_multicore) {
+	if (use_crowd_update) {
+		QueueCrowdTick(DeltaTime);
+	}
+	else if (run_task_multicore) {
 		// Make sure this only runs for characters that will not be removed from the scene
 		// otherwise it might not be safe
 		creatureTickResult = Async<bool>(EAsyncExecution::TaskGraph, [this, DeltaTime]()
@@ -650,16 +718,73 @@ bool UCreatureMeshComponent::RunTickProcessing(float DeltaTime, bool markDirty)
 	return can_tick;
 }
 
+void UCreatureMeshComponent::QueueCrowdTick(float DeltaTime)
+{
+	FCreatureCrowdQueue& crowd_queue = creature_crowd_queues.FindOrAdd(GetWorld());
+	if (crowd_queue.components.Contains(this))
+	{
+		// still waiting on the last crowd run
+		return;
+	}
+
+	crowdTickResult = creature_core.QueueCrowdTick(DeltaTime, crowd_queue.crowd);
+	if (crowdTickResult)
+	{
+		crowd_queue.components.Add(this);
+	}
+}
+
+void UCreatureMeshComponent::FinishCrowdTick()
+{
+	creature_core.FinishCrowdTick();
+
+	FScopeLock cur_lock(&local_lock);
+
+	animation_frame = creature_core.GetCreatureManager()->getActualRunTime();
+	DoCreatureMeshUpdate(INDEX_NONE, false);
+	TryCreateBendPhysics();
+}
+
+void UCreatureMeshComponent::RunCrowdTicks(UWorld * world_in)
+{
+	FCreatureCrowdQueue * crowd_queue = creature_crowd_queues.Find(world_in);
+	if (crowd_queue == nullptr)
+	{
+		return;
+	}
+
+	crowd_queue->crowd.Run();
+
+	TArray<UCreatureMeshComponent *> crowd_components = MoveTemp(crowd_queue->components);
+	creature_crowd_queues.Remove(world_in);
+
+	// render buffers of every character
+	ParallelFor(crowd_components.Num(), [&](int32 i) {
+		crowd_components[i]->FinishCrowdTick();
+	});
+}
+
 void UCreatureMeshComponent::ProcessCreatureCoreResult(FCreatureCoreResultTickFunction& ThisTickFunction)
 {
-	if (ShouldSkipTick() || (!run_task_multicore))
+	if (ShouldSkipTick() || (!run_task_multicore && !use_crowd_update))
 	{
 		return;
 	}
 
 	SCOPE_CYCLE_COUNTER(STAT_CreatureMesh_ProcessCreatureCoreResults);
 	
-	bool can_tick = creatureTickResult.IsValid() && creatureTickResult.Get();
+	bool can_tick = false;
+	if (use_crowd_update)
+	{
+		// the first crowd component to get here updates the whole crowd
+		RunCrowdTicks(GetWorld());
+		can_tick = crowdTickResult;
+		crowdTickResult = false;
+	}
+	else
+	{
+		can_tick = creatureTickResult.IsValid() && creatureTickResult.Get();
+	}
 
 	if (can_tick)
 	{
@@ -856,6 +981,27 @@ void UCreatureMeshComponent::DoCreatureMeshUpdate(int render_packet_idx, bool ma
 		bool has_dynamic_indices = (creature_core.shouldSkinSwap() || creature_core.HasMeshModifier());
 		int32 draw_indices_num = has_dynamic_indices ? creature_core.GetRealTotalIndicesNum() : -1;
 		localRenderProxy->SetNeedsIndexUpdate(creature_core.should_update_render_indices, draw_indices_num);
+
+		// positions change every frame, uvs and colours only when the core flags them.
+		// Collection packets are driven by their own cores so they refresh everything.
+		// Tangents are left to the packet, which skips them while it keeps a flat basis
+		const bool refresh_all = creature_core.HasMeshModifier() || (render_packet_idx != INDEX_NONE);
+		uint8 vertex_streams = EProceduralMeshStream::Position;
+		if (creature_core.should_update_render_uvs || refresh_all)
+		{
+			vertex_streams |= EProceduralMeshStream::TexCoord;
+		}
+
+		if (creature_core.should_update_render_colors || refresh_all)
+		{
+			vertex_streams |= EProceduralMeshStream::Color;
+		}
+
+		localRenderProxy->SetNeedsVertexStreamUpdate(vertex_streams);
+		localRenderProxy->SetFlatTangents(flat_tangents,
+			creature_core.GetCreatureManager() && creature_core.GetCreatureManager()->GetMirrorY());
+		creature_core.should_update_render_uvs = false;
+		creature_core.should_update_render_colors = false;
 	}
 
 	// Update Mesh
@@ -946,6 +1092,16 @@ void UCreatureMeshComponent::TickComponent(float DeltaTime, enum ELevelTick Tick
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	if (is_loading_async)
+	{
+		CreatureCore::UpdateAsyncLoads();
+		if (is_loading_async)
+		{
+			RegisterCoreResultsTickFunction(false);
+			return;
+		}
+	}
+
 	bool shouldSkipTick = ShouldSkipTick();
 	
 	RegisterCoreResultsTickFunction(!shouldSkipTick && !enable_collection_playback);
@@ -955,6 +1111,9 @@ void UCreatureMeshComponent::TickComponent(float DeltaTime, enum ELevelTick Tick
 		return;
 	}
 
+	// finished point caches go to the shared animations here on the game thread
+	creature_core.CollectPointCaches();
+
 	//////////////////////////////////////////////////////////////////////////
 	//ChangedByGod of Pen
 	//////////////////////////////////////////////////////////////////////////
@@ -1009,6 +1168,21 @@ void UCreatureMeshComponent::OnRegister()
 	}
 }
 
+void UCreatureMeshComponent::OnUnregister()
+{
+	// drop out of a crowd update still waiting to run
+	FCreatureCrowdQueue * crowd_queue = creature_crowd_queues.Find(GetWorld());
+	if (crowd_queue && crowd_queue->components.Remove(this))
+	{
+		if (creature_core.GetCreatureManager())
+		{
+			crowd_queue->crowd.RemoveManager(creature_core.GetCreatureManager());
+		}
+	}
+
+	Super::OnUnregister();
+}
+
 void UCreatureMeshComponent::RegisterComponentTickFunctions(bool bRegister)
 {
 	Super::RegisterComponentTickFunctions(bRegister);
@@ -1041,6 +1215,46 @@ void UCreatureMeshComponent::StandardInit()
 
 	UpdateCoreValues();
 	creature_core.do_file_warning = !enable_collection_playback;
+
+	const int32 cur_load_id = ++async_load_id;
+	is_loading_async = false;
+	if (load_in_background)
+	{
+		TWeakObjectPtr<UCreatureMeshComponent> weak_this(this);
+		is_loading_async = creature_core.RequestAsyncLoad([weak_this, cur_load_id](bool success_in)
+		{
+			if (weak_this.IsValid() && (weak_this->async_load_id == cur_load_id))
+			{
+				weak_this->FinishAsyncLoad(success_in);
+			}
+		});
+	}
+
+	if (is_loading_async)
+	{
+		// stay empty until the load is in
+		static FProceduralMeshTriData empty_data;
+		SetProceduralMeshTriData(empty_data);
+		return;
+	}
+
+	FinishStandardInit();
+}
+
+void UCreatureMeshComponent::FinishAsyncLoad(bool success_in)
+{
+	is_loading_async = false;
+	FinishStandardInit();
+	CreatureLoadedEvent.Broadcast(success_in);
+}
+
+bool UCreatureMeshComponent::IsBluePrintCreatureLoading() const
+{
+	return is_loading_async;
+}
+
+void UCreatureMeshComponent::FinishStandardInit()
+{
 	bool retval = creature_core.InitCreatureRender();
 	creature_core.InitValues();
 
@@ -1096,6 +1310,11 @@ void UCreatureMeshComponent::CollectionInit()
 			cur_core.pJsonData = cur_data.creature_core.pJsonData;
 		}
 
+		if (cur_data.creature_core.pCookedData != nullptr)
+		{
+			cur_core.pCookedData = cur_data.creature_core.pCookedData;
+		}
+
 		bool retval = cur_core.InitCreatureRender();
 		if (retval)
 		{
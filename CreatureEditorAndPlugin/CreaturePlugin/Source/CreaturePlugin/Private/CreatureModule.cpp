@@ -35,14 +35,20 @@
 #include "CreatureModule.h"
 #include "CreaturePluginPCH.h"
 #include <Runtime/Core/Public/Async/ParallelFor.h>
+#include <Runtime/Core/Public/Async/Async.h>
+#include <Runtime/Core/Public/Async/MappedFileHandle.h>
+#include <Runtime/Core/Public/HAL/PlatformFilemanager.h>
 
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_Update"), STAT_CreatureManager_Update, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_IncreRunTime"), STAT_CreatureManager_IncreRunTime, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_PoseJustBones"), STAT_CreatureManager_PoseJustBones, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_PoseCreature"), STAT_CreatureManager_PoseCreature, STATGROUP_Creature);
+DECLARE_CYCLE_STAT(TEXT("CreatureManager_PoseCreatureBlend"), STAT_CreatureManager_PoseCreatureBlend, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_RunUVItemSwap"), STAT_CreatureManager_RunUVItemSwap, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_AlterBonesByAnchor"), STAT_CreatureManager_AlterBonesByAnchor, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("CreatureManager_JustRunUVWarps"), STAT_CreatureManager_JustRunUVWarps, STATGROUP_Creature);
+DECLARE_CYCLE_STAT(TEXT("CreatureCrowd_Run"), STAT_CreatureCrowd_Run, STATGROUP_Creature);
+DECLARE_CYCLE_STAT(TEXT("CreatureAnimationLibrary_GetAnimation"), STAT_CreatureAnimationLibrary_GetAnimation, STATGROUP_Creature);
 
 template <typename T>
 static T clipNum(const T& n, const T& lower, const T& upper) {
@@ -260,10 +266,41 @@ static TArray<float> ReadFloatArray(JsonNode& json_obj,
     return ret_array;
 }
 
+static meshBone * LinkBones(TMap<int32, std::pair<meshBone *, TArray<int32> > >& bone_data,
+                            const TSet<int32>& child_set)
+{
+    meshBone * root_bone = NULL;
+    
+    // Find root
+    for(auto& cur_data : bone_data)
+    {
+        int32 cur_id = cur_data.Key;
+        if(child_set.Contains(cur_id) == false) {
+            // not a child, so is root
+            root_bone = cur_data.Value.first;
+            break;
+        }
+    }
+    
+    // construct hierarchy
+    for(auto& cur_data : bone_data)
+    {
+        meshBone * cur_bone = cur_data.Value.first;
+        const TArray<int32>& children_ids = cur_data.Value.second;
+        for(auto& cur_child_id : children_ids)
+        {
+            meshBone * child_bone = bone_data[cur_child_id].first;
+            cur_bone->addChild(child_bone);
+        }
+
+    }
+    
+    return root_bone;
+}
+
 static meshBone * CreateBones(JsonNode& json_obj,
                               const FName& key)
 {
-    meshBone * root_bone = NULL;
     JsonNode * base_obj =  GetJSONLevelNodeFromKey(json_obj, key);
     TMap<int32, std::pair<meshBone *, TArray<int32> > > bone_data;
     TSet<int32> child_set;
@@ -298,31 +335,7 @@ static meshBone * CreateBones(JsonNode& json_obj,
         }
     }
     
-    // Find root
-    for(auto& cur_data : bone_data)
-    {
-        int32 cur_id = cur_data.Key;
-        if(child_set.Contains(cur_id) == false) {
-            // not a child, so is root
-            root_bone = cur_data.Value.first;
-            break;
-        }
-    }
-    
-    // construct hierarchy
-    for(auto& cur_data : bone_data)
-    {
-        meshBone * cur_bone = cur_data.Value.first;
-        const TArray<int32>& children_ids = cur_data.Value.second;
-        for(auto& cur_child_id : children_ids)
-        {
-            meshBone * child_bone = bone_data[cur_child_id].first;
-            cur_bone->addChild(child_bone);
-        }
-
-    }
-    
-    return root_bone;
+    return LinkBones(bone_data, child_set);
 }
 
 static TArray<meshRenderRegion *> CreateRegions(JsonNode& json_obj,
@@ -414,6 +427,29 @@ static std::pair<int32, int32> GetStartEndTimes(JsonNode& json_obj,
     return ret_times;
 }
 
+// Exported frame times of a cache, in increasing order
+static TArray<int32> GetKeyFrameTimes(JsonNode& base_obj)
+{
+    TArray<int32> ret_times;
+    for (JsonIterator it = JsonBegin(base_obj.value);
+         it != JsonEnd(base_obj.value);
+         ++it)
+    {
+        ret_times.Add(atoi((*it)->key));
+    }
+    
+    ret_times.Sort();
+    for (int32 i = ret_times.Num() - 1; i > 0; i--)
+    {
+        if (ret_times[i] == ret_times[i - 1])
+        {
+            ret_times.RemoveAt(i);
+        }
+    }
+    
+    return ret_times;
+}
+
 static void FillBoneCache(JsonNode& json_obj,
                           const FName& key,
                           int32 start_time,
@@ -424,7 +460,24 @@ static void FillBoneCache(JsonNode& json_obj,
 
     cache_manager.init(start_time, end_time);
     
-	int32 prev_time = start_time;
+    // only the exported keyframes are stored, frames between them blend on retrieval
+    cache_manager.initKeyframes(GetKeyFrameTimes(*base_obj));
+    
+    // the bones of the first frame are the layout of every frame
+    TArray<FName> bone_keys;
+    if (JsonBegin(base_obj->value) != JsonEnd(base_obj->value))
+    {
+        JsonNode * first_node = *JsonBegin(base_obj->value);
+        for (JsonIterator bone_it = JsonBegin(first_node->value);
+             bone_it != JsonEnd(first_node->value);
+             ++bone_it)
+        {
+            bone_keys.Add(FName((*bone_it)->key));
+        }
+    }
+    
+    cache_manager.initKeys(bone_keys);
+    
     for (JsonIterator it = JsonBegin(base_obj->value);
          it != JsonEnd(base_obj->value);
          ++it)
@@ -432,7 +485,8 @@ static void FillBoneCache(JsonNode& json_obj,
         JsonNode * cur_node = *it;
 
         int32 cur_time = atoi(cur_node->key);
-        TArray<meshBoneCache> cache_list;
+        int32 set_index = cache_manager.getIndexByTime(cur_time);
+        int32 bone_index = 0;
         
         for (JsonIterator bone_it = JsonBegin(cur_node->value);
              bone_it != JsonEnd(cur_node->value);
@@ -444,52 +498,19 @@ static void FillBoneCache(JsonNode& json_obj,
             glm::vec4 cur_start_pt = ReadJSONVec4_2(*bone_node, "start_pt");
             glm::vec4 cur_end_pt = ReadJSONVec4_2(*bone_node, "end_pt");
             
-            meshBoneCache cache_data(cur_name);
-            cache_data.setWorldStartPt(cur_start_pt);
-            cache_data.setWorldEndPt(cur_end_pt);
+            // frames list their bones in the same order, search only if one does not
+            int32 key_index = ((bone_index < bone_keys.Num()) && (bone_keys[bone_index] == cur_name)) ?
+                bone_index : bone_keys.Find(cur_name);
+            if (key_index >= 0)
+            {
+                cache_manager.setFrameValue(set_index, key_index, cur_start_pt, cur_end_pt);
+            }
             
-            cache_list.Add(cache_data);
+            bone_index++;
         }
         
-        int32 set_index = cache_manager.getIndexByTime(cur_time);
-        cache_manager.getCacheTable()[set_index] = cache_list;
-
-		int32 gap_diff = cur_time - prev_time;
-		if (gap_diff > 1)
-		{
-			auto ptInterp = [&](const glm::vec4& src_pt, const glm::vec4& target_pt, float fraction)
-			{
-				return ((1.0f - fraction) * src_pt) + (fraction * target_pt);
-			};
-
-			// Gap Step
-			auto prev_index = cache_manager.getIndexByTime(prev_time);
-			for (int32 j = 1; j < gap_diff; j++)
-			{
-				auto gap_fraction = (float)j / (float)gap_diff;
-				TArray<meshBoneCache> gap_cache_list;
-				
-				for (int32 k = 0; k < cache_list.Num(); k++)
-				{
-					auto& cur_data = cache_manager.getCacheTable()[set_index][k];
-					auto& prev_data = cache_manager.getCacheTable()[prev_index][k];
-					meshBoneCache gap_cache_data(cur_data.getKey());
-					gap_cache_data.setWorldStartPt(
-						ptInterp(prev_data.getWorldStartPt(), cur_data.getWorldStartPt(), gap_fraction));
-					gap_cache_data.setWorldEndPt(
-						ptInterp(prev_data.getWorldEndPt(), cur_data.getWorldEndPt(), gap_fraction));
-
-					gap_cache_list.Add(gap_cache_data);
-				}
-
-				cache_manager.getCacheTable()[prev_index + j] = gap_cache_list;
-			}
-		}
-
-		prev_time = cur_time;
-	}
-    
-    cache_manager.makeAllReady();
+        cache_manager.setFrameReady(set_index);
+    }
 }
 
 static void FillDeformationCache(JsonNode& json_obj,
@@ -502,7 +523,9 @@ static void FillDeformationCache(JsonNode& json_obj,
 
     cache_manager.init(start_time, end_time);
     
-	int prev_time = start_time;
+    // only the exported keyframes are stored, frames between them blend on retrieval
+    cache_manager.initKeyframes(GetKeyFrameTimes(*base_obj));
+    
 	for (JsonIterator it = JsonBegin(base_obj->value);
          it != JsonEnd(base_obj->value);
          ++it)
@@ -540,52 +563,6 @@ static void FillDeformationCache(JsonNode& json_obj,
         
         int32 set_index = cache_manager.getIndexByTime(cur_time);
         cache_manager.getCacheTable()[set_index] = cache_list;
-
-		auto gap_diff = cur_time - prev_time;
-		if (gap_diff > 1)
-		{
-			auto ptsInterp = [&](const TArray<glm::vec2> src_pts, const TArray<glm::vec2> target_pts, float fraction)
-			{
-				TArray<glm::vec2> ret_pts;
-				ret_pts.SetNum(src_pts.Num());
-				for (int32 i = 0; i < src_pts.Num(); i++)
-				{
-					ret_pts[i] = ((1.0f - fraction) * src_pts[i]) + (fraction * target_pts[i]);
-				}
-
-				return ret_pts;
-			};
-
-			// Gap Step
-			int32 prev_index = cache_manager.getIndexByTime(prev_time);
-			for (int32 j = 1; j < gap_diff; j++)
-			{
-				auto gap_fraction = (float)j / (float)gap_diff;
-				TArray<meshDisplacementCache> gap_cache_list;
-				
-				for (int32 k = 0; k < cache_list.Num(); k++)
-				{
-					auto& cur_data = cache_manager.getCacheTable()[set_index][k];
-					auto& prev_data = cache_manager.getCacheTable()[prev_index][k];
-					meshDisplacementCache gap_cache_data(cur_data.getKey());
-					if (cur_data.getLocalDisplacements().Num() > 0)
-					{
-						gap_cache_data.setLocalDisplacements(
-							ptsInterp(prev_data.getLocalDisplacements(), cur_data.getLocalDisplacements(), gap_fraction));
-					}
-					else {
-						gap_cache_data.setPostDisplacements(
-							ptsInterp(prev_data.getPostDisplacements(), cur_data.getPostDisplacements(), gap_fraction));
-					}
-
-					gap_cache_list.Add(gap_cache_data);
-				}
-
-				cache_manager.getCacheTable()[prev_index + j] = gap_cache_list;
-			}
-		}
-
-		prev_time = cur_time;
     }
     
     cache_manager.makeAllReady();
@@ -773,440 +750,2718 @@ FillAnchorPointMap(JsonNode& json_obj)
 }
 
 
-namespace CreatureModule {
-    // Load the json structure
-    void LoadCreatureJSONData(const FName& filename_in,
-                              CreatureLoadDataPacket& load_data)
+// Cooked binary character data
+// Everything is stored as 4 byte little endian words: ints, floats and name table indices.
+// Layout: header, creature (mesh, skeleton, regions, uv swaps, anchors), clips, clip table, name table
+// Clip caches whose frames all hold the same keys are stored flat, [frame][key][values], and read in place
+static const uint32 CREATURE_BINARY_MAGIC = 0x4e425243; // "CRBN"
+static const int32 CREATURE_BINARY_VERSION = 4;
+static const int32 CREATURE_BINARY_HEADER_SIZE = 5 * sizeof(int32);
+static const int32 CREATURE_BINARY_TABLE_LAYOUT = 0;
+static const int32 CREATURE_BINARY_FLAT_LAYOUT = 1;
+static const int32 CREATURE_BINARY_QUANTIZED_LAYOUT = 2;
+
+class CreatureBinaryWriter {
+public:
+    CreatureBinaryWriter(TArray<uint8>& data_in)
+    : data(data_in)
+    {}
+    
+    int32 getPos() const
     {
-        std::ifstream read_file;
-        read_file.open(TCHAR_TO_UTF8(*filename_in.ToString()));
-        std::stringstream str_stream;
-        str_stream << read_file.rdbuf();
-        read_file.close();
-        
-        LoadCreatureJSONDataFromString(str_stream.str().c_str(), load_data);
+        return data.Num();
     }
     
-    void LoadCreatureJSONDataFromString(const FString& string_in,
-                                        CreatureLoadDataPacket& load_data)
+    void writeInt(int32 value_in)
     {
-        char *endptr;
-        size_t source_size = string_in.Len();
-        char *source_chars = new char[source_size+1];
-        source_chars[source_size]=0;
-        memcpy(source_chars, TCHAR_TO_UTF8(*string_in), source_size);
-        
-        JsonParseStatus status = jsonParse(source_chars, &endptr, &load_data.base_node, load_data.allocator);
-        
-        load_data.src_chars = source_chars;
-        
-        if(status != JSON_PARSE_OK) {
-            std::cerr<<"LoadCreatureJSONData() - Error parsing JSON!"<<std::endl;
-        }
+        writeBytes(&value_in, sizeof(int32));
     }
     
-    void LoadCreatureZipJSONData(const FName& filename_in,
-                                 CreatureLoadDataPacket& load_data)
+    void writeFloat(float value_in)
     {
-		std::cout << "LoadCreatureZipJSONData() - Function is NOT DEFINED!" << std::endl;
+        writeBytes(&value_in, sizeof(float));
     }
-
-    // Creature class
-    Creature::Creature(CreatureLoadDataPacket& load_data)
+    
+    void writeFloats(const float * values_in, int32 num_in)
     {
-		anchor_points_active = false;
-        LoadFromData(load_data);
+        writeBytes(values_in, num_in * (int32)sizeof(float));
     }
     
-    Creature::~Creature()
+    void writeUint8s(const uint8 * values_in, int32 num_in)
     {
-        delete [] global_pts;
-        delete [] global_indices;
-        delete [] global_uvs;
-        delete [] render_colours;
-        delete render_composition;
-        delete [] render_pts;
-
-		global_pts = nullptr;
-		global_indices = nullptr;
-		global_uvs = nullptr;
-		render_composition = nullptr;
-		render_pts = nullptr;
+        writeBytes(values_in, num_in);
     }
     
-    glm::uint32 *
-    Creature::GetGlobalIndices()
+    void writeUints(const glm::uint32 * values_in, int32 num_in)
     {
-        return global_indices;
+        writeBytes(values_in, num_in * (int32)sizeof(glm::uint32));
     }
     
-    glm::float32 *
-    Creature::GetGlobalPts()
+    void writeVec2(const glm::vec2& value_in)
     {
-        return global_pts;
+        writeFloats(glm::value_ptr(value_in), 2);
     }
     
-    glm::float32 *
-    Creature::GetGlobalUvs()
+    void writeVec4(const glm::vec4& value_in)
     {
-        return global_uvs;
+        writeFloats(glm::value_ptr(value_in), 4);
     }
     
-    glm::float32 *
-    Creature::GetRenderPts()
+    void writeZeros(int32 num_words)
     {
-        return render_pts;
+        data.AddZeroed(num_words * (int32)sizeof(int32));
     }
     
-    glm::uint8 *
-    Creature::GetRenderColours()
+    void writeName(const FName& name_in)
     {
-        return render_colours;
+        int32 * found_index = name_indices.Find(name_in);
+        if(found_index)
+        {
+            writeInt(*found_index);
+            return;
+        }
+        
+        int32 new_index = names.Add(name_in);
+        name_indices.Add(name_in, new_index);
+        writeInt(new_index);
     }
     
-    int32
-    Creature::GetTotalNumPoints() const
+    void setIntAt(int32 pos_in, int32 value_in)
     {
-        return total_num_pts;
+        FMemory::Memcpy(data.GetData() + pos_in, &value_in, sizeof(int32));
     }
     
-    int32
-    Creature::GetTotalNumIndices() const
+    // Names are null terminated utf8, padded to the next word
+    void writeNameTable()
     {
-        return total_num_indices;
+        writeInt(names.Num());
+        for(auto& cur_name : names)
+        {
+            std::string cur_str(TCHAR_TO_UTF8(*cur_name.ToString()));
+            int32 num_words = ((int32)cur_str.size() + sizeof(int32)) / sizeof(int32);
+            writeInt((int32)cur_str.size());
+            
+            int32 write_pos = data.Num();
+            data.AddZeroed(num_words * sizeof(int32));
+            FMemory::Memcpy(data.GetData() + write_pos, cur_str.c_str(), cur_str.size());
+        }
     }
     
-    meshRenderBoneComposition *
-    Creature::GetRenderComposition()
+protected:
+    void writeBytes(const void * src_in, int32 num_bytes)
     {
-        return render_composition;
+        int32 write_pos = data.Num();
+        data.AddUninitialized(num_bytes);
+        FMemory::Memcpy(data.GetData() + write_pos, src_in, num_bytes);
     }
     
-    void
-    Creature::FillRenderColours(glm::uint8 r, glm::uint8 g, glm::uint8 b, glm::uint8 a)
+    TArray<uint8>& data;
+    TArray<FName> names;
+    TMap<FName, int32> name_indices;
+};
+
+class CreatureBinaryReader {
+public:
+    CreatureBinaryReader(const uint8 * data_in, int64 size_in, const TArray<FName> * names_in)
+    : data(data_in), size(size_in), pos(0), names(names_in), valid(true)
+    {}
+    
+    bool isValid() const
     {
-        for(auto i = 0; i < total_num_pts; i++)
+        return valid;
+    }
+    
+    void seek(int64 pos_in)
+    {
+        if((pos_in < 0) || (pos_in > size))
         {
-            glm::uint8 * cur_colour = render_colours + (i * 4);
-            cur_colour[0] = r;
-            cur_colour[1] = g;
-            cur_colour[2] = b;
-            cur_colour[3] = a;
+            valid = false;
+            return;
         }
+        
+        pos = pos_in;
     }
-
-    const TArray<FName>& 
-    Creature::GetAnimationNames() const
+    
+    int32 readInt()
     {
-        return animation_names;
+        int32 ret_val = 0;
+        readBytes(&ret_val, sizeof(int32));
+        return ret_val;
     }
+    
+    float readFloat()
+    {
+        float ret_val = 0;
+        readBytes(&ret_val, sizeof(float));
+        return ret_val;
+    }
+    
+    void readFloats(float * values_out, int32 num_in)
+    {
+        readBytes(values_out, (int64)num_in * sizeof(float));
+    }
+    
+    void readUints(glm::uint32 * values_out, int32 num_in)
+    {
+        readBytes(values_out, (int64)num_in * sizeof(glm::uint32));
+    }
+    
+    glm::vec2 readVec2()
+    {
+        glm::vec2 ret_val(0);
+        readFloats(glm::value_ptr(ret_val), 2);
+        return ret_val;
+    }
+    
+    glm::vec4 readVec4()
+    {
+        glm::vec4 ret_val(0);
+        readFloats(glm::value_ptr(ret_val), 4);
+        return ret_val;
+    }
+    
+    // Reads an element count, rejecting counts that could not fit in the remaining data
+    int32 readCount(int32 min_elem_bytes=sizeof(int32))
+    {
+        int32 ret_val = readInt();
+        if((ret_val < 0) || ((int64)ret_val * min_elem_bytes > (size - pos)))
+        {
+            valid = false;
+            return 0;
+        }
+        
+        return ret_val;
+    }
+    
+    void skip(int64 num_bytes)
+    {
+        if(!valid || (num_bytes < 0) || (num_bytes > (size - pos)))
+        {
+            valid = false;
+            return;
+        }
+        
+        pos += num_bytes;
+    }
+    
+    // Returns a pointer into the data for num_in values read in place, without copying
+    const float * viewFloats(int64 num_in)
+    {
+        return (const float *)viewBytes(num_in * sizeof(float));
+    }
+    
+    const int32 * viewInts(int64 num_in)
+    {
+        return (const int32 *)viewBytes(num_in * sizeof(int32));
+    }
+    
+    const uint8 * viewUint8s(int64 num_in)
+    {
+        return viewBytes(num_in);
+    }
+    
+    FName readName()
+    {
+        int32 name_index = readInt();
+        if((names == nullptr) || !names->IsValidIndex(name_index))
+        {
+            valid = false;
+            return NAME_None;
+        }
+        
+        return (*names)[name_index];
+    }
+    
+    void readNameTable(TArray<FName>& names_out)
+    {
+        int32 num_names = readCount();
+        names_out.Reset(num_names);
+        for(int32 i = 0; (i < num_names) && valid; i++)
+        {
+            int32 str_len = readCount(1);
+            int64 num_bytes = ((int64)str_len + sizeof(int32)) / sizeof(int32) * sizeof(int32);
+            if(!valid || (num_bytes > (size - pos)) || (data[pos + str_len] != 0))
+            {
+                valid = false;
+                break;
+            }
+            
+            names_out.Add(FName(UTF8_TO_TCHAR((const ANSICHAR *)(data + pos))));
+            pos += num_bytes;
+        }
+    }
+    
+protected:
+    void readBytes(void * dst_out, int64 num_bytes)
+    {
+        if(!valid || (num_bytes < 0) || (num_bytes > (size - pos)))
+        {
+            valid = false;
+            FMemory::Memzero(dst_out, (size_t)FMath::Max((int64)0, num_bytes));
+            return;
+        }
+        
+        FMemory::Memcpy(dst_out, data + pos, num_bytes);
+        pos += num_bytes;
+    }
+    
+    const uint8 * viewBytes(int64 num_bytes)
+    {
+        if(!valid || (num_bytes < 0) || (num_bytes > (size - pos))
+           || (((uintptr_t)(data + pos) % sizeof(int32)) != 0))
+        {
+            valid = false;
+            return nullptr;
+        }
+        
+        const uint8 * ret_ptr = data + pos;
+        pos += num_bytes;
+        return ret_ptr;
+    }
+    
+    const uint8 * data;
+    int64 size, pos;
+    const TArray<FName> * names;
+    bool valid;
+};
+
+static bool ReadBinaryHeader(CreatureBinaryReader& reader,
+                             int32& creature_offset,
+                             int32& clips_offset,
+                             int32& names_offset)
+{
+    uint32 cur_magic = (uint32)reader.readInt();
+    int32 cur_version = reader.readInt();
+    creature_offset = reader.readInt();
+    clips_offset = reader.readInt();
+    names_offset = reader.readInt();
+    
+    return reader.isValid()
+        && (cur_magic == CREATURE_BINARY_MAGIC)
+        && (cur_version == CREATURE_BINARY_VERSION);
+}
 
-	const TMap<FName, TArray<CreatureUVSwapPacket> >& 
-	Creature::GetUvSwapPackets() const
-	{
-		return uv_swap_packets;
-	}
-
-	void 
-	Creature::SetActiveItemSwap(const FName& region_name, int32 swap_idx)
-	{
-		active_uv_swap_actions.Add(region_name, swap_idx);
-	}
-
-	void 
-	Creature::RemoveActiveItemSwap(const FName& region_name)
-	{
-		active_uv_swap_actions.Remove(region_name);
-	}
-
-	TMap<FName, int32>&
-	Creature::GetActiveItemSwaps()
-	{
-		return active_uv_swap_actions;
-	}
+static CreatureBinaryReader MakeBinaryReader(CreatureModule::CreatureLoadDataPacket& load_data,
+                                             int32 offset_in)
+{
+    CreatureBinaryReader ret_reader(load_data.binary_storage->GetData(),
+                                    load_data.binary_storage->GetSize(),
+                                    &load_data.binary_names);
+    ret_reader.seek(offset_in);
+    return ret_reader;
+}
 
-	void Creature::SetAnchorPointsActive(bool flag_in)
-	{
-		anchor_points_active = flag_in;
-	}
+// Region ranges are inclusive, an empty range ends one before its start
+static bool IsBinaryRangeValid(int32 start_in, int32 end_in, int32 total_in)
+{
+    return (start_in >= 0) && (end_in >= start_in - 1) && (end_in < total_in);
+}
 
-	bool Creature::GetAnchorPointsActive() const
-	{
-		return anchor_points_active;
-	}
+// Walks the creature section the way CreatureTemplate::LoadFromBinaryData() reads it, checking
+// the indices and region ranges against the mesh so a corrupt file is rejected before use
+static bool ValidateBinaryCreature(CreatureBinaryReader& reader)
+{
+    int32 num_pts = reader.readCount(5 * sizeof(float));
+    reader.skip((int64)num_pts * 5 * sizeof(float));
+    
+    int32 num_indices = reader.readCount();
+    for(int32 i = 0; (i < num_indices) && reader.isValid(); i++)
+    {
+        if((glm::uint32)reader.readInt() >= (glm::uint32)num_pts)
+        {
+            return false;
+        }
+    }
+    
+    int32 num_bones = reader.readCount();
+    for(int32 i = 0; (i < num_bones) && reader.isValid(); i++)
+    {
+        reader.readName();
+        reader.skip(sizeof(int32) + 20 * sizeof(float));
+        reader.skip((int64)reader.readCount() * sizeof(int32));
+    }
+    
+    int32 num_regions = reader.readCount();
+    for(int32 i = 0; (i < num_regions) && reader.isValid(); i++)
+    {
+        reader.readName();
+        reader.readInt();
+        int32 start_pt_index = reader.readInt();
+        int32 end_pt_index = reader.readInt();
+        int32 start_index = reader.readInt();
+        int32 end_index = reader.readInt();
+        if(!IsBinaryRangeValid(start_pt_index, end_pt_index, num_pts)
+           || !IsBinaryRangeValid(start_index, end_index, num_indices))
+        {
+            return false;
+        }
+        
+        int32 num_weights = reader.readCount();
+        for(int32 j = 0; (j < num_weights) && reader.isValid(); j++)
+        {
+            reader.readName();
+            reader.skip((int64)reader.readCount(sizeof(float)) * sizeof(float));
+        }
+    }
+    
+    return reader.isValid();
+}
 
-	glm::vec2 Creature::GetAnchorPoint(const FName & anim_clip_name_in) const
-	{
-		if (anchor_point_map.Contains(anim_clip_name_in))
-		{
-			return anchor_point_map[anim_clip_name_in];
-		}
+// Returns whether every frame of a cache is either empty or holds the same keys in the
+// same order, so it can be written with the flat layout
+template <typename T>
+static bool GetBinaryFlatKeys(TArray<TArray<T> >& cache_table,
+                              bool is_ready,
+                              TArray<FName>& out_keys)
+{
+    out_keys.Reset();
+    if(!is_ready)
+    {
+        return false;
+    }
+    
+    TArray<T> * ref_list = nullptr;
+    for(auto& cur_list : cache_table)
+    {
+        if(cur_list.Num() == 0)
+        {
+            continue;
+        }
+        
+        if(ref_list == nullptr)
+        {
+            ref_list = &cur_list;
+            continue;
+        }
+        
+        if(cur_list.Num() != ref_list->Num())
+        {
+            return false;
+        }
+        
+        for(int32 i = 0; i < cur_list.Num(); i++)
+        {
+            if(cur_list[i].getKey() != (*ref_list)[i].getKey())
+            {
+                return false;
+            }
+        }
+    }
+    
+    if(ref_list)
+    {
+        for(auto& cur_data : *ref_list)
+        {
+            out_keys.Add(cur_data.getKey());
+        }
+    }
+    
+    return true;
+}
 
-		return glm::vec2(0, 0);
-	}
+template <typename T>
+static void WriteBinaryCacheHeader(CreatureBinaryWriter& writer,
+                                   TArray<TArray<T> >& cache_table,
+                                   int32 layout_in,
+                                   bool is_ready)
+{
+    writer.writeInt(layout_in);
+    writer.writeInt(is_ready ? 1 : 0);
+    writer.writeInt(cache_table.Num());
+}
 
-    void
-    Creature::LoadFromData(CreatureLoadDataPacket& load_data)
+static void WriteBinaryFlatKeys(CreatureBinaryWriter& writer,
+                                const TArray<FName>& keys)
+{
+    writer.writeInt(keys.Num());
+    for(auto& cur_key : keys)
     {
-        JsonNode * json_root = load_data.base_node.toNode();
-        
-        // Load points and topology
-        JsonNode * json_mesh = GetJSONLevelNodeFromKey(*json_root, "mesh");
-        global_pts = ReadJSONPoints3D(*json_mesh, "points", total_num_pts);
-        global_indices = ReadJSONUints(*json_mesh,"indices", total_num_indices);
-        global_uvs = ReadJSONPoints2D(*json_mesh, "uvs", total_num_pts);
+        writer.writeName(cur_key);
+    }
+}
+
+template <typename T>
+static void WriteBinaryFrameCounts(CreatureBinaryWriter& writer,
+                                   TArray<TArray<T> >& cache_table)
+{
+    for(auto& cur_list : cache_table)
+    {
+        writer.writeInt(cur_list.Num());
+    }
+}
+
+// Displacement counts must also be the same in every frame for the flat layout
+static bool GetBinaryFlatDisplacementCounts(TArray<TArray<meshDisplacementCache> >& cache_table,
+                                            TArray<int32>& out_local_counts,
+                                            TArray<int32>& out_post_counts)
+{
+    out_local_counts.Reset();
+    out_post_counts.Reset();
+    for(auto& cur_list : cache_table)
+    {
+        if(cur_list.Num() == 0)
+        {
+            continue;
+        }
         
-        render_colours = new glm::uint8[total_num_pts * 4];
-        render_pts = new glm::float32[total_num_pts * 3];
-        FillRenderColours(255, 255, 255, 255);
+        if(out_local_counts.Num() == 0)
+        {
+            for(auto& cur_data : cur_list)
+            {
+                out_local_counts.Add(cur_data.getLocalDisplacements().Num());
+                out_post_counts.Add(cur_data.getPostDisplacements().Num());
+            }
+            
+            continue;
+        }
         
-        // Load bones
-        meshBone * root_bone = CreateBones(*json_root, "skeleton");
+        for(int32 i = 0; i < cur_list.Num(); i++)
+        {
+            if((cur_list[i].getLocalDisplacements().Num() != out_local_counts[i])
+               || (cur_list[i].getPostDisplacements().Num() != out_post_counts[i]))
+            {
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+// Full float displacements, flat when every frame shares one layout
+static void WriteBinaryDisplacements(CreatureBinaryWriter& writer,
+                                     meshDisplacementCacheManager& displacement_cache)
+{
+    TArray<FName> flat_keys;
+    auto& displacement_table = displacement_cache.getCacheTable();
+    TArray<int32> local_counts, post_counts;
+    if(GetBinaryFlatKeys(displacement_table, displacement_cache.allReady(), flat_keys)
+       && GetBinaryFlatDisplacementCounts(displacement_table, local_counts, post_counts))
+    {
+        int32 num_frame_floats = 0;
+        for(int32 i = 0; i < flat_keys.Num(); i++)
+        {
+            num_frame_floats += (local_counts[i] + post_counts[i]) * 2;
+        }
         
-        // Load regions
-        TArray<meshRenderRegion *> regions = CreateRegions(*json_mesh,
-                                                                "regions",
-                                                                global_indices,
-                                                                global_pts,
-                                                                global_uvs);
+        WriteBinaryCacheHeader(writer, displacement_table, CREATURE_BINARY_FLAT_LAYOUT, true);
+        WriteBinaryFlatKeys(writer, flat_keys);
+        for(int32 i = 0; i < flat_keys.Num(); i++)
+        {
+            writer.writeInt(local_counts[i]);
+            writer.writeInt(post_counts[i]);
+        }
         
-        // Add into composition
-        render_composition = new meshRenderBoneComposition();
-        render_composition->setRootBone(root_bone);
-        render_composition->getRootBone()->computeRestParentTransforms();
+        WriteBinaryFrameCounts(writer, displacement_table);
+        for(auto& cur_list : displacement_table)
+        {
+            if(cur_list.Num() == 0)
+            {
+                writer.writeZeros(num_frame_floats);
+            }
+            
+            for(auto& cur_data : cur_list)
+            {
+                auto& local_displacements = cur_data.getLocalDisplacements();
+                writer.writeFloats((const float *)local_displacements.GetData(), local_displacements.Num() * 2);
+                
+                auto& post_displacements = cur_data.getPostDisplacements();
+                writer.writeFloats((const float *)post_displacements.GetData(), post_displacements.Num() * 2);
+            }
+        }
+    }
+    else
+    {
+        WriteBinaryCacheHeader(writer, displacement_table, CREATURE_BINARY_TABLE_LAYOUT, displacement_cache.allReady());
+        for(auto& cur_list : displacement_table)
+        {
+            writer.writeInt(cur_list.Num());
+            for(auto& cur_data : cur_list)
+            {
+                writer.writeName(cur_data.getKey());
+                
+                auto& local_displacements = cur_data.getLocalDisplacements();
+                writer.writeInt(local_displacements.Num());
+                writer.writeFloats((const float *)local_displacements.GetData(), local_displacements.Num() * 2);
+                
+                auto& post_displacements = cur_data.getPostDisplacements();
+                writer.writeInt(post_displacements.Num());
+                writer.writeFloats((const float *)post_displacements.GetData(), post_displacements.Num() * 2);
+            }
+        }
+    }
+}
+
+// Quantized displacements are written just as they are laid out in memory
+static void WriteBinaryQuantizedDisplacements(CreatureBinaryWriter& writer,
+                                              const meshQuantizedDisplacementView& view_in)
+{
+    const meshCacheFlatView& ranges = view_in.ranges;
+    writer.writeInt(CREATURE_BINARY_QUANTIZED_LAYOUT);
+    writer.writeInt(1);
+    writer.writeInt(ranges.num_frames);
+    WriteBinaryFlatKeys(writer, ranges.keys);
+    for(int32 i = 0; i < ranges.keys.Num(); i++)
+    {
+        writer.writeInt(view_in.local_counts[i]);
+        writer.writeInt(view_in.post_counts[i]);
+    }
+    
+    writer.writeInt(view_in.value_bits);
+    for(int32 i = 0; i < ranges.num_frames; i++)
+    {
+        writer.writeInt(ranges.frame_counts[i]);
+    }
+    
+    writer.writeFloats(ranges.data, ranges.num_frames * ranges.frame_stride);
+    writer.writeUint8s(view_in.values, ranges.num_frames * view_in.frame_bytes);
+}
+
+// Caches of sparse clips only hold their keyframes, written ahead of the cache
+static void WriteBinaryKeyframes(CreatureBinaryWriter& writer,
+                                 const meshCacheKeyframes& keyframes)
+{
+    const TArray<int32>& key_times = keyframes.getKeyTimes();
+    writer.writeInt(key_times.Num());
+    for(auto cur_time : key_times)
+    {
+        writer.writeInt(cur_time);
+    }
+}
+
+static void WriteBinaryClip(CreatureBinaryWriter& writer,
+                            CreatureModule::CreatureAnimation& animation)
+{
+    writer.writeInt((int32)animation.getStartTime());
+    writer.writeInt((int32)animation.getEndTime());
+    
+    TArray<FName> flat_keys;
+    
+    // bone animation, always flat with 4 floats per bone
+    auto& bones_cache = animation.getBonesCache();
+    const int32 num_bone_frames = bones_cache.getNumFrames();
+    const int32 bone_frame_size = bones_cache.getNumKeys() * 4;
+    bones_cache.getKeys(flat_keys);
+    WriteBinaryKeyframes(writer, bones_cache.getKeyframes());
+    writer.writeInt(CREATURE_BINARY_FLAT_LAYOUT);
+    writer.writeInt(bones_cache.allReady() ? 1 : 0);
+    writer.writeInt(num_bone_frames);
+    WriteBinaryFlatKeys(writer, flat_keys);
+    for(int32 i = 0; i < num_bone_frames; i++)
+    {
+        writer.writeInt(bones_cache.isFrameReady(i) ? flat_keys.Num() : 0);
+    }
+    
+    for(int32 i = 0; i < num_bone_frames; i++)
+    {
+        if(bones_cache.isFrameReady(i))
+        {
+            writer.writeFloats(bones_cache.getFrameData(i), bone_frame_size);
+        }
+        else
+        {
+            writer.writeZeros(bone_frame_size);
+        }
+    }
+    
+    // mesh deformation animation
+    auto& displacement_cache = animation.getDisplacementCache();
+    WriteBinaryKeyframes(writer, displacement_cache.getKeyframes());
+    if(displacement_cache.hasQuantizedView())
+    {
+        WriteBinaryQuantizedDisplacements(writer, displacement_cache.getQuantizedView());
+    }
+    else
+    {
+        WriteBinaryDisplacements(writer, displacement_cache);
+    }
+    
+    // uv swapping animation
+    auto& uv_warp_cache = animation.getUVWarpCache();
+    auto& uv_warp_table = uv_warp_cache.getCacheTable();
+    if(GetBinaryFlatKeys(uv_warp_table, uv_warp_cache.allReady(), flat_keys))
+    {
+        WriteBinaryCacheHeader(writer, uv_warp_table, CREATURE_BINARY_FLAT_LAYOUT, true);
+        WriteBinaryFlatKeys(writer, flat_keys);
+        WriteBinaryFrameCounts(writer, uv_warp_table);
+        for(auto& cur_list : uv_warp_table)
+        {
+            if(cur_list.Num() == 0)
+            {
+                writer.writeZeros(flat_keys.Num() * 8);
+            }
+            
+            for(auto& cur_data : cur_list)
+            {
+                writer.writeFloat(cur_data.getEnabled() ? 1.0f : 0.0f);
+                writer.writeFloat((float)cur_data.getLevel());
+                writer.writeVec2(cur_data.getUvWarpLocalOffset());
+                writer.writeVec2(cur_data.getUvWarpGlobalOffset());
+                writer.writeVec2(cur_data.getUvWarpScale());
+            }
+        }
+    }
+    else
+    {
+        WriteBinaryCacheHeader(writer, uv_warp_table, CREATURE_BINARY_TABLE_LAYOUT, uv_warp_cache.allReady());
+        for(auto& cur_list : uv_warp_table)
+        {
+            writer.writeInt(cur_list.Num());
+            for(auto& cur_data : cur_list)
+            {
+                writer.writeName(cur_data.getKey());
+                writer.writeInt(cur_data.getEnabled() ? 1 : 0);
+                writer.writeInt(cur_data.getLevel());
+                writer.writeVec2(cur_data.getUvWarpLocalOffset());
+                writer.writeVec2(cur_data.getUvWarpGlobalOffset());
+                writer.writeVec2(cur_data.getUvWarpScale());
+            }
+        }
+    }
+    
+    // opacity animation
+    auto& opacity_cache = animation.getOpacityCache();
+    auto& opacity_table = opacity_cache.getCacheTable();
+    if(GetBinaryFlatKeys(opacity_table, opacity_cache.allReady(), flat_keys))
+    {
+        WriteBinaryCacheHeader(writer, opacity_table, CREATURE_BINARY_FLAT_LAYOUT, true);
+        WriteBinaryFlatKeys(writer, flat_keys);
+        WriteBinaryFrameCounts(writer, opacity_table);
+        for(auto& cur_list : opacity_table)
+        {
+            if(cur_list.Num() == 0)
+            {
+                writer.writeZeros(flat_keys.Num() * 4);
+            }
+            
+            for(auto& cur_data : cur_list)
+            {
+                writer.writeFloat(cur_data.getOpacity());
+                writer.writeFloat(cur_data.getRed());
+                writer.writeFloat(cur_data.getGreen());
+                writer.writeFloat(cur_data.getBlue());
+            }
+        }
+    }
+    else
+    {
+        WriteBinaryCacheHeader(writer, opacity_table, CREATURE_BINARY_TABLE_LAYOUT, opacity_cache.allReady());
+        for(auto& cur_list : opacity_table)
+        {
+            writer.writeInt(cur_list.Num());
+            for(auto& cur_data : cur_list)
+            {
+                writer.writeName(cur_data.getKey());
+                writer.writeFloat(cur_data.getOpacity());
+                writer.writeFloat(cur_data.getRed());
+                writer.writeFloat(cur_data.getGreen());
+                writer.writeFloat(cur_data.getBlue());
+            }
+        }
+    }
+}
+
+// Reads the layout and frame count of a cache and checks it against the clip time range
+static bool ReadBinaryCacheHeader(CreatureBinaryReader& reader,
+                                  int32 num_frames,
+                                  int32& layout_out,
+                                  bool& is_ready,
+                                  bool allow_quantized=false)
+{
+    layout_out = reader.readInt();
+    is_ready = (reader.readInt() != 0);
+    if(reader.readInt() != num_frames)
+    {
+        return false;
+    }
+    
+    return reader.isValid()
+        && ((layout_out == CREATURE_BINARY_TABLE_LAYOUT) || (layout_out == CREATURE_BINARY_FLAT_LAYOUT)
+            || (allow_quantized && (layout_out == CREATURE_BINARY_QUANTIZED_LAYOUT)));
+}
+
+// Reads the keyframe times of a cache and the number of frames it stores
+static bool ReadBinaryKeyframes(CreatureBinaryReader& reader,
+                                int32 start_time,
+                                int32 end_time,
+                                TArray<int32>& key_times_out,
+                                int32& num_frames_out)
+{
+    int32 num_keys = reader.readCount();
+    key_times_out.SetNumUninitialized(num_keys);
+    for(int32 i = 0; i < num_keys; i++)
+    {
+        key_times_out[i] = reader.readInt();
+    }
+    
+    meshCacheKeyframes read_keyframes;
+    bool is_valid = reader.isValid() && read_keyframes.init(start_time, end_time, key_times_out);
+    num_frames_out = read_keyframes.getNumFrames();
+    return is_valid;
+}
+
+static void ReadBinaryFlatKeys(CreatureBinaryReader& reader,
+                               meshCacheFlatView& view_out)
+{
+    int32 num_keys = reader.readCount();
+    view_out.keys.Reset(num_keys);
+    for(int32 i = 0; i < num_keys; i++)
+    {
+        view_out.keys.Add(reader.readName());
+    }
+}
+
+// Sets up the key offsets for a flat cache whose keys all take values_per_key floats
+static void SetBinaryFlatStride(meshCacheFlatView& view_out,
+                                int32 values_per_key)
+{
+    view_out.key_offsets.SetNumUninitialized(view_out.keys.Num());
+    for(int32 i = 0; i < view_out.keys.Num(); i++)
+    {
+        view_out.key_offsets[i] = i * values_per_key;
+    }
+    
+    view_out.frame_stride = view_out.keys.Num() * values_per_key;
+}
+
+// Points the view at the frame counts and values, which stay in the binary data
+static bool ReadBinaryFlatData(CreatureBinaryReader& reader,
+                               int32 num_frames,
+                               meshCacheFlatView& view_out)
+{
+    view_out.num_frames = num_frames;
+    view_out.frame_counts = reader.viewInts(num_frames);
+    view_out.data = reader.viewFloats((int64)num_frames * view_out.frame_stride);
+    if(!reader.isValid())
+    {
+        view_out = meshCacheFlatView();
+        return false;
+    }
+    
+    for(int32 i = 0; i < num_frames; i++)
+    {
+        if((view_out.frame_counts[i] != 0) && (view_out.frame_counts[i] != view_out.keys.Num()))
+        {
+            view_out = meshCacheFlatView();
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+static void ReadBinaryDisplacements(CreatureBinaryReader& reader,
+                                    TArray<glm::vec2>& displacements_out)
+{
+    int32 num_pts = reader.readCount(2 * sizeof(float));
+    displacements_out.SetNumUninitialized(num_pts);
+    reader.readFloats((float *)displacements_out.GetData(), num_pts * 2);
+}
+
+namespace CreatureModule {
+    // CreatureBinaryStorage
+    CreatureBinaryStorage::CreatureBinaryStorage()
+    : mapped_handle(nullptr), mapped_region(nullptr)
+    {}
+    
+    CreatureBinaryStorage::~CreatureBinaryStorage()
+    {
+        Release();
+    }
+    
+    void
+    CreatureBinaryStorage::Release()
+    {
+        // regions have to go before their handle
+        delete mapped_region;
+        delete mapped_handle;
+        mapped_region = nullptr;
+        mapped_handle = nullptr;
+        owned_data.Empty();
+    }
+    
+    void
+    CreatureBinaryStorage::SetFromBuffer(const uint8 * data_in, int64 size_in)
+    {
+        Release();
+        owned_data.SetNumUninitialized((int32)size_in);
+        FMemory::Memcpy(owned_data.GetData(), data_in, size_in);
+    }
+    
+    bool
+    CreatureBinaryStorage::LoadFromFile(const FName& filename_in)
+    {
+        Release();
+        
+        FString filename_str = filename_in.ToString();
+        IMappedFileHandle * new_handle = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*filename_str);
+        if(new_handle)
+        {
+            IMappedFileRegion * new_region = new_handle->MapRegion(0, new_handle->GetFileSize());
+            if(new_region)
+            {
+                mapped_handle = new_handle;
+                mapped_region = new_region;
+                return true;
+            }
+            
+            delete new_handle;
+        }
+        
+        // Mapping is not supported everywhere (e.g. inside pak files), read the file instead
+        std::ifstream read_file;
+        read_file.open(TCHAR_TO_UTF8(*filename_str), std::ios::in | std::ios::binary | std::ios::ate);
+        if(!read_file.is_open())
+        {
+            return false;
+        }
+        
+        int64 file_size = (int64)read_file.tellg();
+        read_file.seekg(0, std::ios::beg);
+        
+        owned_data.SetNumUninitialized((int32)file_size);
+        read_file.read((char *)owned_data.GetData(), file_size);
+        return read_file.good();
+    }
+    
+    const uint8 *
+    CreatureBinaryStorage::GetData() const
+    {
+        return mapped_region ? mapped_region->GetMappedPtr() : owned_data.GetData();
+    }
+    
+    int64
+    CreatureBinaryStorage::GetSize() const
+    {
+        return mapped_region ? mapped_region->GetMappedSize() : (int64)owned_data.Num();
+    }
+    
+    bool
+    CreatureBinaryStorage::IsMapped() const
+    {
+        return mapped_region != nullptr;
+    }
+    
+    // Load the json structure
+    void LoadCreatureJSONData(const FName& filename_in,
+                              CreatureLoadDataPacket& load_data)
+    {
+        std::ifstream read_file;
+        read_file.open(TCHAR_TO_UTF8(*filename_in.ToString()));
+        std::stringstream str_stream;
+        str_stream << read_file.rdbuf();
+        read_file.close();
+        
+        LoadCreatureJSONDataFromString(str_stream.str().c_str(), load_data);
+    }
+    
+    void LoadCreatureJSONDataFromString(const FString& string_in,
+                                        CreatureLoadDataPacket& load_data)
+    {
+        char *endptr;
+        size_t source_size = string_in.Len();
+        char *source_chars = new char[source_size+1];
+        source_chars[source_size]=0;
+        memcpy(source_chars, TCHAR_TO_UTF8(*string_in), source_size);
+        
+        JsonParseStatus status = jsonParse(source_chars, &endptr, &load_data.base_node, load_data.allocator);
+        
+        load_data.src_chars = source_chars;
+        load_data.src_size = (int64)source_size + 1;
+        
+        if(status != JSON_PARSE_OK) {
+            std::cerr<<"LoadCreatureJSONData() - Error parsing JSON!"<<std::endl;
+        }
+    }
+    
+    void LoadCreatureZipJSONData(const FName& filename_in,
+                                 CreatureLoadDataPacket& load_data)
+    {
+		std::cout << "LoadCreatureZipJSONData() - Function is NOT DEFINED!" << std::endl;
+    }
+    
+    bool IsCreatureBinaryData(const uint8 * data_in, int64 size_in)
+    {
+        if((data_in == nullptr) || (size_in < CREATURE_BINARY_HEADER_SIZE))
+        {
+            return false;
+        }
+        
+        uint32 cur_magic = 0;
+        FMemory::Memcpy(&cur_magic, data_in, sizeof(uint32));
+        return cur_magic == CREATURE_BINARY_MAGIC;
+    }
+    
+    bool IsCreatureBinaryFile(const FName& filename_in)
+    {
+        std::ifstream read_file;
+        read_file.open(TCHAR_TO_UTF8(*filename_in.ToString()), std::ios::in | std::ios::binary);
+        
+        uint8 header_data[CREATURE_BINARY_HEADER_SIZE] = { 0 };
+        read_file.read((char *)header_data, CREATURE_BINARY_HEADER_SIZE);
+        return read_file.good() && IsCreatureBinaryData(header_data, CREATURE_BINARY_HEADER_SIZE);
+    }
+    
+    bool LoadCreatureBinaryData(const FName& filename_in,
+                                CreatureLoadDataPacket& load_data)
+    {
+        TSharedPtr<CreatureBinaryStorage> new_storage(new CreatureBinaryStorage());
+        if(!new_storage->LoadFromFile(filename_in))
+        {
+            std::cerr<<"LoadCreatureBinaryData() - Could not open file!"<<std::endl;
+            return false;
+        }
+        
+        load_data.binary_storage = new_storage;
+        return LoadCreatureBinaryDataFromBuffer(nullptr, 0, load_data);
+    }
+    
+    bool LoadCreatureBinaryDataFromBuffer(const uint8 * data_in,
+                                          int64 size_in,
+                                          CreatureLoadDataPacket& load_data)
+    {
+        // A null buffer means the data was already loaded into the packet
+        if(data_in != nullptr)
+        {
+            load_data.binary_storage = TSharedPtr<CreatureBinaryStorage>(new CreatureBinaryStorage());
+            load_data.binary_storage->SetFromBuffer(data_in, size_in);
+        }
+        
+        load_data.binary_names.Reset();
+        if(!load_data.binary_storage.IsValid())
+        {
+            return false;
+        }
+        
+        const uint8 * binary_data = load_data.binary_storage->GetData();
+        int64 binary_size = load_data.binary_storage->GetSize();
+        
+        int32 creature_offset = 0, clips_offset = 0, names_offset = 0;
+        CreatureBinaryReader reader(binary_data, binary_size, nullptr);
+        bool is_valid = IsCreatureBinaryData(binary_data, binary_size)
+            && ReadBinaryHeader(reader, creature_offset, clips_offset, names_offset);
+        
+        if(is_valid)
+        {
+            reader.seek(names_offset);
+            reader.readNameTable(load_data.binary_names);
+            is_valid = reader.isValid();
+        }
+        
+        if(is_valid)
+        {
+            CreatureBinaryReader creature_reader(binary_data, binary_size, &load_data.binary_names);
+            creature_reader.seek(creature_offset);
+            is_valid = ValidateBinaryCreature(creature_reader);
+        }
+        
+        if(!is_valid)
+        {
+            std::cerr<<"LoadCreatureBinaryData() - Invalid or outdated binary data!"<<std::endl;
+            load_data.binary_storage.Reset();
+            load_data.binary_names.Empty();
+        }
+        
+        return is_valid;
+    }
+    
+    bool SaveCreatureBinaryData(CreatureLoadDataPacket& load_data,
+                                TArray<uint8>& out_data)
+    {
+        out_data.Reset();
+        if(load_data.IsBinary())
+        {
+            out_data.SetNumUninitialized((int32)load_data.binary_storage->GetSize());
+            FMemory::Memcpy(out_data.GetData(), load_data.binary_storage->GetData(), out_data.Num());
+            return true;
+        }
+        
+        if(load_data.base_node.getTag() != JSON_TAG_OBJECT)
+        {
+            return false;
+        }
+        
+        JsonNode * json_root = load_data.base_node.toNode();
+        JsonNode * json_mesh = GetJSONLevelNodeFromKey(*json_root, "mesh");
+        JsonNode * json_skeleton = GetJSONLevelNodeFromKey(*json_root, "skeleton");
+        JsonNode * json_anim_base = GetJSONLevelNodeFromKey(*json_root, "animation");
+        if((json_mesh == NULL) || (json_skeleton == NULL) || (json_anim_base == NULL))
+        {
+            return false;
+        }
+        
+        CreatureBinaryWriter writer(out_data);
+        for(int32 i = 0; i < CREATURE_BINARY_HEADER_SIZE / (int32)sizeof(int32); i++)
+        {
+            writer.writeInt(0);
+        }
+        
+        // Mesh
+        int32 creature_offset = writer.getPos();
+        int32 num_pts = 0, num_uvs = 0, num_indices = 0;
+        glm::float32 * read_pts = ReadJSONPoints3D(*json_mesh, "points", num_pts);
+        glm::float32 * read_uvs = ReadJSONPoints2D(*json_mesh, "uvs", num_uvs);
+        glm::uint32 * read_indices = ReadJSONUints(*json_mesh, "indices", num_indices);
+        
+        writer.writeInt(num_pts);
+        writer.writeFloats(read_pts, num_pts * 3);
+        writer.writeFloats(read_uvs, num_pts * 2);
+        writer.writeInt(num_indices);
+        writer.writeUints(read_indices, num_indices);
+        
+        delete [] read_pts;
+        delete [] read_uvs;
+        delete [] read_indices;
+        
+        // Skeleton
+        TArray<JsonNode *> bone_nodes;
+        for (JsonIterator it = JsonBegin(json_skeleton->value); it != JsonEnd(json_skeleton->value); ++it)
+        {
+            bone_nodes.Add(*it);
+        }
+        
+        writer.writeInt(bone_nodes.Num());
+        for(auto cur_node : bone_nodes)
+        {
+            glm::mat4 cur_parent_mat = ReadJSONMat4(*cur_node, "restParentMat");
+            TArray<int32> cur_children_ids = ReadIntArray(*cur_node, "children");
+            
+            writer.writeName(FName(cur_node->key));
+            writer.writeInt((int32)GetJSONNodeFromKey(*cur_node, "id")->value.toNumber());
+            writer.writeFloats(glm::value_ptr(cur_parent_mat), 16);
+            writer.writeVec2(glm::vec2(ReadJSONVec4_2(*cur_node, "localRestStartPt")));
+            writer.writeVec2(glm::vec2(ReadJSONVec4_2(*cur_node, "localRestEndPt")));
+            writer.writeInt(cur_children_ids.Num());
+            for(auto cur_child_id : cur_children_ids)
+            {
+                writer.writeInt(cur_child_id);
+            }
+        }
+        
+        // Regions and weights
+        JsonNode * json_regions = GetJSONNodeFromKey(*json_mesh, "regions");
+        TArray<JsonNode *> region_nodes;
+        for (JsonIterator it = JsonBegin(json_regions->value); it != JsonEnd(json_regions->value); ++it)
+        {
+            region_nodes.Add(*it);
+        }
+        
+        writer.writeInt(region_nodes.Num());
+        for(auto cur_node : region_nodes)
+        {
+            writer.writeName(FName(cur_node->key));
+            writer.writeInt((int32)GetJSONNodeFromKey(*cur_node, "id")->value.toNumber());
+            writer.writeInt((int32)GetJSONNodeFromKey(*cur_node, "start_pt_index")->value.toNumber());
+            writer.writeInt((int32)GetJSONNodeFromKey(*cur_node, "end_pt_index")->value.toNumber());
+            writer.writeInt((int32)GetJSONNodeFromKey(*cur_node, "start_index")->value.toNumber());
+            writer.writeInt((int32)GetJSONNodeFromKey(*cur_node, "end_index")->value.toNumber());
+            
+            JsonNode * weight_obj = GetJSONNodeFromKey(*cur_node, "weights");
+            TArray<FName> weight_keys = GetJSONKeysFromNode(*weight_obj);
+            writer.writeInt(weight_keys.Num());
+            for(auto& cur_key : weight_keys)
+            {
+                TArray<float> values = ReadFloatArray(*weight_obj, cur_key);
+                writer.writeName(cur_key);
+                writer.writeInt(values.Num());
+                writer.writeFloats(values.GetData(), values.Num());
+            }
+        }
+        
+        // UV swap items
+        TMap<FName, TArray<CreatureUVSwapPacket> > swap_packets;
+        JsonNode * json_uv_swap_base = GetJSONLevelNodeFromKey(*json_root, "uv_swap_items");
+        if (json_uv_swap_base)
+        {
+            swap_packets = FillSwapUVPacketMap(*json_uv_swap_base);
+        }
+        
+        writer.writeInt(swap_packets.Num());
+        for(auto& cur_data : swap_packets)
+        {
+            writer.writeName(cur_data.Key);
+            writer.writeInt(cur_data.Value.Num());
+            for(auto& cur_packet : cur_data.Value)
+            {
+                writer.writeVec2(cur_packet.local_offset);
+                writer.writeVec2(cur_packet.global_offset);
+                writer.writeVec2(cur_packet.scale);
+                writer.writeInt(cur_packet.tag);
+            }
+        }
+        
+        // Anchor points
+        TMap<FName, glm::vec2> anchor_points;
+        JsonNode * anchor_point_base = GetJSONLevelNodeFromKey(*json_root, "anchor_points_items");
+        if (anchor_point_base)
+        {
+            anchor_points = FillAnchorPointMap(*anchor_point_base);
+        }
+        
+        writer.writeInt(anchor_points.Num());
+        for(auto& cur_data : anchor_points)
+        {
+            writer.writeName(cur_data.Key);
+            writer.writeVec2(cur_data.Value);
+        }
+        
+        // Animation clips, cooked from the fully built caches so gap steps are baked in
+        TArray<FName> animation_names = GetJSONKeysFromNode(*json_anim_base);
+        TArray<int32> clip_offsets;
+        for(auto& cur_name : animation_names)
+        {
+            CreatureAnimation cur_animation(load_data, cur_name);
+            clip_offsets.Add(writer.getPos());
+            WriteBinaryClip(writer, cur_animation);
+        }
+        
+        int32 clips_offset = writer.getPos();
+        writer.writeInt(animation_names.Num());
+        for(int32 i = 0; i < animation_names.Num(); i++)
+        {
+            writer.writeName(animation_names[i]);
+            writer.writeInt(clip_offsets[i]);
+        }
+        
+        int32 names_offset = writer.getPos();
+        writer.writeNameTable();
+        
+        writer.setIntAt(0, (int32)CREATURE_BINARY_MAGIC);
+        writer.setIntAt(4, CREATURE_BINARY_VERSION);
+        writer.setIntAt(8, creature_offset);
+        writer.setIntAt(12, clips_offset);
+        writer.setIntAt(16, names_offset);
+        
+        return true;
+    }
+
+    // CreatureTemplate class
+    CreatureTemplate::CreatureTemplate(CreatureLoadDataPacket& load_data)
+    {
+        global_indices = nullptr;
+        global_pts = nullptr;
+        global_uvs = nullptr;
+        total_num_pts = 0;
+        total_num_indices = 0;
+        rest_composition = nullptr;
+        LoadFromData(load_data);
+    }
+    
+    CreatureTemplate::~CreatureTemplate()
+    {
+        delete [] global_pts;
+        delete [] global_indices;
+        delete [] global_uvs;
+        delete rest_composition;
+    }
+    
+    glm::uint32 *
+    CreatureTemplate::GetGlobalIndices() const
+    {
+        return global_indices;
+    }
+    
+    glm::float32 *
+    CreatureTemplate::GetGlobalPts() const
+    {
+        return global_pts;
+    }
+    
+    const glm::float32 *
+    CreatureTemplate::GetGlobalUvs() const
+    {
+        return global_uvs;
+    }
+    
+    int32
+    CreatureTemplate::GetTotalNumPoints() const
+    {
+        return total_num_pts;
+    }
+    
+    int32
+    CreatureTemplate::GetTotalNumIndices() const
+    {
+        return total_num_indices;
+    }
+    
+    meshRenderBoneComposition *
+    CreatureTemplate::GetRestComposition() const
+    {
+        return rest_composition;
+    }
+    
+    const TArray<FName>&
+    CreatureTemplate::GetAnimationNames() const
+    {
+        return animation_names;
+    }
+    
+    int64
+    CreatureTemplate::GetAllocatedSize() const
+    {
+        return (int64)sizeof(CreatureTemplate)
+            + (int64)total_num_pts * 5 * sizeof(glm::float32)
+            + (int64)total_num_indices * sizeof(glm::uint32)
+            + (int64)animation_names.GetAllocatedSize();
+    }
+    
+    const TMap<FName, TArray<CreatureUVSwapPacket> >&
+    CreatureTemplate::GetUvSwapPackets() const
+    {
+        return uv_swap_packets;
+    }
+    
+    const TMap<FName, glm::vec2>&
+    CreatureTemplate::GetAnchorPoints() const
+    {
+        return anchor_point_map;
+    }
+    
+    void
+    CreatureTemplate::LoadFromData(CreatureLoadDataPacket& load_data)
+    {
+        if(load_data.IsBinary())
+        {
+            LoadFromBinaryData(load_data);
+            return;
+        }
+        
+        JsonNode * json_root = load_data.base_node.toNode();
+        
+        // Load points and topology
+        JsonNode * json_mesh = GetJSONLevelNodeFromKey(*json_root, "mesh");
+        global_pts = ReadJSONPoints3D(*json_mesh, "points", total_num_pts);
+        global_indices = ReadJSONUints(*json_mesh,"indices", total_num_indices);
+        global_uvs = ReadJSONPoints2D(*json_mesh, "uvs", total_num_pts);
+        
+        // Load bones
+        meshBone * root_bone = CreateBones(*json_root, "skeleton");
+        
+        // Load regions
+        TArray<meshRenderRegion *> regions = CreateRegions(*json_mesh,
+                                                                "regions",
+                                                                global_indices,
+                                                                global_pts,
+                                                                global_uvs);
+        
+        // Add into composition
+        SetupRestComposition(root_bone, regions);
+
+        // Fill up available animation names
+        JsonNode * json_anim_base = GetJSONLevelNodeFromKey(*json_root, "animation");
+        animation_names = GetJSONKeysFromNode(*json_anim_base);
+
+		// Fill up uv swap packets
+		
+		JsonNode * json_uv_swap_base = GetJSONLevelNodeFromKey(*json_root, "uv_swap_items");
+		if (json_uv_swap_base)
+		{
+			uv_swap_packets = FillSwapUVPacketMap(*json_uv_swap_base);
+		}
+
+		// Load Anchor Points
+		JsonNode * anchor_point_base = GetJSONLevelNodeFromKey(*json_root, "anchor_points_items");
+		if (anchor_point_base)
+		{
+			anchor_point_map = FillAnchorPointMap(*anchor_point_base);
+		}
+    }
+
+
+    void
+    CreatureTemplate::LoadFromBinaryData(CreatureLoadDataPacket& load_data)
+    {
+        int32 creature_offset = 0, clips_offset = 0, names_offset = 0;
+        CreatureBinaryReader reader = MakeBinaryReader(load_data, 0);
+        ReadBinaryHeader(reader, creature_offset, clips_offset, names_offset);
+        reader.seek(creature_offset);
+        
+        // Load points and topology
+        total_num_pts = reader.readCount(5 * sizeof(float));
+        global_pts = new glm::float32[total_num_pts * 3];
+        global_uvs = new glm::float32[total_num_pts * 2];
+        reader.readFloats(global_pts, total_num_pts * 3);
+        reader.readFloats(global_uvs, total_num_pts * 2);
+        
+        total_num_indices = reader.readCount();
+        global_indices = new glm::uint32[total_num_indices];
+        reader.readUints(global_indices, total_num_indices);
+        
+        // Load bones
+        TMap<int32, std::pair<meshBone *, TArray<int32> > > bone_data;
+        TSet<int32> child_set;
+        int32 num_bones = reader.readCount();
+        for(int32 i = 0; i < num_bones; i++)
+        {
+            FName cur_name = reader.readName();
+            int32 cur_id = reader.readInt();
+            glm::mat4 cur_parent_mat;
+            reader.readFloats(glm::value_ptr(cur_parent_mat), 16);
+            glm::vec2 cur_local_rest_start_pt = reader.readVec2();
+            glm::vec2 cur_local_rest_end_pt = reader.readVec2();
+            
+            TArray<int32> cur_children_ids;
+            cur_children_ids.SetNumUninitialized(reader.readCount());
+            for(auto& cur_child_id : cur_children_ids)
+            {
+                cur_child_id = reader.readInt();
+                child_set.Add(cur_child_id);
+            }
+            
+            meshBone * new_bone = new meshBone(cur_name,
+                                               glm::vec4(0),
+                                               glm::vec4(0),
+                                               cur_parent_mat);
+            new_bone->getLocalRestStartPt() = glm::vec4(cur_local_rest_start_pt, 0, 1.0f);
+            new_bone->getLocalRestEndPt() = glm::vec4(cur_local_rest_end_pt, 0, 1.0f);
+            new_bone->calcRestData();
+            new_bone->setTagId(cur_id);
+            
+            bone_data.Add(cur_id, std::make_pair(new_bone, cur_children_ids));
+        }
+        
+        for(auto& cur_child_id : child_set)
+        {
+            if(!bone_data.Contains(cur_child_id))
+            {
+                std::cerr<<"CreatureTemplate::LoadFromBinaryData() - Bone hierarchy is invalid!"<<std::endl;
+                child_set.Empty();
+                for(auto& cur_data : bone_data)
+                {
+                    cur_data.Value.second.Empty();
+                }
+                break;
+            }
+        }
+        
+        meshBone * root_bone = LinkBones(bone_data, child_set);
+        
+        // Load regions
+        TArray<meshRenderRegion *> regions;
+        int32 num_regions = reader.readCount();
+        for(int32 i = 0; i < num_regions; i++)
+        {
+            FName cur_name = reader.readName();
+            int32 cur_id = reader.readInt();
+            int32 cur_start_pt_index = reader.readInt();
+            int32 cur_end_pt_index = reader.readInt();
+            int32 cur_start_index = reader.readInt();
+            int32 cur_end_index = reader.readInt();
+            
+            // LoadCreatureBinaryDataFromBuffer() rejects these, an unchecked packet gets an empty region
+            if(!IsBinaryRangeValid(cur_start_pt_index, cur_end_pt_index, total_num_pts)
+               || !IsBinaryRangeValid(cur_start_index, cur_end_index, total_num_indices))
+            {
+                std::cerr<<"CreatureTemplate::LoadFromBinaryData() - Region range is out of bounds!"<<std::endl;
+                cur_start_pt_index = cur_start_index = 0;
+                cur_end_pt_index = cur_end_index = -1;
+            }
+            
+            meshRenderRegion * new_region = new meshRenderRegion(global_indices,
+                                                                 global_pts,
+                                                                 global_uvs,
+                                                                 cur_start_pt_index,
+                                                                 cur_end_pt_index,
+                                                                 cur_start_index,
+                                                                 cur_end_index);
+            
+            new_region->setName(cur_name);
+            new_region->setTagId(cur_id);
+            
+            // Read in weights
+            TMap<FName, TArray<float> >& weight_map =
+                new_region->getWeights();
+            int32 num_weights = reader.readCount();
+            for(int32 j = 0; j < num_weights; j++)
+            {
+                FName cur_key = reader.readName();
+                TArray<float> values;
+                values.SetNumUninitialized(reader.readCount(sizeof(float)));
+                reader.readFloats(values.GetData(), values.Num());
+                weight_map.Add(cur_key, values);
+            }
+            
+            regions.Add(new_region);
+        }
+        
+        // Fill up uv swap packets
+        int32 num_swaps = reader.readCount();
+        for(int32 i = 0; i < num_swaps; i++)
+        {
+            FName cur_name = reader.readName();
+            TArray<CreatureUVSwapPacket> cur_packets;
+            int32 num_packets = reader.readCount(7 * sizeof(float));
+            for(int32 j = 0; j < num_packets; j++)
+            {
+                glm::vec2 local_offset = reader.readVec2();
+                glm::vec2 global_offset = reader.readVec2();
+                glm::vec2 scale = reader.readVec2();
+                cur_packets.Add(CreatureUVSwapPacket(local_offset, global_offset, scale, reader.readInt()));
+            }
+            
+            uv_swap_packets.Add(cur_name, cur_packets);
+        }
+        
+        // Load Anchor Points
+        int32 num_anchors = reader.readCount();
+        for(int32 i = 0; i < num_anchors; i++)
+        {
+            FName cur_name = reader.readName();
+            anchor_point_map.Add(cur_name, reader.readVec2());
+        }
+        
+        // Fill up available animation names
+        reader.seek(clips_offset);
+        int32 num_clips = reader.readCount(2 * sizeof(int32));
+        for(int32 i = 0; i < num_clips; i++)
+        {
+            animation_names.Add(reader.readName());
+            reader.readInt();
+        }
+        
+        if(!reader.isValid() || (root_bone == NULL))
+        {
+            std::cerr<<"CreatureTemplate::LoadFromBinaryData() - Binary data is corrupt!"<<std::endl;
+        }
+        
+        if(root_bone == NULL)
+        {
+            root_bone = new meshBone(NAME_None, glm::vec4(0), glm::vec4(0), glm::mat4(1.0f));
+        }
+        
+        // Add into composition
+        SetupRestComposition(root_bone, regions);
+    }
+    
+    void
+    CreatureTemplate::SetupRestComposition(meshBone * root_bone,
+                                           TArray<meshRenderRegion *>& regions)
+    {
+        rest_composition = new meshRenderBoneComposition();
+        rest_composition->setRootBone(root_bone);
+        rest_composition->getRootBone()->computeRestParentTransforms();
+        
+        for(auto& cur_region : regions) {
+            cur_region->setMainBoneKey(root_bone->getKey());
+            cur_region->determineMainBone(root_bone);
+            rest_composition->addRegion(cur_region);
+        }
+        
+        rest_composition->initBoneMap();
+        rest_composition->initRegionsMap();
+        
+        // builds the shared fast weight tables once for all instances
+        for(auto& cur_region : regions) {
+            cur_region->initFastNormalWeightMap(rest_composition->getBonesMap());
+        }
+        
+        rest_composition->resetToWorldRestPts();
+    }
+    
+    // Creature class
+    Creature::Creature(CreatureLoadDataPacket& load_data)
+    : creature_template(new CreatureTemplate(load_data))
+    {
+		anchor_points_active = false;
+        InitFromTemplate();
+    }
+    
+    Creature::Creature(TSharedPtr<CreatureTemplate> template_in)
+    : creature_template(template_in)
+    {
+		anchor_points_active = false;
+        InitFromTemplate();
+    }
+    
+    Creature::~Creature()
+    {
+        delete [] global_uvs;
+        delete [] render_colours;
+        delete render_composition;
+        delete [] render_pts;
+
+		global_uvs = nullptr;
+		render_composition = nullptr;
+		render_pts = nullptr;
+    }
+    
+    void
+    Creature::InitFromTemplate()
+    {
+        int32 total_num_pts = creature_template->GetTotalNumPoints();
+        global_uvs = new glm::float32[total_num_pts * 2];
+        FMemory::Memcpy(global_uvs, creature_template->GetGlobalUvs(), sizeof(glm::float32) * total_num_pts * 2);
+        
+        render_colours = new glm::uint8[total_num_pts * 4];
+        render_pts = new glm::float32[total_num_pts * 3];
+        FillRenderColours(255, 255, 255, 255);
+        
+        // clone the rest skeleton, regions keep sharing the template's
+        // indices, rest points and skinning weights
+        meshRenderBoneComposition * rest_composition = creature_template->GetRestComposition();
+        meshBone * root_bone = rest_composition->getRootBone()->cloneHierarchy();
+        
+        render_composition = new meshRenderBoneComposition();
+        render_composition->setRootBone(root_bone);
+        
+        for(auto& rest_region : rest_composition->getRegions()) {
+            meshRenderRegion * cur_region = rest_region->cloneForInstance(global_uvs);
+            cur_region->determineMainBone(root_bone);
+            render_composition->addRegion(cur_region);
+        }
+        
+        render_composition->initBoneMap();
+        render_composition->initRegionsMap();
+        
+        for(auto& cur_region : render_composition->getRegions()) {
+            cur_region->initFastNormalWeightMap(render_composition->getBonesMap());
+        }
+        
+        render_composition->resetToWorldRestPts();
+    }
+    
+    TSharedPtr<CreatureTemplate>
+    Creature::GetTemplate() const
+    {
+        return creature_template;
+    }
+    
+    glm::uint32 *
+    Creature::GetGlobalIndices()
+    {
+        return creature_template->GetGlobalIndices();
+    }
+    
+    glm::float32 *
+    Creature::GetGlobalPts()
+    {
+        return creature_template->GetGlobalPts();
+    }
+    
+    glm::float32 *
+    Creature::GetGlobalUvs()
+    {
+        return global_uvs;
+    }
+    
+    glm::float32 *
+    Creature::GetRenderPts()
+    {
+        return render_pts;
+    }
+    
+    glm::uint8 *
+    Creature::GetRenderColours()
+    {
+        return render_colours;
+    }
+    
+    int32
+    Creature::GetTotalNumPoints() const
+    {
+        return creature_template->GetTotalNumPoints();
+    }
+    
+    int32
+    Creature::GetTotalNumIndices() const
+    {
+        return creature_template->GetTotalNumIndices();
+    }
+    
+    meshRenderBoneComposition *
+    Creature::GetRenderComposition()
+    {
+        return render_composition;
+    }
+    
+    void
+    Creature::FillRenderColours(glm::uint8 r, glm::uint8 g, glm::uint8 b, glm::uint8 a)
+    {
+        int32 total_num_pts = creature_template->GetTotalNumPoints();
+        for(auto i = 0; i < total_num_pts; i++)
+        {
+            glm::uint8 * cur_colour = render_colours + (i * 4);
+            cur_colour[0] = r;
+            cur_colour[1] = g;
+            cur_colour[2] = b;
+            cur_colour[3] = a;
+        }
+    }
+
+    const TArray<FName>& 
+    Creature::GetAnimationNames() const
+    {
+        return creature_template->GetAnimationNames();
+    }
+
+	const TMap<FName, TArray<CreatureUVSwapPacket> >& 
+	Creature::GetUvSwapPackets() const
+	{
+		return creature_template->GetUvSwapPackets();
+	}
+
+	void 
+	Creature::SetActiveItemSwap(const FName& region_name, int32 swap_idx)
+	{
+		active_uv_swap_actions.Add(region_name, swap_idx);
+	}
+
+	void 
+	Creature::RemoveActiveItemSwap(const FName& region_name)
+	{
+		active_uv_swap_actions.Remove(region_name);
+	}
+
+	TMap<FName, int32>&
+	Creature::GetActiveItemSwaps()
+	{
+		return active_uv_swap_actions;
+	}
+
+	void Creature::SetAnchorPointsActive(bool flag_in)
+	{
+		anchor_points_active = flag_in;
+	}
+
+	bool Creature::GetAnchorPointsActive() const
+	{
+		return anchor_points_active;
+	}
+
+	glm::vec2 Creature::GetAnchorPoint(const FName & anim_clip_name_in) const
+	{
+		const TMap<FName, glm::vec2>& anchor_point_map = creature_template->GetAnchorPoints();
+		if (anchor_point_map.Contains(anim_clip_name_in))
+		{
+			return anchor_point_map[anim_clip_name_in];
+		}
+
+		return glm::vec2(0, 0);
+	}
+
+    // CreatureAnimation class
+    CreatureAnimation::CreatureAnimation(CreatureLoadDataPacket& load_data,
+                                         const FName& name_in)
+    : name(name_in)
+    {
+            LoadFromData(name_in, load_data);
+    }
+    
+    CreatureAnimation::~CreatureAnimation()
+    {
+    }
+    
+    float CreatureAnimation::getStartTime() const
+    {
+        return start_time;
+    }
+    
+    float CreatureAnimation::getEndTime() const
+    {
+        return end_time;
+    }
+
+	void CreatureAnimation::setStartTime(int32 value_in)
+	{
+		start_time = (float)value_in;
+	}
+
+	void CreatureAnimation::setEndTime(int32 value_in)
+	{
+		end_time = (float)value_in;
+	}
+    
+    meshBoneCacheManager&
+    CreatureAnimation::getBonesCache()
+    {
+        return bones_cache;
+    }
+    
+    meshDisplacementCacheManager&
+    CreatureAnimation::getDisplacementCache()
+    {
+        return displacement_cache;
+    }
+    
+    meshUVWarpCacheManager&
+    CreatureAnimation::getUVWarpCache()
+    {
+        return uv_warp_cache;
+    }
+
+	meshOpacityCacheManager& 
+	CreatureAnimation::getOpacityCache()
+	{
+		return opacity_cache;
+	}
+    
+    const FName&
+    CreatureAnimation::getName() const
+    {
+        return name;
+    }
+
+    void
+    CreatureAnimation::LoadFromData(const FName& name_in,
+                                    CreatureLoadDataPacket& load_data)
+    {
+        if(load_data.IsBinary())
+        {
+            LoadFromBinaryData(name_in, load_data);
+            return;
+        }
+        
+        if(!load_data.HasJsonData())
+        {
+            std::cerr<<"CreatureAnimation::LoadFromData() - Json data for "<<TCHAR_TO_UTF8(*name_in.ToString())<<" was already released!"<<std::endl;
+            start_time = end_time = 0;
+            bones_cache.init(0, 0);
+            displacement_cache.init(0, 0);
+            uv_warp_cache.init(0, 0);
+            opacity_cache.init(0, 0);
+            return;
+        }
+        
+        JsonNode * json_root = load_data.base_node.toNode();
+        JsonNode * json_anim_base = GetJSONLevelNodeFromKey(*json_root, "animation");
+        JsonNode * json_clip = GetJSONNodeFromKey(*json_anim_base, name_in);
+        
+        std::pair<int32, int32> start_end_times = GetStartEndTimes(*json_clip, "bones");
+        start_time = (float)start_end_times.first;
+        end_time = (float)start_end_times.second;
+        
+        // bone animation
+        FillBoneCache(*json_clip,
+                      "bones",
+                      (int32)start_time,
+					  (int32)end_time,
+                      bones_cache);
+        
+        // mesh deformation animation
+        FillDeformationCache(*json_clip,
+                             "meshes",
+							 (int32)start_time,
+							 (int32)end_time,
+                             displacement_cache);
+        
+        if(meshDisplacementCacheManager::getDefaultQuantizeBits() > 0)
+        {
+            displacement_cache.quantize(meshDisplacementCacheManager::getDefaultQuantizeBits());
+        }
+        
+        // uv swapping animation
+        FillUVSwapCache(*json_clip,
+                        "uv_swaps",
+						(int32)start_time,
+						(int32)end_time,
+                        uv_warp_cache);
+
+		// opacity animation
+		FillOpacityCache(*json_clip,
+			"mesh_opacities",
+			(int32)start_time,
+			(int32)end_time,
+			opacity_cache);
+    }
+    
+    void
+    CreatureAnimation::LoadFromBinaryData(const FName& name_in,
+                                          CreatureLoadDataPacket& load_data)
+    {
+        int32 creature_offset = 0, clips_offset = 0, names_offset = 0;
+        CreatureBinaryReader reader = MakeBinaryReader(load_data, 0);
+        ReadBinaryHeader(reader, creature_offset, clips_offset, names_offset);
+        
+        // Find the clip in the clip table
+        int32 clip_offset = -1;
+        reader.seek(clips_offset);
+        int32 num_clips = reader.readCount(2 * sizeof(int32));
+        for(int32 i = 0; i < num_clips; i++)
+        {
+            FName cur_name = reader.readName();
+            int32 cur_offset = reader.readInt();
+            if(cur_name == name_in)
+            {
+                clip_offset = cur_offset;
+                break;
+            }
+        }
+        
+        start_time = end_time = 0;
+        if(clip_offset < 0)
+        {
+            std::cerr<<"CreatureAnimation::LoadFromBinaryData() - Animation "<<TCHAR_TO_UTF8(*name_in.ToString())<<" not found!"<<std::endl;
+            bones_cache.init(0, 0);
+            displacement_cache.init(0, 0);
+            uv_warp_cache.init(0, 0);
+            opacity_cache.init(0, 0);
+            return;
+        }
+        
+        reader.seek(clip_offset);
+        start_time = (float)reader.readInt();
+        end_time = (float)reader.readInt();
+        
+        int32 num_frames = (int32)end_time - (int32)start_time + 1;
+        int32 cache_layout = CREATURE_BINARY_TABLE_LAYOUT;
+        bool is_ready = false;
+        bool is_valid = reader.isValid() && (end_time >= start_time);
+        
+        // Flat caches are read in place, keep the data they point into alive
+        binary_storage = load_data.binary_storage;
+        
+        // Sparse clips only store their keyframes
+        TArray<int32> key_times;
+        int32 num_stored_frames = num_frames;
+        
+        // bone animation
+        is_valid = is_valid && ReadBinaryKeyframes(reader, (int32)start_time, (int32)end_time, key_times, num_stored_frames);
+        is_valid = is_valid && ReadBinaryCacheHeader(reader, num_stored_frames, cache_layout, is_ready);
+        if(is_valid && (cache_layout == CREATURE_BINARY_FLAT_LAYOUT))
+        {
+            meshCacheFlatView flat_view;
+            ReadBinaryFlatKeys(reader, flat_view);
+            SetBinaryFlatStride(flat_view, 4);
+            is_valid = ReadBinaryFlatData(reader, num_stored_frames, flat_view);
+            bones_cache.initFlatView((int32)start_time, (int32)end_time, flat_view);
+            bones_cache.initKeyframes(key_times);
+        }
+        else
+        {
+            // bones are only ever cooked flat
+            is_valid = false;
+        }
+        
+        // mesh deformation animation
+        is_valid = is_valid && ReadBinaryKeyframes(reader, (int32)start_time, (int32)end_time, key_times, num_stored_frames);
+        is_valid = is_valid && ReadBinaryCacheHeader(reader, num_stored_frames, cache_layout, is_ready, true);
+        if(is_valid && (cache_layout == CREATURE_BINARY_QUANTIZED_LAYOUT))
+        {
+            meshQuantizedDisplacementView quantized_view;
+            ReadBinaryFlatKeys(reader, quantized_view.ranges);
+            for(int32 i = 0; i < quantized_view.ranges.keys.Num(); i++)
+            {
+                quantized_view.local_counts.Add(reader.readCount(2));
+                quantized_view.post_counts.Add(reader.readCount(2));
+            }
+            
+            quantized_view.value_bits = reader.readInt();
+            is_valid = reader.isValid() && ((quantized_view.value_bits == 16) || (quantized_view.value_bits == 8));
+            if(is_valid)
+            {
+                quantized_view.initLayout();
+                is_valid = ReadBinaryFlatData(reader, num_stored_frames, quantized_view.ranges);
+                quantized_view.values = reader.viewUint8s((int64)num_stored_frames * quantized_view.frame_bytes);
+                is_valid = is_valid && reader.isValid();
+            }
+            
+            displacement_cache.initQuantizedView((int32)start_time, (int32)end_time,
+                                                 is_valid ? quantized_view : meshQuantizedDisplacementView());
+            displacement_cache.initKeyframes(key_times);
+        }
+        else if(is_valid && (cache_layout == CREATURE_BINARY_FLAT_LAYOUT))
+        {
+            meshCacheFlatView flat_view;
+            ReadBinaryFlatKeys(reader, flat_view);
+            
+            TArray<int32> local_counts, post_counts;
+            flat_view.key_offsets.SetNumUninitialized(flat_view.keys.Num());
+            flat_view.frame_stride = 0;
+            for(int32 i = 0; i < flat_view.keys.Num(); i++)
+            {
+                local_counts.Add(reader.readCount(2 * sizeof(float)));
+                post_counts.Add(reader.readCount(2 * sizeof(float)));
+                flat_view.key_offsets[i] = flat_view.frame_stride;
+                flat_view.frame_stride += (local_counts[i] + post_counts[i]) * 2;
+            }
+            
+            is_valid = ReadBinaryFlatData(reader, num_stored_frames, flat_view);
+            displacement_cache.initFlatView((int32)start_time, (int32)end_time, flat_view, local_counts, post_counts);
+            displacement_cache.initKeyframes(key_times);
+        }
+        else
+        {
+            displacement_cache.init((int32)start_time, (int32)end_time);
+            displacement_cache.initKeyframes(key_times);
+            for(auto& cur_list : displacement_cache.getCacheTable())
+            {
+                if(!is_valid)
+                {
+                    break;
+                }
+                
+                int32 num_meshes = reader.readCount(3 * sizeof(int32));
+                cur_list.Reserve(num_meshes);
+                for(int32 i = 0; i < num_meshes; i++)
+                {
+                    meshDisplacementCache cache_data(reader.readName());
+                    TArray<glm::vec2> read_pts;
+                    
+                    ReadBinaryDisplacements(reader, read_pts);
+                    cache_data.setLocalDisplacements(read_pts);
+                    
+                    ReadBinaryDisplacements(reader, read_pts);
+                    cache_data.setPostDisplacements(read_pts);
+                    
+                    cur_list.Add(cache_data);
+                }
+            }
+            
+            if(is_ready)
+            {
+                displacement_cache.makeAllReady();
+            }
+        }
+        
+        // uv swapping animation
+        is_valid = is_valid && ReadBinaryCacheHeader(reader, num_frames, cache_layout, is_ready);
+        if(is_valid && (cache_layout == CREATURE_BINARY_FLAT_LAYOUT))
+        {
+            meshCacheFlatView flat_view;
+            ReadBinaryFlatKeys(reader, flat_view);
+            SetBinaryFlatStride(flat_view, 8);
+            is_valid = ReadBinaryFlatData(reader, num_frames, flat_view);
+            uv_warp_cache.initFlatView((int32)start_time, (int32)end_time, flat_view);
+        }
+        else
+        {
+            uv_warp_cache.init((int32)start_time, (int32)end_time);
+            for(auto& cur_list : uv_warp_cache.getCacheTable())
+            {
+                if(!is_valid)
+                {
+                    break;
+                }
+                
+                int32 num_uvs = reader.readCount(9 * sizeof(int32));
+                cur_list.Reserve(num_uvs);
+                for(int32 i = 0; i < num_uvs; i++)
+                {
+                    meshUVWarpCache cache_data(reader.readName());
+                    cache_data.setEnabled(reader.readInt() != 0);
+                    cache_data.setLevel(reader.readInt());
+                    cache_data.setUvWarpLocalOffset(reader.readVec2());
+                    cache_data.setUvWarpGlobalOffset(reader.readVec2());
+                    cache_data.setUvWarpScale(reader.readVec2());
+                    cur_list.Add(cache_data);
+                }
+            }
+            
+            if(is_ready)
+            {
+                uv_warp_cache.makeAllReady();
+            }
+        }
+        
+        // opacity animation
+        is_valid = is_valid && ReadBinaryCacheHeader(reader, num_frames, cache_layout, is_ready);
+        if(is_valid && (cache_layout == CREATURE_BINARY_FLAT_LAYOUT))
+        {
+            meshCacheFlatView flat_view;
+            ReadBinaryFlatKeys(reader, flat_view);
+            SetBinaryFlatStride(flat_view, 4);
+            is_valid = ReadBinaryFlatData(reader, num_frames, flat_view);
+            opacity_cache.initFlatView((int32)start_time, (int32)end_time, flat_view);
+        }
+        else
+        {
+            opacity_cache.init((int32)start_time, (int32)end_time);
+            for(auto& cur_list : opacity_cache.getCacheTable())
+            {
+                if(!is_valid)
+                {
+                    break;
+                }
+                
+                int32 num_opacities = reader.readCount(5 * sizeof(int32));
+                cur_list.Reserve(num_opacities);
+                for(int32 i = 0; i < num_opacities; i++)
+                {
+                    meshOpacityCache cache_data(reader.readName());
+                    cache_data.setOpacity(reader.readFloat());
+                    cache_data.setRed(reader.readFloat());
+                    cache_data.setGreen(reader.readFloat());
+                    cache_data.setBlue(reader.readFloat());
+                    cur_list.Add(cache_data);
+                }
+            }
+            
+            if(is_ready)
+            {
+                opacity_cache.makeAllReady();
+            }
+        }
+        
+        if(!is_valid || !reader.isValid())
+        {
+            std::cerr<<"CreatureAnimation::LoadFromBinaryData() - Animation "<<TCHAR_TO_UTF8(*name_in.ToString())<<" is corrupt!"<<std::endl;
+        }
+    }
+    
+    bool
+    CreatureAnimation::hasCachePts() const
+    {
+        return point_cache.IsValid() && (point_cache->getNumFrames() > 0);
+    }
+    
+    const TSharedPtr<CreaturePointCache>&
+    CreatureAnimation::getPointCache() const
+    {
+        return point_cache;
+    }
+    
+    void
+    CreatureAnimation::setPointCache(TSharedPtr<CreaturePointCache> cache_in)
+    {
+        point_cache = cache_in;
+    }
+
+	void 
+	CreatureAnimation::clearCachePts()
+	{
+		point_cache.Reset();
+	}
+    
+    void
+    CreatureAnimation::poseFromCachePts(float time_in, glm::float32 * target_pts, int32 num_pts)
+    {
+        if(hasCachePts() && (point_cache->getNumPts() == num_pts))
+        {
+            point_cache->poseAtTime(time_in, target_pts);
+        }
+    }
+    
+    // CreaturePointCache class
+    CreaturePointCache::CreaturePointCache(int32 num_pts_in, int32 start_time_in, int32 reserve_frames_in)
+    : num_pts(num_pts_in), start_time(start_time_in), num_frames(0), num_missing_frames(0),
+        bounds_min(0, 0), bounds_step(0, 0)
+    {
+        frame_pts.Reserve(num_pts * 2 * reserve_frames_in);
+    }
+    
+    void
+    CreaturePointCache::addFrame(const glm::float32 * pts_in)
+    {
+        check(!isQuantized());
+        int32 write_index = frame_pts.Num();
+        frame_pts.AddUninitialized(num_pts * 2);
+        glm::float32 * write_pts = frame_pts.GetData() + write_index;
+        for(int32 i = 0; i < num_pts; i++)
+        {
+            write_pts[i * 2] = pts_in[i * 3];
+            write_pts[i * 2 + 1] = pts_in[i * 3 + 1];
+        }
+        
+        num_frames++;
+    }
+    
+    void
+    CreaturePointCache::initFrames(int32 num_frames_in)
+    {
+        num_frames = num_frames_in;
+        num_missing_frames = num_frames_in;
+        frame_pts.SetNumZeroed(num_pts * 2 * num_frames_in);
+        frames_ready.SetNumZeroed(num_frames_in);
+    }
+    
+    void
+    CreaturePointCache::setFrame(int32 frame_in, const glm::float32 * pts_in)
+    {
+        check(!isQuantized());
+        glm::float32 * write_pts = frame_pts.GetData() + (frame_in * num_pts * 2);
+        for(int32 i = 0; i < num_pts; i++)
+        {
+            write_pts[i * 2] = pts_in[i * 3];
+            write_pts[i * 2 + 1] = pts_in[i * 3 + 1];
+        }
+        
+        if((frames_ready.Num() > 0) && (frames_ready[frame_in] == 0))
+        {
+            frames_ready[frame_in] = 1;
+            num_missing_frames--;
+        }
+    }
+    
+    bool
+    CreaturePointCache::hasFrame(int32 frame_in) const
+    {
+        return (frames_ready.Num() == 0) ? (frame_in < num_frames) : (frames_ready[frame_in] != 0);
+    }
+    
+    bool
+    CreaturePointCache::isComplete() const
+    {
+        return num_missing_frames == 0;
+    }
+    
+    void
+    CreaturePointCache::getFramesAtTime(float time_in, int32& floor_frame_out, int32& ceil_frame_out) const
+    {
+        floor_frame_out = getIndexByTime((int32)floorf(time_in));
+        ceil_frame_out = getIndexByTime((int32)ceilf(time_in));
+    }
+    
+    int32
+    CreaturePointCache::getStartTime() const
+    {
+        return start_time;
+    }
+    
+    void
+    CreaturePointCache::quantize()
+    {
+        if(isQuantized() || (frame_pts.Num() == 0) || !isComplete())
+        {
+            return;
+        }
+        
+        glm::vec2 bounds_max(frame_pts[0], frame_pts[1]);
+        bounds_min = bounds_max;
+        for(int32 i = 0; i < frame_pts.Num(); i += 2)
+        {
+            bounds_min = glm::min(bounds_min, glm::vec2(frame_pts[i], frame_pts[i + 1]));
+            bounds_max = glm::max(bounds_max, glm::vec2(frame_pts[i], frame_pts[i + 1]));
+        }
+        
+        bounds_step = (bounds_max - bounds_min) / 65535.0f;
+        glm::vec2 inv_step(
+            (bounds_step.x > 0) ? (1.0f / bounds_step.x) : 0.0f,
+            (bounds_step.y > 0) ? (1.0f / bounds_step.y) : 0.0f);
+        
+        quantized_pts.SetNumUninitialized(frame_pts.Num());
+        for(int32 i = 0; i < frame_pts.Num(); i += 2)
+        {
+            quantized_pts[i] = (uint16)((frame_pts[i] - bounds_min.x) * inv_step.x + 0.5f);
+            quantized_pts[i + 1] = (uint16)((frame_pts[i + 1] - bounds_min.y) * inv_step.y + 0.5f);
+        }
+        
+        frame_pts.Empty();
+        frames_ready.Empty();
+    }
+    
+    bool
+    CreaturePointCache::isQuantized() const
+    {
+        return quantized_pts.Num() > 0;
+    }
+    
+    int32
+    CreaturePointCache::getNumFrames() const
+    {
+        return num_frames;
+    }
+    
+    int32
+    CreaturePointCache::getNumPts() const
+    {
+        return num_pts;
+    }
+    
+    int32
+    CreaturePointCache::getIndexByTime(int32 time_in) const
+    {
+        return clipNum(time_in - start_time, 0, num_frames - 1);
+    }
+    
+    void
+    CreaturePointCache::poseAtTime(float time_in, glm::float32 * target_pts) const
+    {
+        if(num_frames == 0)
+        {
+            return;
+        }
+        
+        const int32 floor_offset = getIndexByTime((int32)floorf(time_in)) * num_pts * 2;
+        const int32 ceil_offset = getIndexByTime((int32)ceilf(time_in)) * num_pts * 2;
+        const float cur_ratio = (time_in - (float)floorf(time_in));
+        const int32 chunk_pts = meshPoseScheduler::getChunkPts();
+        const int32 num_chunks = FMath::DivideAndRoundUp(num_pts, chunk_pts);
+        
+#ifdef CREATURE_MULTICORE
+		ParallelFor(num_chunks, [&](int32 chunk_index) {
+#else
+		for (int32 chunk_index = 0; chunk_index < num_chunks; chunk_index++) {
+#endif
+			const int32 end_pt = FMath::Min(num_pts, (chunk_index + 1) * chunk_pts);
+			if (isQuantized())
+			{
+				const uint16 * floor_pts = quantized_pts.GetData() + floor_offset;
+				const uint16 * ceil_pts = quantized_pts.GetData() + ceil_offset;
+				for (int32 i = chunk_index * chunk_pts; i < end_pt; i++)
+				{
+					glm::float32 * set_pt = target_pts + (i * 3);
+					float read_x = ((1.0f - cur_ratio) * (float)floor_pts[i * 2]) + (cur_ratio * (float)ceil_pts[i * 2]);
+					float read_y = ((1.0f - cur_ratio) * (float)floor_pts[i * 2 + 1]) + (cur_ratio * (float)ceil_pts[i * 2 + 1]);
+					set_pt[0] = bounds_min.x + (read_x * bounds_step.x);
+					set_pt[1] = bounds_min.y + (read_y * bounds_step.y);
+					set_pt[2] = 0;
+				}
+			}
+			else
+			{
+				const glm::float32 * floor_pts = frame_pts.GetData() + floor_offset;
+				const glm::float32 * ceil_pts = frame_pts.GetData() + ceil_offset;
+				for (int32 i = chunk_index * chunk_pts; i < end_pt; i++)
+				{
+					glm::float32 * set_pt = target_pts + (i * 3);
+					set_pt[0] = ((1.0f - cur_ratio) * floor_pts[i * 2]) + (cur_ratio * ceil_pts[i * 2]);
+					set_pt[1] = ((1.0f - cur_ratio) * floor_pts[i * 2 + 1]) + (cur_ratio * ceil_pts[i * 2 + 1]);
+					set_pt[2] = 0;
+				}
+			}
+#ifdef CREATURE_MULTICORE
+		}, num_pts < meshPoseScheduler::getMinParallelPts());
+#else
+		}
+#endif
+    }
+    
+    void
+    CreaturePointCache::getFramePts(int32 frame_in, glm::float32 * target_pts) const
+    {
+        poseAtTime((float)(start_time + frame_in), target_pts);
+    }
+    
+    int64
+    CreaturePointCache::getAllocatedSize() const
+    {
+        return (int64)sizeof(CreaturePointCache)
+            + (int64)frame_pts.GetAllocatedSize()
+            + (int64)frames_ready.GetAllocatedSize()
+            + (int64)quantized_pts.GetAllocatedSize();
+    }
+    
+    int64
+    CreatureAnimation::getAllocatedSize() const
+    {
+        return (int64)sizeof(CreatureAnimation)
+            + bones_cache.getAllocatedSize()
+            + displacement_cache.getAllocatedSize()
+            + uv_warp_cache.getAllocatedSize()
+            + opacity_cache.getAllocatedSize();
+    }
+    
+    // CreatureAnimationLibrary class
+    CreatureAnimationLibrary::CreatureAnimationLibrary(TSharedPtr<CreatureLoadDataPacket> load_data_in,
+                                                       const TArray<FName>& animation_names_in)
+    : load_data(load_data_in), animation_names(animation_names_in),
+        memory_budget(0), resident_bytes(0), use_counter(0)
+    {
+    }
+    
+    CreatureAnimationLibrary::~CreatureAnimationLibrary()
+    {
+        // workers read from load_data, so let them finish first
+        FlushPrefetches();
+    }
+    
+    const TArray<FName>&
+    CreatureAnimationLibrary::GetAnimationNames() const
+    {
+        return animation_names;
+    }
+    
+    bool
+    CreatureAnimationLibrary::HasAnimation(const FName& name_in) const
+    {
+        return animation_names.Contains(name_in);
+    }
+    
+    bool
+    CreatureAnimationLibrary::IsAnimationResident(const FName& name_in) const
+    {
+        return resident_clips.Contains(name_in);
+    }
+    
+    TSharedPtr<CreatureAnimation>
+    CreatureAnimationLibrary::GetAnimation(const FName& name_in)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_CreatureAnimationLibrary_GetAnimation);
         
-        for(auto& cur_region : regions) {
-            cur_region->setMainBoneKey(root_bone->getKey());
-            cur_region->determineMainBone(root_bone);
-            render_composition->addRegion(cur_region);
+        residentClip * cur_clip = resident_clips.Find(name_in);
+        if(cur_clip == nullptr)
+        {
+            if(!HasAnimation(name_in))
+            {
+                std::cerr<<"CreatureAnimationLibrary::GetAnimation() - Animation "<<TCHAR_TO_UTF8(*name_in.ToString())<<" not found!"<<std::endl;
+                return TSharedPtr<CreatureAnimation>();
+            }
+            
+            CreatureAnimation * new_animation = nullptr;
+            TFuture<CreatureAnimation *> * cur_pending = pending_clips.Find(name_in);
+            if(cur_pending)
+            {
+                // already decoding on a worker
+                new_animation = cur_pending->Get();
+                pending_clips.Remove(name_in);
+            }
+            else {
+                new_animation = new CreatureAnimation(*load_data, name_in);
+            }
+            
+            cur_clip = &AddResidentClip(name_in, new_animation);
         }
         
-        render_composition->initBoneMap();
-        render_composition->initRegionsMap();
+        cur_clip->last_used = ++use_counter;
+        TSharedPtr<CreatureAnimation> retval = cur_clip->animation;
+        Trim();
         
-        for(auto& cur_region : regions) {
-            cur_region->initFastNormalWeightMap(render_composition->getBonesMap());
+        return retval;
+    }
+    
+    void
+    CreatureAnimationLibrary::Prefetch(const FName& name_in)
+    {
+        if(resident_clips.Contains(name_in)
+           || pending_clips.Contains(name_in)
+           || !HasAnimation(name_in))
+        {
+            return;
         }
         
-        render_composition->resetToWorldRestPts();
-
-        // Fill up available animation names
-        JsonNode * json_anim_base = GetJSONLevelNodeFromKey(*json_root, "animation");
-        animation_names = GetJSONKeysFromNode(*json_anim_base);
-
-		// Fill up uv swap packets
-		
-		JsonNode * json_uv_swap_base = GetJSONLevelNodeFromKey(*json_root, "uv_swap_items");
-		if (json_uv_swap_base)
-		{
-			uv_swap_packets = FillSwapUVPacketMap(*json_uv_swap_base);
-		}
-
-		// Load Anchor Points
-		JsonNode * anchor_point_base = GetJSONLevelNodeFromKey(*json_root, "anchor_points_items");
-		if (anchor_point_base)
-		{
-			anchor_point_map = FillAnchorPointMap(*anchor_point_base);
-		}
+        // the shared pointer is made on the game thread, workers only decode
+        CreatureLoadDataPacket * cur_load_data = load_data.Get();
+        pending_clips.Add(name_in, Async(EAsyncExecution::ThreadPool, [cur_load_data, name_in]() {
+            return new CreatureAnimation(*cur_load_data, name_in);
+        }));
     }
-
     
-    // CreatureAnimation class
-    CreatureAnimation::CreatureAnimation(CreatureLoadDataPacket& load_data,
-                                         const FName& name_in)
-    : name(name_in)
+    void
+    CreatureAnimationLibrary::FlushPrefetches()
     {
-            LoadFromData(name_in, load_data);
+        for(auto& cur_pending : pending_clips)
+        {
+            cur_pending.Value.Wait();
+        }
+        
+        CollectPrefetches();
     }
     
-    CreatureAnimation::~CreatureAnimation()
+    void
+    CreatureAnimationLibrary::SetMemoryBudget(int64 bytes_in)
+    {
+        memory_budget = bytes_in;
+        Trim();
+    }
+    
+    int64
+    CreatureAnimationLibrary::GetMemoryBudget() const
+    {
+        return memory_budget;
+    }
+    
+    int64
+    CreatureAnimationLibrary::GetResidentBytes() const
+    {
+        return resident_bytes;
+    }
+    
+    int32
+    CreatureAnimationLibrary::GetNumResidentAnimations() const
+    {
+        return resident_clips.Num();
+    }
+    
+    bool
+    CreatureAnimationLibrary::IsOverBudget() const
+    {
+        return (memory_budget > 0) && (resident_bytes > memory_budget);
+    }
+    
+    void
+    CreatureAnimationLibrary::Trim()
     {
-        if(cache_pts.Num() > 0)
+        CollectPrefetches();
+        
+        while(IsOverBudget())
         {
-            for(auto pt_pool : cache_pts)
+            // clips still referenced by a manager stay
+            residentClip * evict_clip = nullptr;
+            FName evict_name;
+            for(auto& cur_clip : resident_clips)
+            {
+                if(cur_clip.Value.animation.GetSharedReferenceCount() > 1)
+                {
+                    continue;
+                }
+                
+                if((evict_clip == nullptr) || (cur_clip.Value.last_used < evict_clip->last_used))
+                {
+                    evict_clip = &cur_clip.Value;
+                    evict_name = cur_clip.Key;
+                }
+            }
+            
+            if(evict_clip == nullptr)
             {
-                delete [] pt_pool;
+                break;
             }
+            
+            resident_bytes -= evict_clip->resident_bytes;
+            resident_clips.Remove(evict_name);
         }
     }
     
-    float CreatureAnimation::getStartTime() const
+    CreatureAnimationLibrary::residentClip&
+    CreatureAnimationLibrary::AddResidentClip(const FName& name_in, CreatureAnimation * animation_in)
     {
-        return start_time;
+        residentClip& new_clip = resident_clips.Add(name_in);
+        new_clip.animation = TSharedPtr<CreatureAnimation>(animation_in);
+        new_clip.resident_bytes = animation_in->getAllocatedSize();
+        new_clip.last_used = ++use_counter;
+        resident_bytes += new_clip.resident_bytes;
+        
+        return new_clip;
     }
     
-    float CreatureAnimation::getEndTime() const
+    void
+    CreatureAnimationLibrary::CollectPrefetches()
     {
-        return end_time;
+        TArray<FName> ready_names;
+        for(auto& cur_pending : pending_clips)
+        {
+            if(cur_pending.Value.IsReady())
+            {
+                ready_names.Add(cur_pending.Key);
+            }
+        }
+        
+        for(auto& cur_name : ready_names)
+        {
+            AddResidentClip(cur_name, pending_clips[cur_name].Get());
+            pending_clips.Remove(cur_name);
+        }
     }
-
-	void CreatureAnimation::setStartTime(int32 value_in)
-	{
-		start_time = (float)value_in;
-	}
-
-	void CreatureAnimation::setEndTime(int32 value_in)
-	{
-		end_time = (float)value_in;
-	}
     
-    meshBoneCacheManager&
-    CreatureAnimation::getBonesCache()
+    // CreatureAsyncLoader class
+    static CreatureAsyncLoadResult *
+    RunAsyncLoad(const FName& filename_in,
+                 const CreatureAsyncLoader::loadFunction& load_func,
+                 bool build_animations)
     {
-        return bones_cache;
+        CreatureAsyncLoadResult * ret_result = new CreatureAsyncLoadResult();
+        ret_result->filename = filename_in;
+        ret_result->load_data = TSharedPtr<CreatureLoadDataPacket>(new CreatureLoadDataPacket());
+        ret_result->success = load_func(*ret_result->load_data);
+        if(!ret_result->success)
+        {
+            std::cerr<<"CreatureAsyncLoader::Request() - Could not load "<<TCHAR_TO_UTF8(*filename_in.ToString())<<std::endl;
+            return ret_result;
+        }
+        
+        ret_result->creature_template = TSharedPtr<CreatureTemplate>(new CreatureTemplate(*ret_result->load_data));
+        if(build_animations)
+        {
+            for(auto& cur_name : ret_result->creature_template->GetAnimationNames())
+            {
+                ret_result->animations.Add(TSharedPtr<CreatureAnimation>(
+                    new CreatureAnimation(*ret_result->load_data, cur_name)));
+            }
+        }
+        
+        return ret_result;
     }
     
-    meshDisplacementCacheManager&
-    CreatureAnimation::getDisplacementCache()
+    CreatureAsyncLoader::CreatureAsyncLoader()
     {
-        return displacement_cache;
     }
     
-    meshUVWarpCacheManager&
-    CreatureAnimation::getUVWarpCache()
+    CreatureAsyncLoader::~CreatureAsyncLoader()
     {
-        return uv_warp_cache;
+        for(auto& cur_load : pending_loads)
+        {
+            delete cur_load.Value.result.Get();
+        }
     }
-
-	meshOpacityCacheManager& 
-	CreatureAnimation::getOpacityCache()
-	{
-		return opacity_cache;
-	}
     
-    const FName&
-    CreatureAnimation::getName() const
+    void
+    CreatureAsyncLoader::RequestFile(const FName& filename_in, bool build_animations, readyCallback callback_in)
     {
-        return name;
+        Request(filename_in, [filename_in](CreatureLoadDataPacket& load_data) {
+            // cooked binary files are memory mapped, everything else is regular JSON
+            if(IsCreatureBinaryFile(filename_in) && LoadCreatureBinaryData(filename_in, load_data))
+            {
+                return true;
+            }
+            
+            LoadCreatureJSONData(filename_in, load_data);
+            return load_data.base_node.getTag() == JSON_TAG_OBJECT;
+        }, build_animations, callback_in);
     }
-
+    
     void
-    CreatureAnimation::LoadFromData(const FName& name_in,
-                                    CreatureLoadDataPacket& load_data)
+    CreatureAsyncLoader::Request(const FName& filename_in,
+                                 loadFunction load_func,
+                                 bool build_animations,
+                                 readyCallback callback_in)
     {
-        JsonNode * json_root = load_data.base_node.toNode();
-        JsonNode * json_anim_base = GetJSONLevelNodeFromKey(*json_root, "animation");
-        JsonNode * json_clip = GetJSONNodeFromKey(*json_anim_base, name_in);
-        
-        std::pair<int32, int32> start_end_times = GetStartEndTimes(*json_clip, "bones");
-        start_time = (float)start_end_times.first;
-        end_time = (float)start_end_times.second;
-        
-        // bone animation
-        FillBoneCache(*json_clip,
-                      "bones",
-                      (int32)start_time,
-					  (int32)end_time,
-                      bones_cache);
-        
-        // mesh deformation animation
-        FillDeformationCache(*json_clip,
-                             "meshes",
-							 (int32)start_time,
-							 (int32)end_time,
-                             displacement_cache);
+        pendingLoad * cur_load = pending_loads.Find(filename_in);
+        if(cur_load == nullptr)
+        {
+            cur_load = &pending_loads.Add(filename_in);
+            cur_load->result = Async(EAsyncExecution::ThreadPool, [filename_in, load_func, build_animations]() {
+                return RunAsyncLoad(filename_in, load_func, build_animations);
+            });
+        }
         
-        // uv swapping animation
-        FillUVSwapCache(*json_clip,
-                        "uv_swaps",
-						(int32)start_time,
-						(int32)end_time,
-                        uv_warp_cache);
-
-		// opacity animation
-		FillOpacityCache(*json_clip,
-			"mesh_opacities",
-			(int32)start_time,
-			(int32)end_time,
-			opacity_cache);
+        cur_load->callbacks.Add(callback_in);
     }
     
     bool
-    CreatureAnimation::hasCachePts() const
+    CreatureAsyncLoader::IsLoading(const FName& filename_in) const
     {
-        return cache_pts.Num() > 0;
+        return pending_loads.Contains(filename_in);
     }
     
-    TArray<glm::float32 *>&
-    CreatureAnimation::getCachePts()
+    int32
+    CreatureAsyncLoader::GetNumLoading() const
     {
-        return cache_pts;
+        return pending_loads.Num();
     }
-
-	void 
-	CreatureAnimation::clearCachePts()
-	{
-		for (int32 i = 0; i < cache_pts.Num(); i++)
-		{
-			delete[] cache_pts[i];
-		}
-
-		cache_pts.Empty();
-	}
     
     int32
-    CreatureAnimation::getIndexByTime(int32 time_in) const
+    CreatureAsyncLoader::Update()
     {
-        int32 retval = time_in - (int32)start_time;
-        retval = clipNum(retval, 0, (int32)cache_pts.Num() - 1);
+        TArray<FName> ready_names;
+        for(auto& cur_load : pending_loads)
+        {
+            if(cur_load.Value.result.IsReady())
+            {
+                ready_names.Add(cur_load.Key);
+            }
+        }
         
-        return retval;
+        for(auto& cur_name : ready_names)
+        {
+            FinishLoad(cur_name);
+        }
+        
+        return ready_names.Num();
     }
     
     void
-    CreatureAnimation::poseFromCachePts(float time_in, glm::float32 * target_pts, int32 num_pts)
+    CreatureAsyncLoader::Flush()
+    {
+        // callbacks can request more loads
+        while(pending_loads.Num() > 0)
+        {
+            TArray<FName> all_names;
+            pending_loads.GetKeys(all_names);
+            for(auto& cur_name : all_names)
+            {
+                FinishLoad(cur_name);
+            }
+        }
+    }
+    
+    void
+    CreatureAsyncLoader::FinishLoad(const FName& filename_in)
     {
-        int32 cur_floor_time = getIndexByTime((int32)floorf(time_in));
-        int32 cur_ceil_time = getIndexByTime((int32)ceilf(time_in));
-        float cur_ratio = (time_in - (float)floorf(time_in));       
+        pendingLoad& cur_load = pending_loads[filename_in];
+        CreatureAsyncLoadResult * cur_result = cur_load.result.Get();
+        TArray<readyCallback> cur_callbacks = cur_load.callbacks;
         
-#ifdef CREATURE_MULTICORE
-		ParallelFor(num_pts, [&](int32 i) {
-#else
-		for (int32 i = 0; i < num_pts; i++) {
-#endif
-			glm::float32 * set_pt = target_pts + (i * 3);
-			glm::float32 * floor_pts = cache_pts[cur_floor_time] + (i * 3);
-			glm::float32 * ceil_pts = cache_pts[cur_ceil_time] + (i * 3);
-
-			set_pt[0] = ((1.0f - cur_ratio) * floor_pts[0]) + (cur_ratio * ceil_pts[0]);
-			set_pt[1] = ((1.0f - cur_ratio) * floor_pts[1]) + (cur_ratio * ceil_pts[1]);
-			set_pt[2] = ((1.0f - cur_ratio) * floor_pts[2]) + (cur_ratio * ceil_pts[2]);
-#ifdef CREATURE_MULTICORE
-		});
-#else
-		}
-#endif
+        // removed first so callbacks can request the file again
+        pending_loads.Remove(filename_in);
+        for(auto& cur_callback : cur_callbacks)
+        {
+            cur_callback(*cur_result);
+        }
         
+        delete cur_result;
     }
     
     // CreatureManager class
     CreatureManager::CreatureManager(TSharedPtr<CreatureModule::Creature> target_creature_in)
     : target_creature(target_creature_in), is_playing(false), run_time(0), time_scale(30.0),
-        do_blending(false),
+        do_blending(false), do_bone_blending(false),
         blending_factor(0), mirror_y(false), use_custom_time_range(false),
         custom_start_time(0), custom_end_time(0), should_loop(true),
-        do_auto_blending(false), auto_blend_delta(0.1f), do_point_caching(false)
+        do_auto_blending(false), auto_blend_delta(0.1f), do_point_caching(false),
+        blend_space_sync_phase(true), blend_space_phase(0)
     {
         for(int32 i = 0; i < 2; i++) {
             blend_render_pts[i] = NULL;
         }
     }
-    
-    CreatureManager::~CreatureManager()
+    
+    CreatureManager::~CreatureManager()
+    {
+        // finished caches still go to the shared animations
+        FlushPointCaches();
+        
+        for(int32 i = 0; i < 2; i++) {
+            if(blend_render_pts[i] != NULL) {
+                delete [] blend_render_pts[i];
+            }
+        }
+    }
+    
+    void
+    CreatureManager::AddAnimation(TSharedPtr<CreatureModule::CreatureAnimation> animation_in)
+    {
+        animations.Add(animation_in->getName(), animation_in);
+		active_blend_run_times.Add(animation_in->getName(), animation_in->getStartTime());
+        BindAnimation(animation_in.Get(), animation_bindings.FindOrAdd(animation_in->getName()));
+    }
+
+    static void
+    ResolveCacheKeys(const TArray<FName>& keys_in,
+                     const TMap<FName, int32>& index_map,
+                     TArray<int32>& out_indices)
+    {
+        out_indices.Reset(keys_in.Num());
+        for(auto& cur_key : keys_in)
+        {
+            const int32 * cur_index = index_map.Find(cur_key);
+            out_indices.Add(cur_index ? *cur_index : -1);
+        }
+    }
+
+    void
+    CreatureManager::BindAnimation(CreatureAnimation * animation_in, animationBinding& binding_out)
+    {
+        meshRenderBoneComposition * render_composition = target_creature->GetRenderComposition();
+        TArray<meshBone *>& bones_list = render_composition->getBonesList();
+        TArray<meshRenderRegion *>& regions_list = render_composition->getRegions();
+
+        TMap<FName, int32> bone_index_map, region_index_map;
+        for(int32 i = 0; i < bones_list.Num(); i++)
+        {
+            bone_index_map.Add(bones_list[i]->getKey(), i);
+        }
+
+        for(int32 i = 0; i < regions_list.Num(); i++)
+        {
+            region_index_map.Add(regions_list[i]->getName(), i);
+        }
+
+        TArray<FName> cache_keys;
+        animation_in->getBonesCache().getKeys(cache_keys);
+        ResolveCacheKeys(cache_keys, bone_index_map, binding_out.bone_indices);
+        animation_in->getDisplacementCache().getKeys(cache_keys);
+        ResolveCacheKeys(cache_keys, region_index_map, binding_out.displacement_indices);
+        animation_in->getUVWarpCache().getKeys(cache_keys);
+        ResolveCacheKeys(cache_keys, region_index_map, binding_out.uv_warp_indices);
+        animation_in->getOpacityCache().getKeys(cache_keys);
+        ResolveCacheKeys(cache_keys, region_index_map, binding_out.opacity_indices);
+
+        binding_out.animation = animation_in;
+    }
+
+    CreatureManager::animationBinding&
+    CreatureManager::GetAnimationBinding(const FName& animation_name_in)
     {
-        for(int32 i = 0; i < 2; i++) {
-            if(blend_render_pts[i] != NULL) {
-                delete [] blend_render_pts[i];
-            }
+        // animations can also be swapped in through GetAllAnimations()
+        CreatureAnimation * cur_animation = animations[animation_name_in].Get();
+        animationBinding& cur_binding = animation_bindings.FindOrAdd(animation_name_in);
+        if(cur_binding.animation != cur_animation)
+        {
+            BindAnimation(cur_animation, cur_binding);
         }
-    }
-    
-    void
-    CreatureManager::AddAnimation(TSharedPtr<CreatureModule::CreatureAnimation> animation_in)
-    {
-        animations.Add(animation_in->getName(), animation_in);
-		active_blend_run_times.Add(animation_in->getName(), animation_in->getStartTime());
+
+        return cur_binding;
     }
     
     void
@@ -1229,6 +3484,73 @@ namespace CreatureModule {
         return NULL;
     }
 
+    void
+    CreatureManager::SetAnimationLibrary(TSharedPtr<CreatureAnimationLibrary> library_in)
+    {
+        animation_library = library_in;
+    }
+    
+    CreatureAnimationLibrary *
+    CreatureManager::GetAnimationLibrary()
+    {
+        return animation_library.Get();
+    }
+    
+    bool
+    CreatureManager::RequestAnimation(const FName& name_in)
+    {
+        if(animations.Contains(name_in))
+        {
+            return true;
+        }
+        
+        if(!animation_library.IsValid() || !animation_library->HasAnimation(name_in))
+        {
+            return false;
+        }
+        
+        // under a budget only the clips in use are held on to, so the library can evict the rest
+        if(animation_library->GetMemoryBudget() > 0)
+        {
+            ReleaseInactiveAnimations();
+        }
+        
+        AddAnimation(animation_library->GetAnimation(name_in));
+        
+        return true;
+    }
+    
+    void
+    CreatureManager::ReleaseInactiveAnimations()
+    {
+        if(!animation_library.IsValid())
+        {
+            return;
+        }
+        
+        TArray<FName> release_names;
+        for(auto& cur_animation : animations)
+        {
+            const FName& cur_name = cur_animation.Key;
+            bool is_blending = (do_auto_blending && ((cur_name == auto_blend_names[0]) || (cur_name == auto_blend_names[1])))
+                || (do_blending && ((cur_name == active_blend_animation_names[0]) || (cur_name == active_blend_animation_names[1])));
+            if((cur_name != active_animation_name)
+               && !is_blending
+               && !IsBlendSpaceAnimation(cur_name)
+               && animation_library->HasAnimation(cur_name))
+            {
+                release_names.Add(cur_name);
+            }
+        }
+        
+        for(auto& cur_name : release_names)
+        {
+            animations.Remove(cur_name);
+            animation_bindings.Remove(cur_name);
+            active_blend_run_times.Remove(cur_name);
+        }
+    }
+
     CreatureModule::Creature *
     CreatureManager::GetCreature()
     {
@@ -1247,7 +3569,7 @@ namespace CreatureModule {
             }
         }
         
-        if(animations.Contains(name_in)) {
+        if(RequestAnimation(name_in)) {
             active_animation_name = name_in;
             auto& cur_animation = animations[active_animation_name];
             run_time = cur_animation->getStartTime();
@@ -1263,12 +3585,7 @@ namespace CreatureModule {
 			auto& cur_animation = animations[animation_name_in];
 
 			auto& displacement_cache_manager = cur_animation->getDisplacementCache();
-			TArray<meshDisplacementCache>& displacement_table =
-				displacement_cache_manager.getCacheTable()[0];
-
 			auto& uv_warp_cache_manager = cur_animation->getUVWarpCache();
-			TArray<meshUVWarpCache>& uv_swap_table =
-				uv_warp_cache_manager.getCacheTable()[0];
 
 			meshRenderBoneComposition * render_composition =
 				target_creature->GetRenderComposition();
@@ -1277,13 +3594,13 @@ namespace CreatureModule {
 			int32 index = 0;
 			for (auto& cur_region : all_regions) {
 				// Setup active or inactive displacements
-				bool use_local_displacements = (displacement_table[index].getLocalDisplacements().Num() > 0);
-				bool use_post_displacements = (displacement_table[index].getPostDisplacements().Num() > 0);
+				bool use_local_displacements = false, use_post_displacements = false;
+				displacement_cache_manager.getFirstFrameDisplacementUse(index, use_local_displacements, use_post_displacements);
 				cur_region->setUseLocalDisplacements(use_local_displacements);
 				cur_region->setUsePostDisplacements(use_post_displacements);
 
 				// Setup active or inactive uv swaps
-				cur_region->setUseUvWarp(uv_swap_table[index].getEnabled());
+				cur_region->setUseUvWarp(uv_warp_cache_manager.getFirstFrameEnabled(index));
 
 				index++;
 			}
@@ -1370,6 +3687,11 @@ namespace CreatureModule {
             return;
         }
 
+        if(!RequestAnimation(animation_name_in))
+        {
+            return;
+        }
+
 		ResetBlendTime(animation_name_in);
         
         auto_blend_delta = blend_delta;
@@ -1424,6 +3746,153 @@ namespace CreatureModule {
         blending_factor = value_in;
     }
 
+    void
+    CreatureManager::SetBoneBlending(bool flag_in)
+    {
+        do_bone_blending = flag_in;
+    }
+
+    bool
+    CreatureManager::GetBoneBlending() const
+    {
+        return do_bone_blending;
+    }
+
+    bool
+    CreatureManager::SetBlendSpace(const TArray<FName>& names_in, bool sync_phase_in)
+    {
+        // listed first so requesting the clips does not release the ones before
+        blend_space_inputs.Reset();
+        for(auto& cur_name : names_in)
+        {
+            blend_space_inputs.Add(blendInput(cur_name, 0, (blend_space_inputs.Num() == 0) ? 1.0f : 0.0f));
+        }
+
+        for(auto& cur_input : blend_space_inputs)
+        {
+            if(!RequestAnimation(cur_input.animation_name))
+            {
+                std::cerr<<"CreatureManager::SetBlendSpace() - Invalid animation name: "<<TCHAR_TO_UTF8(*cur_input.animation_name.ToString())<<std::endl;
+                ClearBlendSpace();
+                return false;
+            }
+        }
+
+        if(blend_space_inputs.Num() == 0)
+        {
+            return false;
+        }
+
+        for(auto& cur_input : blend_space_inputs)
+        {
+            cur_input.run_time = animations[cur_input.animation_name]->getStartTime();
+        }
+
+        blend_space_sync_phase = sync_phase_in;
+        blend_space_phase = 0;
+        SetActiveAnimationName(names_in[0]);
+
+        return true;
+    }
+
+    void
+    CreatureManager::SetBlendSpaceWeights(const TArray<float>& weights_in)
+    {
+        for(int32 i = 0; i < FMath::Min(weights_in.Num(), blend_space_inputs.Num()); i++)
+        {
+            blend_space_inputs[i].weight = weights_in[i];
+        }
+    }
+
+    void
+    CreatureManager::SetBlendSpaceWeight(const FName& name_in, float weight_in)
+    {
+        for(auto& cur_input : blend_space_inputs)
+        {
+            if(cur_input.animation_name == name_in)
+            {
+                cur_input.weight = weight_in;
+            }
+        }
+    }
+
+    void
+    CreatureManager::ClearBlendSpace()
+    {
+        blend_space_inputs.Reset();
+        blend_space_phase = 0;
+    }
+
+    bool
+    CreatureManager::IsBlendSpaceActive() const
+    {
+        return blend_space_inputs.Num() > 0;
+    }
+
+    bool
+    CreatureManager::IsBlendSpaceAnimation(const FName& name_in) const
+    {
+        for(auto& cur_input : blend_space_inputs)
+        {
+            if(cur_input.animation_name == name_in)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void
+    CreatureManager::increBlendSpaceRunTimes(float delta_in)
+    {
+        if(!blend_space_sync_phase)
+        {
+            for(auto& cur_input : blend_space_inputs)
+            {
+                if(animations.Contains(cur_input.animation_name))
+                {
+                    cur_input.run_time = correctRunTime(cur_input.run_time + delta_in, cur_input.animation_name);
+                }
+            }
+
+            return;
+        }
+
+        // the shared phase moves at the weighted average clip length
+        float total_weight = 0, blend_length = 0;
+        for(auto& cur_input : blend_space_inputs)
+        {
+            auto * cur_animation = animations.Find(cur_input.animation_name);
+            if((cur_input.weight > 0) && cur_animation)
+            {
+                total_weight += cur_input.weight;
+                blend_length += cur_input.weight * ((*cur_animation)->getEndTime() - (*cur_animation)->getStartTime());
+            }
+        }
+
+        if((total_weight <= 0) || (blend_length <= 0))
+        {
+            return;
+        }
+
+        blend_space_phase += delta_in * total_weight / blend_length;
+        if(blend_space_phase > 1.0f)
+        {
+            blend_space_phase = should_loop ? (blend_space_phase - floorf(blend_space_phase)) : 1.0f;
+        }
+
+        for(auto& cur_input : blend_space_inputs)
+        {
+            auto * cur_animation = animations.Find(cur_input.animation_name);
+            if(cur_animation)
+            {
+                const float start_time = (*cur_animation)->getStartTime();
+                cur_input.run_time = start_time + blend_space_phase * ((*cur_animation)->getEndTime() - start_time);
+            }
+        }
+    }
+
 	void 
 	CreatureManager::ClearPointCache(const FName& animation_name_in)
 	{
@@ -1440,87 +3909,240 @@ namespace CreatureModule {
 	}
     
     void
-	CreatureManager::MakePointCache(const FName& animation_name_in, int32 gap_step)
+	CreatureManager::MakePointCache(const FName& animation_name_in, int32 gap_step, bool quantize_in)
+    {
+		if (animations.Contains(animation_name_in) == false)
+		{
+			return;
+		}
+
+        auto cur_animation = animations[animation_name_in];
+        if(cur_animation->hasCachePts())
+        {
+            // cache already generated, just exit
+            return;
+        }
+        
+        cur_animation->setPointCache(TSharedPtr<CreaturePointCache>(BuildPointCache(animation_name_in, gap_step, quantize_in)));
+    }
+    
+    CreaturePointCache *
+    CreatureManager::BuildPointCache(const FName& animation_name_in, int32 gap_step, bool quantize_in)
+    {
+		if (gap_step < 1) {
+			gap_step = 1;
+		}
+
+        float store_run_time = getRunTime();
+        auto& cur_animation = animations[animation_name_in];
+		int32 array_size = target_creature->GetTotalNumPoints() * 3;
+		int32 start_frame = (int32)cur_animation->getStartTime();
+		auto new_cache = new CreaturePointCache(
+			target_creature->GetTotalNumPoints(), start_frame, (int32)cur_animation->getEndTime() - start_frame + 1);
+		TArray<glm::float32> prev_pts, new_pts, gap_pts;
+		new_pts.SetNumUninitialized(array_size);
+		gap_pts.SetNumUninitialized(array_size);
+
+        UpdateRegionSwitches(animation_name_in);
+
+        //for(int32 i = (int32)cur_animation->getStartTime(); i <= (int32)cur_animation->getEndTime(); i++)
+		int32 i = start_frame;
+		while (true)
+        {
+            run_time = (float)i;
+            PoseCreature(animation_name_in, new_pts.GetData(), getRunTime());
+            
+			int32 real_step = gap_step;
+			if (i + real_step > cur_animation->getEndTime())
+			{
+				real_step = (int32)cur_animation->getEndTime() - i;
+			}
+
+			bool firstCase = real_step > 1;
+			bool secondCase = (new_cache->getNumFrames() >= 1);
+			if (firstCase && secondCase)
+			{
+				// fill in the gaps
+				for (int32 j = 0; j < real_step; j++)
+				{
+					float factor = (float)j / (float)real_step;
+					for (int32 k = 0; k < array_size; k++)
+					{
+						gap_pts[k] = ((1.0f - factor) * prev_pts[k]) + (factor * new_pts[k]);
+					}
+
+					new_cache->addFrame(gap_pts.GetData());
+				}
+			}
+
+			new_cache->addFrame(new_pts.GetData());
+			prev_pts = new_pts;
+			i += real_step;
+
+			if (i > cur_animation->getEndTime() || real_step == 0)
+			{
+				break;
+			}
+        }
+        
+        if(quantize_in)
+        {
+            new_cache->quantize();
+        }
+        
+        setRunTime(store_run_time);
+        return new_cache;
+    }
+    
+    bool
+    CreatureManager::MakePointCacheAsync(const FName& animation_name_in, int32 gap_step, bool quantize_in)
+    {
+        if(!animations.Contains(animation_name_in)
+           || animations[animation_name_in]->hasCachePts()
+           || IsPointCachePending(animation_name_in))
+        {
+            return false;
+        }
+        
+        // a private instance of the character poses on the worker, sharing only the read only animation.
+        // Cooked views are never changed once loaded, see meshDisplacementCacheManager::getCacheTable(),
+        // so the clip is read without a lock as long as nothing writes frames into it meanwhile
+        auto pose_creature = TSharedPtr<CreatureModule::Creature>(new CreatureModule::Creature(target_creature->GetTemplate()));
+        pose_creature->SetAnchorPointsActive(target_creature->GetAnchorPointsActive());
+        pendingPointCache& new_pending = pending_point_caches.Add(animation_name_in);
+        new_pending.pose_manager = TSharedPtr<CreatureManager>(new CreatureManager(pose_creature));
+        new_pending.pose_manager->AddAnimation(animations[animation_name_in]);
+        
+        // shared pointers are only copied and released on this thread, like CreatureAnimationLibrary::Prefetch()
+        CreatureManager * cur_pose_manager = new_pending.pose_manager.Get();
+        new_pending.result = Async(EAsyncExecution::ThreadPool,
+            [cur_pose_manager, animation_name_in, gap_step, quantize_in]() {
+                return cur_pose_manager->BuildPointCache(animation_name_in, gap_step, quantize_in);
+            });
+        
+        return true;
+    }
+    
+    bool
+    CreatureManager::MakePointCacheLazy(const FName& animation_name_in, bool quantize_in)
+    {
+        if(!animations.Contains(animation_name_in)
+           || animations[animation_name_in]->hasCachePts()
+           || IsPointCachePending(animation_name_in))
+        {
+            return false;
+        }
+        
+        auto& cur_animation = animations[animation_name_in];
+        int32 start_frame = (int32)cur_animation->getStartTime();
+        lazyPointCache& new_lazy_cache = lazy_point_caches.Add(animation_name_in);
+        new_lazy_cache.cache = TSharedPtr<CreaturePointCache>(
+            new CreaturePointCache(target_creature->GetTotalNumPoints(), start_frame));
+        new_lazy_cache.cache->initFrames((int32)cur_animation->getEndTime() - start_frame + 1);
+        new_lazy_cache.quantize = quantize_in;
+        
+        return true;
+    }
+    
+    int32
+    CreatureManager::CollectPointCaches()
+    {
+        int32 num_collected = 0;
+        TArray<FName> ready_names;
+        for(auto& cur_pending : pending_point_caches)
+        {
+            if(cur_pending.Value.result.IsReady())
+            {
+                ready_names.Add(cur_pending.Key);
+            }
+        }
+        
+        for(auto& cur_name : ready_names)
+        {
+            // also drops the worker's private instance
+            auto new_cache = TSharedPtr<CreaturePointCache>(pending_point_caches[cur_name].result.Get());
+            pending_point_caches.Remove(cur_name);
+            auto * cur_animation = animations.Find(cur_name);
+            if(cur_animation && !(*cur_animation)->hasCachePts())
+            {
+                (*cur_animation)->setPointCache(new_cache);
+                num_collected++;
+            }
+        }
+        
+        ready_names.Reset();
+        for(auto& cur_lazy : lazy_point_caches)
+        {
+            if(cur_lazy.Value.cache->isComplete())
+            {
+                ready_names.Add(cur_lazy.Key);
+            }
+        }
+        
+        for(auto& cur_name : ready_names)
+        {
+            lazyPointCache& cur_lazy = lazy_point_caches[cur_name];
+            auto * cur_animation = animations.Find(cur_name);
+            if(cur_animation && !(*cur_animation)->hasCachePts())
+            {
+                if(cur_lazy.quantize)
+                {
+                    cur_lazy.cache->quantize();
+                }
+                
+                (*cur_animation)->setPointCache(cur_lazy.cache);
+                num_collected++;
+            }
+            
+            lazy_point_caches.Remove(cur_name);
+        }
+        
+        return num_collected;
+    }
+    
+    void
+    CreatureManager::FlushPointCaches()
     {
-		if (animations.Contains(animation_name_in) == false)
-		{
-			return;
-		}
-
-		if (gap_step < 1) {
-			gap_step = 1;
-		}
-
-        float store_run_time = getRunTime();
-        auto cur_animation = animations[animation_name_in];
-        if(cur_animation->hasCachePts())
+        for(auto& cur_pending : pending_point_caches)
         {
-            // cache already generated, just exit
-            return;
+            cur_pending.Value.result.Wait();
         }
         
-        TArray<glm::float32 *>& cache_pts_list = cur_animation->getCachePts();
-		int32 array_size = target_creature->GetTotalNumPoints() * 3;
-
-        UpdateRegionSwitches(animation_name_in);
-
-        //for(int32 i = (int32)cur_animation->getStartTime(); i <= (int32)cur_animation->getEndTime(); i++)
-		int32 i = (int32)cur_animation->getStartTime();
-		while (true)
+        CollectPointCaches();
+    }
+    
+    bool
+    CreatureManager::IsPointCachePending(const FName& animation_name_in) const
+    {
+        return pending_point_caches.Contains(animation_name_in) || lazy_point_caches.Contains(animation_name_in);
+    }
+    
+    void
+    CreatureManager::PoseFromLazyPointCache(const FName& animation_name_in, lazyPointCache& lazy_cache)
+    {
+        // frames not reached before are posed into the cache first
+        CreaturePointCache * cur_cache = lazy_cache.cache.Get();
+        int32 pose_frames[2];
+        cur_cache->getFramesAtTime(getRunTime(), pose_frames[0], pose_frames[1]);
+        for(int32 cur_frame : pose_frames)
         {
-            run_time = (float)i;
-			auto new_pts = new glm::float32[array_size];
-            PoseCreature(animation_name_in, new_pts, getRunTime());
-            
-			int32 real_step = gap_step;
-			if (i + real_step > cur_animation->getEndTime())
-			{
-				real_step = (int32)cur_animation->getEndTime() - i;
-			}
-
-			bool firstCase = real_step > 1;
-			bool secondCase = (cache_pts_list.Num() >= 1);
-			if (firstCase && secondCase)
-			{
-				// fill in the gaps
-				glm::float32 * prev_pts = cache_pts_list[cache_pts_list.Num() - 1];
-				for (int32 j = 0; j < real_step; j++)
-				{
-					float factor = (float)j / (float)real_step;
-					glm::float32 * gap_pts = interpFloatArray(prev_pts, new_pts, factor, array_size);
-					cache_pts_list.Add(gap_pts);
-				}
-			}
-
-			cache_pts_list.Add(new_pts);
-			i += real_step;
-
-			if (i > cur_animation->getEndTime() || real_step == 0)
-			{
-				break;
-			}
+            if(!cur_cache->hasFrame(cur_frame))
+            {
+                lazy_pose_pts.SetNumUninitialized(target_creature->GetTotalNumPoints() * 3);
+                PoseCreature(animation_name_in, lazy_pose_pts.GetData(), (float)(cur_cache->getStartTime() + cur_frame));
+                cur_cache->setFrame(cur_frame, lazy_pose_pts.GetData());
+            }
         }
         
-        setRunTime(store_run_time);
+        cur_cache->poseAtTime(getRunTime(), target_creature->GetRenderPts());
+        PoseJustBones(animation_name_in, getRunTime());
     }
     
-	glm::float32 * 
-	CreatureManager::interpFloatArray(glm::float32 * first_list, glm::float32 * second_list, float factor, int32 array_size)
-	{
-		glm::float32 * ret_array = new glm::float32[array_size];
-		for (int32 i = 0; i < array_size; i++)
-		{
-			float new_val = ((1.0f - factor) * first_list[i]) + (factor * second_list[i]);
-			ret_array[i] = new_val;
-		}
-
-		return ret_array;
-	}
-
     void
     CreatureManager::PoseCreature(const FName& animation_name_in,
                                   glm::float32 * target_pts,
-								  float input_run_time)
+								  float input_run_time,
+								  bool defer_skinning)
     {
 		SCOPE_CYCLE_COUNTER(STAT_CreatureManager_PoseCreature);
         if(animations.Contains(animation_name_in) == false)
@@ -1532,6 +4154,7 @@ namespace CreatureModule {
         }
         
         auto& cur_animation = animations[animation_name_in];
+        const animationBinding& cur_binding = GetAnimationBinding(animation_name_in);
         
         auto& bone_cache_manager = cur_animation->getBonesCache();
         auto& displacement_cache_manager = cur_animation->getDisplacementCache();
@@ -1544,11 +4167,12 @@ namespace CreatureModule {
         // Extract values from caches
         TMap<FName, meshBone *>& bones_map =
         render_composition->getBonesMap();
-        TMap<FName, meshRenderRegion *>& regions_map =
-        render_composition->getRegionsMap();
+        TArray<meshRenderRegion *>& regions_list =
+        render_composition->getRegions();
         
 		bone_cache_manager.retrieveValuesAtTime(input_run_time,
-                                                bones_map);
+                                                render_composition->getBonesList(),
+                                                cur_binding.bone_indices);
 
 		AlterBonesByAnchor(bones_map, animation_name_in);
         
@@ -1558,11 +4182,14 @@ namespace CreatureModule {
         }
         
 		displacement_cache_manager.retrieveValuesAtTime(input_run_time,
-                                                        regions_map);
+                                                        regions_list,
+                                                        cur_binding.displacement_indices);
 		uv_warp_cache_manager.retrieveValuesAtTime(input_run_time,
-                                                   regions_map);
+                                                   regions_list,
+                                                   cur_binding.uv_warp_indices);
 		opacity_cache_manager.retrieveValuesAtTime(input_run_time,
-													regions_map);
+													regions_list,
+													cur_binding.opacity_indices);
         
         
         // Do posing, decide if we are blending or not
@@ -1570,15 +4197,184 @@ namespace CreatureModule {
         render_composition->getRegions();
         
         render_composition->updateAllTransforms(false);
-        for(auto j = 0; j < cur_regions.Num(); j++) {
-            meshRenderRegion * cur_region = cur_regions[j];
-            
-            int32 cur_pt_index = cur_region->getStartPtIndex();
-            cur_region->poseFastFinalPts(target_pts + (cur_pt_index * 3));
+        
+        // all regions are skinned with one dispatch, deferred ones are run by the caller
+        pose_scheduler.addComposition(render_composition, target_pts);
+        if(!defer_skinning)
+        {
+            pose_scheduler.run();
         }
 
     }
     
+    void
+    CreatureManager::PoseCreatureBlend(const TArray<blendInput>& inputs_in,
+                                       glm::float32 * target_pts,
+                                       bool defer_skinning)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_CreatureManager_PoseCreatureBlend);
+
+        // normalize the weights of the valid clips, the heaviest one drives the uv warps.
+        // Weights may be negative to extrapolate past a clip, as long as they do not cancel out
+        float total_weight = 0;
+        int32 main_index = INDEX_NONE;
+        for(int32 i = 0; i < inputs_in.Num(); i++)
+        {
+            const blendInput& cur_input = inputs_in[i];
+            if((cur_input.weight == 0) || !animations.Contains(cur_input.animation_name))
+            {
+                continue;
+            }
+
+            total_weight += cur_input.weight;
+            if((main_index == INDEX_NONE) || (cur_input.weight > inputs_in[main_index].weight))
+            {
+                main_index = i;
+            }
+        }
+
+        if((main_index == INDEX_NONE) || (FMath::Abs(total_weight) < 1.0e-6f))
+        {
+            return;
+        }
+
+        meshRenderBoneComposition * render_composition =
+        target_creature->GetRenderComposition();
+        TMap<FName, meshBone *>& bones_map = render_composition->getBonesMap();
+        TArray<meshBone *>& bones_list = render_composition->getBonesList();
+        TArray<meshRenderRegion *>& regions_list = render_composition->getRegions();
+        const int32 num_pts = target_creature->GetTotalNumPoints();
+
+        blend_bone_pts.SetNumUninitialized(bones_list.Num() * 2);
+        blend_local_displacements.SetNumUninitialized(num_pts);
+        blend_post_displacements.SetNumUninitialized(num_pts);
+        blend_region_colors.SetNumUninitialized(regions_list.Num());
+        blend_region_flags.SetNumUninitialized(regions_list.Num());
+        FMemory::Memzero(blend_bone_pts.GetData(), blend_bone_pts.Num() * sizeof(glm::vec4));
+        FMemory::Memzero(blend_local_displacements.GetData(), num_pts * sizeof(glm::vec2));
+        FMemory::Memzero(blend_post_displacements.GetData(), num_pts * sizeof(glm::vec2));
+        FMemory::Memzero(blend_region_colors.GetData(), regions_list.Num() * sizeof(glm::vec4));
+        FMemory::Memzero(blend_region_flags.GetData(), regions_list.Num());
+
+        for(auto& cur_input : inputs_in)
+        {
+            if((cur_input.weight == 0) || !animations.Contains(cur_input.animation_name))
+            {
+                continue;
+            }
+
+            const float cur_weight = cur_input.weight / total_weight;
+            auto& cur_animation = animations[cur_input.animation_name];
+            const animationBinding& cur_binding = GetAnimationBinding(cur_input.animation_name);
+
+            cur_animation->getBonesCache().retrieveValuesAtTime(cur_input.run_time,
+                                                                bones_list,
+                                                                cur_binding.bone_indices);
+            AlterBonesByAnchor(bones_map, cur_input.animation_name);
+
+            for(int32 j = 0; j < bones_list.Num(); j++)
+            {
+                blend_bone_pts[j * 2] += cur_weight * bones_list[j]->getWorldStartPt();
+                blend_bone_pts[j * 2 + 1] += cur_weight * bones_list[j]->getWorldEndPt();
+            }
+
+            // clips without displacements on a region add zero to it
+            UpdateRegionSwitches(cur_input.animation_name);
+            cur_animation->getDisplacementCache().retrieveValuesAtTime(cur_input.run_time,
+                                                                       regions_list,
+                                                                       cur_binding.displacement_indices);
+            cur_animation->getOpacityCache().retrieveValuesAtTime(cur_input.run_time,
+                                                                  regions_list,
+                                                                  cur_binding.opacity_indices);
+
+            for(int32 j = 0; j < regions_list.Num(); j++)
+            {
+                meshRenderRegion * cur_region = regions_list[j];
+                const int32 start_pt = cur_region->getStartPtIndex();
+                if(cur_region->getUseLocalDisplacements())
+                {
+                    TArray<glm::vec2>& displacements = cur_region->getLocalDisplacements();
+                    for(int32 k = 0; k < displacements.Num(); k++)
+                    {
+                        blend_local_displacements[start_pt + k] += cur_weight * displacements[k];
+                    }
+
+                    blend_region_flags[j] |= 1;
+                }
+
+                if(cur_region->getUsePostDisplacements())
+                {
+                    TArray<glm::vec2>& displacements = cur_region->getPostDisplacements();
+                    for(int32 k = 0; k < displacements.Num(); k++)
+                    {
+                        blend_post_displacements[start_pt + k] += cur_weight * displacements[k];
+                    }
+
+                    blend_region_flags[j] |= 2;
+                }
+
+                blend_region_colors[j] += cur_weight * glm::vec4(cur_region->getOpacity(),
+                                                                 cur_region->getRed(),
+                                                                 cur_region->getGreen(),
+                                                                 cur_region->getBlue());
+            }
+        }
+
+        for(int32 j = 0; j < bones_list.Num(); j++)
+        {
+            bones_list[j]->setWorldStartPt(blend_bone_pts[j * 2]);
+            bones_list[j]->setWorldEndPt(blend_bone_pts[j * 2 + 1]);
+        }
+
+        if(bones_override_callback)
+        {
+            bones_override_callback(bones_map);
+        }
+
+        const blendInput& main_input = inputs_in[main_index];
+        UpdateRegionSwitches(main_input.animation_name);
+        for(int32 j = 0; j < regions_list.Num(); j++)
+        {
+            meshRenderRegion * cur_region = regions_list[j];
+            const int32 start_pt = cur_region->getStartPtIndex();
+            cur_region->setUseLocalDisplacements((blend_region_flags[j] & 1) != 0);
+            cur_region->setUsePostDisplacements((blend_region_flags[j] & 2) != 0);
+            if(cur_region->getUseLocalDisplacements())
+            {
+                FMemory::Memcpy(cur_region->getLocalDisplacements().GetData(),
+                                blend_local_displacements.GetData() + start_pt,
+                                cur_region->getNumPts() * sizeof(glm::vec2));
+            }
+
+            if(cur_region->getUsePostDisplacements())
+            {
+                FMemory::Memcpy(cur_region->getPostDisplacements().GetData(),
+                                blend_post_displacements.GetData() + start_pt,
+                                cur_region->getNumPts() * sizeof(glm::vec2));
+            }
+
+            // extrapolated colors must not go negative
+            const glm::vec4 cur_color = glm::max(blend_region_colors[j], 0.0f);
+            cur_region->setOpacity(cur_color.x);
+            cur_region->setRed(cur_color.y);
+            cur_region->setGreen(cur_color.z);
+            cur_region->setBlue(cur_color.w);
+        }
+
+        animations[main_input.animation_name]->getUVWarpCache().retrieveValuesAtTime(
+            main_input.run_time,
+            regions_list,
+            GetAnimationBinding(main_input.animation_name).uv_warp_indices);
+
+        render_composition->updateAllTransforms(false);
+
+        pose_scheduler.addComposition(render_composition, target_pts);
+        if(!defer_skinning)
+        {
+            pose_scheduler.run();
+        }
+    }
+
     void
     CreatureManager::ProcessAutoBlending()
     {
@@ -1605,6 +4401,7 @@ namespace CreatureModule {
 		}
 
 		auto& cur_animation = *animEntry;
+		const animationBinding& cur_binding = GetAnimationBinding(animation_name_in);
 
 		auto& bone_cache_manager = cur_animation->getBonesCache();
 		auto& opacity_cache_manager = cur_animation->getOpacityCache();
@@ -1615,11 +4412,10 @@ namespace CreatureModule {
 		// Extract values from caches
 		TMap<FName, meshBone *>& bones_map =
 			render_composition->getBonesMap();
-		TMap<FName, meshRenderRegion *>& regions_map =
-			render_composition->getRegionsMap();
 
 		bone_cache_manager.retrieveValuesAtTime(input_run_time,
-			bones_map);
+			render_composition->getBonesList(),
+			cur_binding.bone_indices);
 
 		AlterBonesByAnchor(bones_map, animation_name_in);
 
@@ -1629,7 +4425,8 @@ namespace CreatureModule {
 		}
 
 		opacity_cache_manager.retrieveValuesAtTime(input_run_time,
-			regions_map);
+			render_composition->getRegions(),
+			cur_binding.opacity_indices);
 
 		JustRunUVWarps(animation_name_in, input_run_time);
 	}
@@ -1639,16 +4436,16 @@ namespace CreatureModule {
 		SCOPE_CYCLE_COUNTER(STAT_CreatureManager_JustRunUVWarps);
 
 		auto& cur_animation = animations[animation_name_in];
+		const animationBinding& cur_binding = GetAnimationBinding(animation_name_in);
 
 		meshRenderBoneComposition * render_composition =
 			target_creature->GetRenderComposition();
-		TMap<FName, meshRenderRegion *>& regions_map =
-			render_composition->getRegionsMap();
+		TArray<meshRenderRegion *>& all_regions = render_composition->getRegions();
 
 		auto& uv_warp_cache_manager = cur_animation->getUVWarpCache();
 		uv_warp_cache_manager.retrieveValuesAtTime(input_run_time,
-			regions_map);
-		TArray<meshRenderRegion *>& all_regions = render_composition->getRegions();
+			all_regions,
+			cur_binding.uv_warp_indices);
 
 		int32 index = 0;
 		for (auto& cur_region : all_regions) {
@@ -1726,12 +4523,53 @@ namespace CreatureModule {
     void
     CreatureManager::Update(float delta)
     {
-		SCOPE_CYCLE_COUNTER(STAT_CreatureManager_Update);
         if(!is_playing)
         {
             return;
         }
+
+        UpdatePose(delta, false);
+        EndUpdate();
+    }
+
+    bool
+    CreatureManager::BeginUpdate(float delta)
+    {
+        if(!is_playing)
+        {
+            return false;
+        }
+
+        UpdatePose(delta, true);
+        return true;
+    }
+
+    void
+    CreatureManager::EndUpdate()
+    {
+		RunUVItemSwap();
         
+        if(mirror_y)
+        {
+            glm::float32 * set_data = target_creature->GetRenderPts();
+            for(int32 j = 0; j < target_creature->GetTotalNumPoints(); j++)
+            {
+                set_data[0] = -set_data[0];
+                set_data += 3;
+            }
+        }
+    }
+
+    meshPoseScheduler&
+    CreatureManager::GetPoseScheduler()
+    {
+        return pose_scheduler;
+    }
+
+    void
+    CreatureManager::UpdatePose(float delta, bool defer_skinning)
+    {
+		SCOPE_CYCLE_COUNTER(STAT_CreatureManager_Update);
         increRunTime(delta * time_scale);
         
         if(do_auto_blending)
@@ -1741,7 +4579,24 @@ namespace CreatureModule {
 			increAutoBlendRuntimes(delta * time_scale);
         }
         
-        if(do_blending && checkAnimationBlendValid())
+        if(blend_space_inputs.Num() > 0)
+        {
+            increBlendSpaceRunTimes(delta * time_scale);
+            PoseCreatureBlend(blend_space_inputs, target_creature->GetRenderPts(), defer_skinning);
+        }
+        else if(do_blending && do_bone_blending && checkAnimationBlendValid())
+        {
+            blend_inputs.Reset();
+            for(int32 i = 0; i < 2; i++) {
+                auto& cur_animation_name = active_blend_animation_names[i];
+                blend_inputs.Add(blendInput(cur_animation_name,
+                                            active_blend_run_times[cur_animation_name],
+                                            (i == 0) ? (1.0f - blending_factor) : blending_factor));
+            }
+
+            PoseCreatureBlend(blend_inputs, target_creature->GetRenderPts(), defer_skinning);
+        }
+        else if(do_blending && checkAnimationBlendValid())
         {
             for(int32 i = 0; i < 2; i++) {
 				auto& cur_animation_name = active_blend_animation_names[i];
@@ -1772,25 +4627,18 @@ namespace CreatureModule {
         }
         else {
             auto& cur_animation = animations[active_animation_name];
-            if(cur_animation->hasCachePts() && do_point_caching)
+            auto * lazy_cache = do_point_caching ? lazy_point_caches.Find(active_animation_name) : nullptr;
+            if(lazy_cache && !cur_animation->hasCachePts())
+            {
+                PoseFromLazyPointCache(active_animation_name, *lazy_cache);
+            }
+            else if(cur_animation->hasCachePts() && do_point_caching)
             {
 				cur_animation->poseFromCachePts(getRunTime(), target_creature->GetRenderPts(), target_creature->GetTotalNumPoints());
 				PoseJustBones(active_animation_name, getRunTime());
             }
             else {
-				PoseCreature(active_animation_name, target_creature->GetRenderPts(), getRunTime());
-            }
-        }
-
-		RunUVItemSwap();
-        
-        if(mirror_y)
-        {
-            glm::float32 * set_data = target_creature->GetRenderPts();
-            for(int32 j = 0; j < target_creature->GetTotalNumPoints(); j++)
-            {
-                set_data[0] = -set_data[0];
-                set_data += 3;
+				PoseCreature(active_animation_name, target_creature->GetRenderPts(), getRunTime(), defer_skinning);
             }
         }
     }
@@ -1800,6 +4648,12 @@ namespace CreatureModule {
     {
         mirror_y = flag_in;
     }
+
+    bool
+    CreatureManager::GetMirrorY() const
+    {
+        return mirror_y;
+    }
     
     FName
     CreatureManager::IsContactBone(const glm::vec2& pt_in,
@@ -1988,4 +4842,124 @@ namespace CreatureModule {
         bones_override_callback = callback_in;
     }
 
+    // CreatureCrowd class
+    CreatureCrowd::CreatureCrowd()
+    : num_queued_managers(0), last_num_groups(0)
+    {
+    }
+
+    void
+    CreatureCrowd::AddManager(CreatureManager * manager_in, float delta_in)
+    {
+        CreatureTemplate * cur_template = manager_in->GetCreature()->GetTemplate().Get();
+        const FName& cur_animation_name = manager_in->GetActiveAnimationName();
+
+        crowdGroup * add_group = nullptr;
+        for(auto& cur_group : groups)
+        {
+            if((cur_group.creature_template == cur_template)
+               && (cur_group.animation_name == cur_animation_name))
+            {
+                add_group = &cur_group;
+                break;
+            }
+        }
+
+        if(add_group == nullptr)
+        {
+            add_group = &groups[groups.AddDefaulted()];
+            add_group->creature_template = cur_template;
+            add_group->animation_name = cur_animation_name;
+        }
+
+        crowdEntry new_entry;
+        new_entry.manager = manager_in;
+        new_entry.delta = delta_in;
+        add_group->entries.Add(new_entry);
+        num_queued_managers++;
+    }
+
+    void
+    CreatureCrowd::RemoveManager(CreatureManager * manager_in)
+    {
+        for(auto& cur_group : groups)
+        {
+            num_queued_managers -= cur_group.entries.RemoveAll([manager_in](const crowdEntry& cur_entry) {
+                return cur_entry.manager == manager_in;
+            });
+        }
+    }
+
+    void
+    CreatureCrowd::Run()
+    {
+		SCOPE_CYCLE_COUNTER(STAT_CreatureCrowd_Run);
+
+        // characters sharing caches sit next to each other
+        run_entries.Reset();
+        for(auto& cur_group : groups)
+        {
+            run_entries.Append(cur_group.entries);
+        }
+
+        last_num_groups = groups.Num();
+        groups.Reset();
+        num_queued_managers = 0;
+
+        const int32 num_entries = run_entries.Num();
+        run_queued.SetNumZeroed(num_entries);
+
+        // animation and bones, skinning is only queued
+#ifdef CREATURE_MULTICORE
+		ParallelFor(num_entries, [&](int32 i) {
+#else
+		for (int32 i = 0; i < num_entries; i++) {
+#endif
+			run_queued[i] = run_entries[i].manager->BeginUpdate(run_entries[i].delta) ? 1 : 0;
+#ifdef CREATURE_MULTICORE
+		}, num_entries < 2);
+#else
+		}
+#endif
+
+        // one skinning dispatch over every character
+        for(int32 i = 0; i < num_entries; i++)
+        {
+            if(run_queued[i])
+            {
+                crowd_scheduler.takeJobs(run_entries[i].manager->GetPoseScheduler());
+            }
+        }
+
+        const int32 num_pts = crowd_scheduler.getNumQueuedPts();
+        crowd_scheduler.run();
+
+#ifdef CREATURE_MULTICORE
+		ParallelFor(num_entries, [&](int32 i) {
+#else
+		for (int32 i = 0; i < num_entries; i++) {
+#endif
+			if (run_queued[i])
+			{
+				run_entries[i].manager->EndUpdate();
+			}
+#ifdef CREATURE_MULTICORE
+		}, num_pts < meshPoseScheduler::getMinParallelPts());
+#else
+		}
+#endif
+    }
+
+    int32
+    CreatureCrowd::GetNumQueuedManagers() const
+    {
+        return num_queued_managers;
+    }
+
+    int32
+    CreatureCrowd::GetNumGroups() const
+    {
+        return last_num_groups;
+    }
+
 }
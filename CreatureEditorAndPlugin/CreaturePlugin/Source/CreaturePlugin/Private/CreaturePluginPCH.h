@@ -4,7 +4,9 @@
 #define __CREATUREPLUGIN_H__
 
 #include "CoreMinimal.h"
+#ifndef CREATURE_STANDALONE
 #include "CreatureCore.h"
+#endif
 
 DECLARE_STATS_GROUP(TEXT("Creature"), STATGROUP_Creature, STATCAT_Advanced);
 
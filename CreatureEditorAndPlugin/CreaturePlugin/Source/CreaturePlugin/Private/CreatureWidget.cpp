@@ -27,6 +27,7 @@ void UCreatureWidget::InitCreatureCore()
 		&& creature_core.creature_asset_filename != creature_animation_asset->GetCreatureFilename())
 	{
 		creature_core.pJsonData = &creature_animation_asset->GetJsonString();
+		creature_core.pCookedData = creature_animation_asset->GetCookedBinary();
 		creature_core.creature_asset_filename = creature_animation_asset->GetCreatureFilename();
 
 		creature_animation_asset->LoadPointCacheForAllClips(&creature_core);
@@ -8,8 +8,10 @@
 #include "Engine/CollisionProfile.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include <Runtime/Core/Public/Async/ParallelFor.h>
+#include "MeshBone.h"
 
 DECLARE_DWORD_COUNTER_STAT(TEXT("Creature Mesh Tris"), STAT_CreatureMeshTriangles, STATGROUP_Creature);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Creature Tangent Passes"), STAT_CreatureTangentPasses, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("ProceduralMeshSceneProxy_GetDynamicMeshElements"), STAT_ProceduralMeshSceneProxy_GetDynamicMeshElements, STATGROUP_Creature);
 DECLARE_CYCLE_STAT(TEXT("ProceduralMeshSceneProxy_SetDynamicData"), STAT_ProceduralMeshSceneProxy_SetDynamicData, STATGROUP_Creature);
 
@@ -26,20 +28,51 @@ static TAutoConsoleVariable<int32> CVarShowCreatureMeshes(
 	ECVF_RenderThreadSafe);
 
 
+// Number of vertex buffer sets each render packet cycles through, so the set being written
+// this frame is not one the GPU may still be reading from the frames before
+static const int32 ProceduralMeshBufferedFrames = 3;
+
+// CPU side stream copies of each render packet, the game thread builds one while the render
+// thread uploads from another. Fixed by meshTripleBufferIndex
+static const int32 ProceduralMeshStreamSlots = 3;
+
 static FVertexBufferRHIRef AllocVertexBuffer(uint32 Stride, uint32 NumElements)
 {
 	FVertexBufferRHIRef VertexBufferRHI;
 	uint32 SizeInBytes = NumElements * Stride;
 	FRHIResourceCreateInfo CreateInfo;
-	VertexBufferRHI = RHICreateVertexBuffer(SizeInBytes, BUF_Volatile | BUF_ShaderResource, CreateInfo);
+	VertexBufferRHI = RHICreateVertexBuffer(SizeInBytes, BUF_Dynamic | BUF_ShaderResource, CreateInfo);
 
 	return VertexBufferRHI;
 }
 
 static void ReleaseVertexBuffer(FVertexBuffer& VertexBuffer)
 {
+	VertexBuffer.VertexBufferRHI.SafeRelease();
+}
+
+// FLocalVertexFactory's manual vertex fetch reads positions from the SRV as three floats a vertex,
+// so half positions only work where the vertex declaration does the fetch
+static bool CanUseHalfPositions(ERHIFeatureLevel::Type InFeatureLevel)
+{
+	return (InFeatureLevel <= ERHIFeatureLevel::ES3_1) || !RHISupportsManualVertexFetch(GShaderPlatformForFeatureLevel[InFeatureLevel]);
 }
 
+/** CPU side vertex streams of a render packet */
+struct FProceduralMeshVertexStreams
+{
+	TArray<FVector> Positions;
+	// TangentX and TangentZ of each vertex
+	TArray<FPackedNormal> Tangents;
+	TArray<FVector2D> TexCoords;
+	TArray<FColor> Colors;
+
+	int32 Num() const
+	{
+		return Positions.Num();
+	}
+};
+
 /** Vertex Buffer */
 class FProceduralMeshVertexBuffer : public FDynamicPrimitiveResource, public FRenderResource
 {
@@ -54,76 +87,129 @@ public:
 	FShaderResourceViewRHIRef ColorBufferSRV;
 	FShaderResourceViewRHIRef PositionBufferSRV;
 
-	mutable TArray<FDynamicMeshVertex> Vertices;
+	// Streams this set has not received yet, EProceduralMeshStream flags
+	uint8 StaleStreams;
+	// Publish serial of the packet slot this set was last written from
+	uint32 SyncedSerial;
 
-	FProceduralMeshVertexBuffer(uint32 InNumTexCoords = 1, uint32 InLightmapCoordinateIndex = 0, bool InUse16bitTexCoord = false) : NumTexCoords(InNumTexCoords), LightmapCoordinateIndex(InLightmapCoordinateIndex), Use16bitTexCoord(InUse16bitTexCoord)
+	FProceduralMeshVertexBuffer(const FProceduralMeshVertexStreams* InStreams, uint32 InNumTexCoords = 1, uint32 InLightmapCoordinateIndex = 0, bool InUse16bitTexCoord = false, bool InUseHalfPositions = false) : Streams(InStreams), NumTexCoords(InNumTexCoords), LightmapCoordinateIndex(InLightmapCoordinateIndex), Use16bitTexCoord(InUse16bitTexCoord), UseHalfPositions(InUseHalfPositions)
 	{
 		check(NumTexCoords > 0 && NumTexCoords <= MAX_STATIC_TEXCOORDS);
 		check(LightmapCoordinateIndex < NumTexCoords);
-		buffersAllocated = false;
+		NumVertices = 0;
+		StaleStreams = EProceduralMeshStream::All;
+		SyncedSerial = 0;
 	}
 
-	bool buffersAllocated;
-
 	// FRenderResource interface.
 	virtual void InitRHI() override
 	{
-		uint32 TextureStride = sizeof(FVector2D);
-		EPixelFormat TextureFormat = PF_G32R32F;
+		AllocateBuffers(Streams->Num());
+		UpdateBuffers(StaleStreams);
+	}
 
-		if (Use16bitTexCoord)
+	// (Re)creates the RHI buffers and their views, only needed when the vertex count changes
+	void AllocateBuffers(int32 num_vertices)
+	{
+		ReleaseRHI();
+		NumVertices = num_vertices;
+		if (NumVertices <= 0)
 		{
-			TextureStride = sizeof(FVector2DHalf);
-			TextureFormat = PF_G16R16F;
+			return;
+		}
+
+		const uint32 TextureStride = GetTexCoordStride();
+		const EPixelFormat TextureFormat = Use16bitTexCoord ? PF_G16R16F : PF_G32R32F;
+
+		PositionBuffer.VertexBufferRHI = AllocVertexBuffer(GetPositionStride(), NumVertices);
+		TangentBuffer.VertexBufferRHI = AllocVertexBuffer(sizeof(FPackedNormal), 2 * NumVertices);
+		TexCoordBuffer.VertexBufferRHI = AllocVertexBuffer(TextureStride, NumTexCoords * NumVertices);
+		ColorBuffer.VertexBufferRHI = AllocVertexBuffer(sizeof(FColor), NumVertices);
+
+		TangentBufferSRV = RHICreateShaderResourceView(TangentBuffer.VertexBufferRHI, 4, PF_R8G8B8A8);
+		TexCoordBufferSRV = RHICreateShaderResourceView(TexCoordBuffer.VertexBufferRHI, TextureStride, TextureFormat);
+		ColorBufferSRV = RHICreateShaderResourceView(ColorBuffer.VertexBufferRHI, 4, PF_R8G8B8A8);
+		PositionBufferSRV = UseHalfPositions ?
+			RHICreateShaderResourceView(PositionBuffer.VertexBufferRHI, sizeof(FFloat16), PF_R16F) :
+			RHICreateShaderResourceView(PositionBuffer.VertexBufferRHI, sizeof(float), PF_R32_FLOAT);
+		StaleStreams = EProceduralMeshStream::All;
 	}
 
-		if (!buffersAllocated)
+	// Writes the given streams into the existing buffers, the stream sizes must match the allocated count
+	void UpdateBuffers(uint8 streams_in)
 	{
-			PositionBuffer.VertexBufferRHI = AllocVertexBuffer(sizeof(FVector), Vertices.Num());
-			TangentBuffer.VertexBufferRHI = AllocVertexBuffer(sizeof(FPackedNormal), 2 * Vertices.Num());
-			TexCoordBuffer.VertexBufferRHI = AllocVertexBuffer(TextureStride, NumTexCoords * Vertices.Num());
-			ColorBuffer.VertexBufferRHI = AllocVertexBuffer(sizeof(FColor), Vertices.Num());
+		check(Streams->Num() == NumVertices);
+		StaleStreams &= ~streams_in;
+		if (NumVertices <= 0)
+		{
+			return;
+		}
 
-			TangentBufferSRV = RHICreateShaderResourceView(TangentBuffer.VertexBufferRHI, 4, PF_R8G8B8A8);
-			TexCoordBufferSRV = RHICreateShaderResourceView(TexCoordBuffer.VertexBufferRHI, TextureStride, TextureFormat);
-			ColorBufferSRV = RHICreateShaderResourceView(ColorBuffer.VertexBufferRHI, 4, PF_R8G8B8A8);
-			PositionBufferSRV = RHICreateShaderResourceView(PositionBuffer.VertexBufferRHI, sizeof(float), PF_R32_FLOAT);
-			buffersAllocated = true;
-	}
+		if ((streams_in & EProceduralMeshStream::Position) && UseHalfPositions)
+		{
+			// x, depth, y and w as halves, 8 bytes instead of 12
+			FFloat16* PositionBufferData = static_cast<FFloat16*>(RHILockVertexBuffer(PositionBuffer.VertexBufferRHI, 0, GetPositionStride() * NumVertices, RLM_WriteOnly));
+			for (int32 i = 0; i < NumVertices; i++)
+			{
+				const FVector& cur_pos = Streams->Positions[i];
+				PositionBufferData[4 * i + 0] = FFloat16(cur_pos.X);
+				PositionBufferData[4 * i + 1] = FFloat16(cur_pos.Y);
+				PositionBufferData[4 * i + 2] = FFloat16(cur_pos.Z);
+				PositionBufferData[4 * i + 3] = FFloat16(1.0f);
+			}
+			RHIUnlockVertexBuffer(PositionBuffer.VertexBufferRHI);
+		}
+		else if (streams_in & EProceduralMeshStream::Position)
+		{
+			CopyToBuffer(PositionBuffer, Streams->Positions.GetData(), sizeof(FVector) * NumVertices);
+		}
 
-		void* TexCoordBufferData = RHILockVertexBuffer(TexCoordBuffer.VertexBufferRHI, 0, NumTexCoords * TextureStride * Vertices.Num(), RLM_WriteOnly);
-		FVector2D* TexCoordBufferData32 = !Use16bitTexCoord ? static_cast<FVector2D*>(TexCoordBufferData) : nullptr;
-		FVector2DHalf* TexCoordBufferData16 = Use16bitTexCoord ? static_cast<FVector2DHalf*>(TexCoordBufferData) : nullptr;
+		if (streams_in & EProceduralMeshStream::Tangent)
+		{
+			CopyToBuffer(TangentBuffer, Streams->Tangents.GetData(), 2 * sizeof(FPackedNormal) * NumVertices);
+		}
 
-		// Copy the vertex data into the vertex buffers.
-		FVector* PositionBufferData			= static_cast<FVector*>(RHILockVertexBuffer(PositionBuffer.VertexBufferRHI, 0, sizeof(FVector) * Vertices.Num(), RLM_WriteOnly));
-		FPackedNormal* TangentBufferData	= static_cast<FPackedNormal*>(RHILockVertexBuffer(TangentBuffer.VertexBufferRHI, 0, 2 * sizeof(FPackedNormal) * Vertices.Num(), RLM_WriteOnly));	
-		FColor* ColorBufferData				= static_cast<FColor*>(RHILockVertexBuffer(ColorBuffer.VertexBufferRHI, 0, sizeof(FColor) * Vertices.Num(), RLM_WriteOnly));
+		if (streams_in & EProceduralMeshStream::Color)
+		{
+			CopyToBuffer(ColorBuffer, Streams->Colors.GetData(), sizeof(FColor) * NumVertices);
+		}
 
-		for (int32 i = 0; i < Vertices.Num(); i++)
+		if (streams_in & EProceduralMeshStream::TexCoord)
 		{
-			PositionBufferData[i] = Vertices[i].Position;
-			TangentBufferData[2 * i + 0] = Vertices[i].TangentX;
-			TangentBufferData[2 * i + 1] = Vertices[i].TangentZ;
-			ColorBufferData[i] = Vertices[i].Color;
+			void* TexCoordBufferData = RHILockVertexBuffer(TexCoordBuffer.VertexBufferRHI, 0, NumTexCoords * GetTexCoordStride() * NumVertices, RLM_WriteOnly);
+			FVector2D* TexCoordBufferData32 = !Use16bitTexCoord ? static_cast<FVector2D*>(TexCoordBufferData) : nullptr;
+			FVector2DHalf* TexCoordBufferData16 = Use16bitTexCoord ? static_cast<FVector2DHalf*>(TexCoordBufferData) : nullptr;
 
-			for (uint32 j = 0; j < NumTexCoords; j++)
+			// every channel gets the same uvs
+			const TArray<FVector2D>& TexCoords = Streams->TexCoords;
+			for (int32 i = 0; i < NumVertices; i++)
 			{
-				if (Use16bitTexCoord)
+				for (uint32 j = 0; j < NumTexCoords; j++)
 				{
-					TexCoordBufferData16[NumTexCoords * i + j] = FVector2DHalf(Vertices[i].TextureCoordinate[j]);
-				}
-				else
-				{
-					TexCoordBufferData32[NumTexCoords * i + j] = Vertices[i].TextureCoordinate[j];
+					if (Use16bitTexCoord)
+					{
+						TexCoordBufferData16[NumTexCoords * i + j] = FVector2DHalf(TexCoords[i]);
+					}
+					else
+					{
+						TexCoordBufferData32[NumTexCoords * i + j] = TexCoords[i];
+					}
 				}
 			}
+
+			RHIUnlockVertexBuffer(TexCoordBuffer.VertexBufferRHI);
 		}
+	}
 
-		RHIUnlockVertexBuffer(PositionBuffer.VertexBufferRHI);
-		RHIUnlockVertexBuffer(TangentBuffer.VertexBufferRHI);
-		RHIUnlockVertexBuffer(TexCoordBuffer.VertexBufferRHI);
-		RHIUnlockVertexBuffer(ColorBuffer.VertexBufferRHI);
+	int32 GetNumVertices() const
+	{
+		return NumVertices;
+	}
+
+	// Slot of the packet the next upload reads from, set on the render thread
+	void SetStreams(const FProceduralMeshVertexStreams* InStreams)
+	{
+		Streams = InStreams;
 	}
 
 	void InitResource() override
@@ -146,11 +232,15 @@ public:
 
 	virtual void ReleaseRHI() override
 	{
+		TangentBufferSRV.SafeRelease();
+		TexCoordBufferSRV.SafeRelease();
+		ColorBufferSRV.SafeRelease();
+		PositionBufferSRV.SafeRelease();
+
 		ReleaseVertexBuffer(PositionBuffer);
 		ReleaseVertexBuffer(TangentBuffer);
 		ReleaseVertexBuffer(TexCoordBuffer);
 		ReleaseVertexBuffer(ColorBuffer);
-		buffersAllocated = false;
 	}
 
 	// FDynamicPrimitiveResource interface.
@@ -179,10 +269,35 @@ public:
 	{
 		return Use16bitTexCoord;
 	}
+
+	const bool GetUseHalfPositions() const
+	{
+		return UseHalfPositions;
+	}
+
+	uint32 GetPositionStride() const
+	{
+		return UseHalfPositions ? 4 * sizeof(FFloat16) : sizeof(FVector);
+	}
 private:
+	uint32 GetTexCoordStride() const
+	{
+		return Use16bitTexCoord ? sizeof(FVector2DHalf) : sizeof(FVector2D);
+	}
+
+	static void CopyToBuffer(FVertexBuffer& buffer_in, const void* src_data, uint32 num_bytes)
+	{
+		void* BufferData = RHILockVertexBuffer(buffer_in.VertexBufferRHI, 0, num_bytes, RLM_WriteOnly);
+		FMemory::Memcpy(BufferData, src_data, num_bytes);
+		RHIUnlockVertexBuffer(buffer_in.VertexBufferRHI);
+	}
+
+	const FProceduralMeshVertexStreams* Streams;
+	int32 NumVertices;
 	const uint32 NumTexCoords;
 	const uint32 LightmapCoordinateIndex;
 	const bool Use16bitTexCoord;
+	const bool UseHalfPositions;
 };
 
 /** Index Buffer */
@@ -226,8 +341,8 @@ public:
 			Data.PositionComponent = FVertexStreamComponent(
 				&PooledVertexBuffer->PositionBuffer,
 				0,
-				sizeof(FVector),
-				VET_Float3
+				PooledVertexBuffer->GetPositionStride(),
+				PooledVertexBuffer->GetUseHalfPositions() ? VET_Half4 : VET_Float3
 			);
 
 			Data.NumTexCoords = PooledVertexBuffer->GetNumTexCoords();
@@ -325,9 +440,24 @@ private:
 class FProceduralMeshRenderPacket
 {
 public:
-	FProceduralMeshRenderPacket(FProceduralMeshTriData * data_in, ERHIFeatureLevel::Type InFeatureLevel) :
-		VertexFactory(InFeatureLevel, &VertexBuffer)
+	FProceduralMeshRenderPacket(FProceduralMeshTriData * data_in, ERHIFeatureLevel::Type InFeatureLevel, bool compact_in = false)
 	{
+		use_compact_format = compact_in;
+		for (int32 i = 0; i < ProceduralMeshBufferedFrames; i++)
+		{
+			VertexBuffers.Add(new FProceduralMeshVertexBuffer(nullptr, 1, 0, use_compact_format, use_compact_format && CanUseHalfPositions(InFeatureLevel)));
+			VertexFactories.Add(new FProceduralMeshVertexFactory(InFeatureLevel, &VertexBuffers[i]));
+		}
+		cur_buffer_idx = 0;
+		pending_streams = 0;
+		for (int32 i = 0; i < ProceduralMeshStreamSlots; i++)
+		{
+			stale_slot_streams[i] = EProceduralMeshStream::All;
+		}
+		use_flat_tangents = false;
+		tangents_mirrored = false;
+		flip_tangents = false;
+
 		indices = data_in->indices;
 		points = data_in->points;
 		uvs = data_in->uvs;
@@ -345,9 +475,12 @@ public:
 	virtual ~FProceduralMeshRenderPacket()
 	{
 		if (should_release) {
-			VertexBuffer.ReleaseResource();
+			for (int32 i = 0; i < VertexBuffers.Num(); i++)
+			{
+				VertexBuffers[i].ReleaseResource();
+				VertexFactories[i].ReleaseResource();
+			}
 			IndexBuffer.ReleaseResource();
-			VertexFactory.ReleaseResource();
 		}
 	}
 
@@ -358,16 +491,102 @@ public:
 
 	void InitForRender()
 	{
-		BeginInitResource(&VertexBuffer);
+		// nothing reads the packet yet, so the buffers can take the first slot from this thread
+		const int32 read_idx = stream_handoff.acquireLatest();
+		for (int32 i = 0; i < VertexBuffers.Num(); i++)
+		{
+			VertexBuffers[i].SetStreams(&StreamSlots[read_idx]);
+			VertexBuffers[i].SyncedSerial = stream_handoff.getSerial(read_idx);
+		}
+
+		for (int32 i = 0; i < VertexBuffers.Num(); i++)
+		{
+			BeginInitResource(&VertexBuffers[i]);
+		}
 		BeginInitResource(&IndexBuffer);
-		BeginInitResource(&VertexFactory);
+		for (int32 i = 0; i < VertexFactories.Num(); i++)
+		{
+			BeginInitResource(&VertexFactories[i]);
+		}
 
 		should_release = true;
 	}
 
-	TArray<FDynamicMeshVertex> VertexCache;
+	// Streams the next CreateDirectVertexData() refreshes on top of the ones asked for
+	void SetPendingStreams(uint8 streams_in)
+	{
+		pending_streams |= streams_in;
+	}
+
+	// Colours the published slot, only before InitForRender() hands the packet to the render thread
+	void SetStartColor(const FColor& color_in)
+	{
+		FProceduralMeshVertexStreams& start_streams = StreamSlots[stream_handoff.getPublishedIdx()];
+		for (int32 i = 0; i < start_streams.Colors.Num(); i++)
+		{
+			start_streams.Colors[i] = color_in;
+		}
+	}
+
+	void SetFlatTangents(bool flag_in, bool mirror_in)
+	{
+		// the compact format has no per frame tangents
+		flag_in |= use_compact_format;
+		if (flag_in != use_flat_tangents)
+		{
+			// switching modes builds the basis once more from the current points
+			use_flat_tangents = flag_in;
+			tangents_mirrored = mirror_in;
+			pending_streams |= EProceduralMeshStream::Tangent;
+			return;
+		}
+
+		if (use_flat_tangents && (mirror_in != tangents_mirrored))
+		{
+			// the next slot gets flipped once it has caught up
+			flip_tangents = !flip_tangents;
+			tangents_mirrored = mirror_in;
+		}
+	}
+
+	// Mirrors the basis along the Y-Axis of the creature, which is X here. The normal flips since
+	// the winding does and the handedness stays the same
+	static void FlipTangents(FProceduralMeshVertexStreams& streams_in)
+	{
+		for (int32 i = 0; i < streams_in.Num(); i++)
+		{
+			const FVector tangent_x = streams_in.Tangents[2 * i + 0].ToFVector();
+			const FVector4 tangent_z = streams_in.Tangents[2 * i + 1].ToFVector4();
+			streams_in.Tangents[2 * i + 0] = FPackedNormal(FVector(-tangent_x.X, tangent_x.Y, tangent_x.Z));
+			streams_in.Tangents[2 * i + 1] = FPackedNormal(FVector4(tangent_z.X, -tangent_z.Y, -tangent_z.Z, tangent_z.W));
+		}
+	}
+
+	// Copies the flagged streams of one slot over to another of the same size
+	static void CopyStreams(const FProceduralMeshVertexStreams& src_streams, FProceduralMeshVertexStreams& dst_streams, uint8 streams_in)
+	{
+		if (streams_in & EProceduralMeshStream::Position)
+		{
+			dst_streams.Positions = src_streams.Positions;
+		}
+
+		if (streams_in & EProceduralMeshStream::Tangent)
+		{
+			dst_streams.Tangents = src_streams.Tangents;
+		}
+
+		if (streams_in & EProceduralMeshStream::TexCoord)
+		{
+			dst_streams.TexCoords = src_streams.TexCoords;
+		}
+
+		if (streams_in & EProceduralMeshStream::Color)
+		{
+			dst_streams.Colors = src_streams.Colors;
+		}
+	}
 
-	void CreateDirectVertexData()
+	void CreateDirectVertexData(uint8 streams_in = EProceduralMeshStream::All)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_CreateDirectVertexData);
 
@@ -375,77 +594,182 @@ public:
 		const int y_id = 2;
 		const int z_id = 1;
 
+		// the render thread never holds the write slot, only the live data needs locking
 		FScopeLock scope_lock(update_lock.Get());
-		
-		if (VertexCache.Num() != point_num)
+
+		// a flat basis is only built when the packet asks for it itself, on a mode switch or a
+		// resize, never for a caller refreshing everything
+		if (use_flat_tangents)
+		{
+			streams_in &= ~EProceduralMeshStream::Tangent;
+		}
+
+		bool basis_requested = (pending_streams & EProceduralMeshStream::Tangent) != 0;
+		streams_in |= pending_streams;
+		pending_streams = 0;
+		const int32 write_idx = stream_handoff.getWriteIdx();
+		FProceduralMeshVertexStreams& write_streams = StreamSlots[write_idx];
+		if (write_streams.Num() != point_num)
+		{
+			write_streams.Positions.SetNumUninitialized(point_num);
+			write_streams.Tangents.SetNumUninitialized(2 * point_num);
+			write_streams.TexCoords.SetNumUninitialized(point_num);
+			write_streams.Colors.SetNumUninitialized(point_num);
+			streams_in = EProceduralMeshStream::All;
+			basis_requested = true;
+		}
+
+		// tangents follow the positions, unless the basis is kept flat
+		if ((streams_in & EProceduralMeshStream::Position) && !use_flat_tangents)
 		{
-			VertexCache.Reset(point_num);
-			VertexCache.AddUninitialized(point_num);
+			streams_in |= EProceduralMeshStream::Tangent;
 		}
 
+		// streams changed since this slot was last written come from the last published slot,
+		// which the render thread at most reads
+		const uint8 catch_up_streams = stale_slot_streams[write_idx] & ~streams_in;
+		if (catch_up_streams && (stream_handoff.getPublishedIdx() >= 0))
+		{
+			CopyStreams(StreamSlots[stream_handoff.getPublishedIdx()], write_streams, catch_up_streams);
+		}
+
+		// a rebuilt basis already follows the mirrored points
+		uint8 changed_streams = streams_in;
+		if (flip_tangents && !(streams_in & EProceduralMeshStream::Tangent))
+		{
+			FlipTangents(write_streams);
+			changed_streams |= EProceduralMeshStream::Tangent;
+		}
+		flip_tangents = false;
+
+		const bool write_positions = (streams_in & EProceduralMeshStream::Position) != 0;
+		const bool write_uvs = (streams_in & EProceduralMeshStream::TexCoord) != 0;
+		const bool write_colors = (streams_in & EProceduralMeshStream::Color) != 0;
+
+		// chunked, small meshes stay on this thread
+		const int32 chunk_pts = meshPoseScheduler::getChunkPts();
+		const int32 num_chunks = FMath::DivideAndRoundUp(this->point_num, chunk_pts);
 #ifdef CREATURE_MULTICORE
-		ParallelFor(this->point_num, [&](int32 i) {
+		ParallelFor(num_chunks, [&](int32 chunk_index) {
 #else
-		for (int32 i = 0; i < this->point_num; i++) {
+		for (int32 chunk_index = 0; chunk_index < num_chunks; chunk_index++) {
 #endif
-			FDynamicMeshVertex& curVert = VertexCache[i];
-
-			int pos_idx = i * 3;
-			curVert.Position = FVector(this->points[pos_idx + x_id],
-				this->points[pos_idx + y_id],
-				this->points[pos_idx + z_id]);
+			const int32 end_pt = FMath::Min(this->point_num, (chunk_index + 1) * chunk_pts);
+			for (int32 i = chunk_index * chunk_pts; i < end_pt; i++)
+			{
+				if (write_positions)
+				{
+					int pos_idx = i * 3;
+					write_streams.Positions[i] = FVector(this->points[pos_idx + x_id],
+						this->points[pos_idx + y_id],
+						this->points[pos_idx + z_id]);
+				}
 
-			curVert.Color = (*this->region_colors)[i];
+				if (write_colors)
+				{
+					write_streams.Colors[i] = (*this->region_colors)[i];
+				}
 
-			int uv_idx = i * 2;
-			for (int texCoord = 0; texCoord < MAX_STATIC_TEXCOORDS; texCoord++)
-			{
-				curVert.TextureCoordinate[texCoord].Set(this->uvs[uv_idx], this->uvs[uv_idx + 1]);
+				if (write_uvs)
+				{
+					int uv_idx = i * 2;
+					write_streams.TexCoords[i].Set(this->uvs[uv_idx], this->uvs[uv_idx + 1]);
+				}
 			}
 #ifdef CREATURE_MULTICORE
-		});
+		}, this->point_num < meshPoseScheduler::getMinParallelPts());
 #else
 		}
 #endif
 
 		// Set Tangents
+		if (streams_in & EProceduralMeshStream::Tangent)
+		{
+			// flat mode only pays for this when the basis is built
+			check(!use_flat_tangents || basis_requested);
+			INC_DWORD_STAT(STAT_CreatureTangentPasses);
+
 #ifdef CREATURE_MULTICORE
-		ParallelFor(indices_num / 3, [&](int32 ref_idx) {
-			int32 cur_indice = ref_idx * 3;
+			ParallelFor(indices_num / 3, [&](int32 ref_idx) {
+				int32 cur_indice = ref_idx * 3;
 #else
-		for (int32 cur_indice = 0; cur_indice < indices_num; cur_indice += 3) {
+			for (int32 cur_indice = 0; cur_indice < indices_num; cur_indice += 3) {
 #endif
-			FDynamicMeshVertex & vert0 = VertexCache[(indices[cur_indice])];
-			FDynamicMeshVertex & vert1 = VertexCache[(indices[cur_indice + 1])];
-			FDynamicMeshVertex & vert2 = VertexCache[(indices[cur_indice + 2])];
+				const FVector& pos0 = write_streams.Positions[indices[cur_indice]];
+				const FVector& pos1 = write_streams.Positions[indices[cur_indice + 1]];
+				const FVector& pos2 = write_streams.Positions[indices[cur_indice + 2]];
 
-			const FVector Edge01 = (vert1.Position - vert0.Position);
-			const FVector Edge02 = (vert2.Position - vert0.Position);
+				const FVector Edge01 = (pos1 - pos0);
+				const FVector Edge02 = (pos2 - pos0);
 
-			const FVector TangentX = Edge01.GetSafeNormal();
-			const FVector TangentZ = (Edge02 ^ Edge01).GetSafeNormal();
-			const FVector TangentY = (TangentX ^ TangentZ).GetSafeNormal();
+				const FVector TangentX = Edge01.GetSafeNormal();
+				const FVector TangentZ = (Edge02 ^ Edge01).GetSafeNormal();
+				const FVector TangentY = (TangentX ^ TangentZ).GetSafeNormal();
 
-			vert0.SetTangents(TangentX, TangentY, TangentZ);
-			vert1.SetTangents(TangentX, TangentY, TangentZ);
-			vert2.SetTangents(TangentX, TangentY, TangentZ);
+				const FPackedNormal packed_x(TangentX);
+				const FPackedNormal packed_z(FVector4(TangentZ, GetBasisDeterminantSign(TangentX, TangentY, TangentZ)));
+				for (int32 j = 0; j < 3; j++)
+				{
+					const int32 vert_idx = indices[cur_indice + j];
+					write_streams.Tangents[2 * vert_idx + 0] = packed_x;
+					write_streams.Tangents[2 * vert_idx + 1] = packed_z;
+				}
 #ifdef CREATURE_MULTICORE
-		});
+			}, use_flat_tangents); // the flat basis is built once, keep it deterministic
 #else
-		}
+			}
 #endif
+		}
 
+		// the other slots have to pick up the changed streams, the buffer sets in the ring
+		// find them through the publish serials
+		for (int32 i = 0; i < ProceduralMeshStreamSlots; i++)
+		{
+			stale_slot_streams[i] |= changed_streams;
+		}
+		stale_slot_streams[write_idx] = 0;
+
+		stream_handoff.publish(changed_streams);
 	}
 
 	void UpdateDirectVertexData() const
 	{
 		SCOPE_CYCLE_COUNTER(STAT_UpdateDirectVertexData);
 
-		int32 numReadyVertices = VertexCache.Num();
+		// the newest published slot, the game thread is already building the next one elsewhere
+		const int32 read_idx = stream_handoff.acquireLatest();
+		const FProceduralMeshVertexStreams& read_streams = StreamSlots[read_idx];
+		int32 numReadyVertices = read_streams.Num();
 		check(numReadyVertices == point_num);
 
-		VertexBuffer.Vertices = VertexCache;
-		VertexBuffer.InitRHI();
+		// write into the next set in the ring, the buffers live as long as the packet
+		const int32 next_buffer_idx = (cur_buffer_idx + 1) % VertexBuffers.Num();
+		FProceduralMeshVertexBuffer& next_buffer = VertexBuffers[next_buffer_idx];
+		next_buffer.SetStreams(&read_streams);
+		if (next_buffer.GetNumVertices() != numReadyVertices)
+		{
+			// new buffers mean new views, so the factory has to pick them up again
+			FProceduralMeshVertexFactory& next_factory = VertexFactories[next_buffer_idx];
+			next_factory.ReleaseResource();
+			next_buffer.AllocateBuffers(numReadyVertices);
+			next_factory.InitResource();
+		}
+
+		// streams changed in every publish since this set was last written, skipped ones included
+		next_buffer.StaleStreams |= stream_handoff.getChangedFlags(read_idx, next_buffer.SyncedSerial);
+		next_buffer.SyncedSerial = stream_handoff.getSerial(read_idx);
+		next_buffer.UpdateBuffers(next_buffer.StaleStreams);
+		cur_buffer_idx = next_buffer_idx;
+	}
+
+	const FProceduralMeshVertexBuffer& GetVertexBuffer() const
+	{
+		return VertexBuffers[cur_buffer_idx];
+	}
+
+	const FProceduralMeshVertexFactory& GetVertexFactory() const
+	{
+		return VertexFactories[cur_buffer_idx];
 	}
 
 	void UpdateDirectIndexData() const
@@ -460,9 +784,17 @@ public:
 		RHIUnlockIndexBuffer(IndexBuffer.IndexBufferRHI);
 	}
 
-	mutable FProceduralMeshVertexBuffer VertexBuffer;
+	mutable TIndirectArray<FProceduralMeshVertexBuffer> VertexBuffers;
+	mutable TIndirectArray<FProceduralMeshVertexFactory> VertexFactories;
+	mutable int32 cur_buffer_idx;
+	uint8 pending_streams;
+	FProceduralMeshVertexStreams StreamSlots[ProceduralMeshStreamSlots];
+	mutable meshTripleBufferIndex stream_handoff;
+	// streams each slot missed since it was last written, only touched while building
+	uint8 stale_slot_streams[ProceduralMeshStreamSlots];
+	bool use_flat_tangents, tangents_mirrored, flip_tangents;
+	bool use_compact_format;
 	FProceduralMeshIndexBuffer IndexBuffer;
-	FProceduralMeshVertexFactory VertexFactory;
 	glm::uint32 * indices;
 	glm::float32 * points;
 	glm::float32 * uvs;
@@ -482,8 +814,12 @@ FCProceduralMeshSceneProxy::FCProceduralMeshSceneProxy(
 	MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
 {
 	parentComponent = Component;
+	use_compact_format = Component->compact_vertex_format;
 	needs_index_updating = false;
 	needs_index_update_num = -1;
+	needs_vertex_streams = EProceduralMeshStream::All;
+	use_flat_tangents = false;
+	flat_tangents_mirrored = false;
 	active_render_packet_idx = INDEX_NONE;
 
 	UpdateMaterial();
@@ -518,7 +854,7 @@ FCProceduralMeshSceneProxy::GetActiveRenderPacket()
 
 bool FCProceduralMeshSceneProxy::GetDoesActiveRenderPacketHaveVertices() const
 {
-	return renderPackets.IsValidIndex(active_render_packet_idx) && renderPackets[active_render_packet_idx].VertexCache.Num() > 0;
+	return renderPackets.IsValidIndex(active_render_packet_idx) && renderPackets[active_render_packet_idx].point_num > 0;
 }
 
 void FCProceduralMeshSceneProxy::UpdateMaterial()
@@ -541,16 +877,12 @@ void FCProceduralMeshSceneProxy::AddRenderPacket(FProceduralMeshTriData * target
 	//FProceduralMeshRenderPacket& cur_packet = renderPackets.Add_GetRef(new_packet);
     
 	//auto packetPtr = new(renderPackets) FProceduralMeshRenderPacket(targetTrisIn, featureLevel);
-    renderPackets.Add(new FProceduralMeshRenderPacket(targetTrisIn, featureLevel));
+    renderPackets.Add(new FProceduralMeshRenderPacket(targetTrisIn, featureLevel, use_compact_format));
     auto packetPtr = &renderPackets.Last();
 	auto &cur_packet = *packetPtr;
 
 	auto& IndexBuffer = cur_packet.IndexBuffer;
-	auto& VertexBuffer = cur_packet.VertexBuffer;
-	auto& VertexFactory = cur_packet.VertexFactory;
-
 	IndexBuffer.Indices.SetNum(cur_packet.indices_num);
-	VertexBuffer.Vertices.SetNum(cur_packet.point_num);
 
 	// Set topology/indices
 	for (int32 i = 0; i < cur_packet.indices_num; i++)
@@ -558,49 +890,16 @@ void FCProceduralMeshSceneProxy::AddRenderPacket(FProceduralMeshTriData * target
 		IndexBuffer.Indices[i] = cur_packet.indices[i];
 	}
 
-	const int x_id = 0;
-	const int y_id = 2;
-	const int z_id = 1;
-
-	// Fill initial points
-	for (int32 i = 0; i < cur_packet.point_num; i++)
-	{
-		FDynamicMeshVertex &Vert = VertexBuffer.Vertices[i];
-		int pos_idx = i * 3;
-		Vert.Position = FVector(cur_packet.points[pos_idx + x_id], cur_packet.points[pos_idx + y_id], cur_packet.points[pos_idx + z_id]);
-
-		Vert.Color = startColorIn;
-		Vert.SetTangents(FVector(1, 0, 0), FVector(0, 1, 0), FVector(0, 0, 1));
-
-		int uv_idx = i * 2;
-		for (int texCoord = 0; texCoord < MAX_STATIC_TEXCOORDS; texCoord++)
-		{
-			Vert.TextureCoordinate[texCoord].Set(cur_packet.uvs[uv_idx], cur_packet.uvs[uv_idx + 1]);
-		}
-	}
+	// Start with the given colour, the first update brings in the region colours
+	cur_packet.SetStartColor(startColorIn);
+	cur_packet.SetPendingStreams(EProceduralMeshStream::Color);
 
-	// Set Initial Rest Tangents
-	for (int cur_indice = 0; cur_indice < cur_packet.indices_num; cur_indice += 3)
+	// Init vertex factories
+	for (int32 i = 0; i < cur_packet.VertexFactories.Num(); i++)
 	{
-		FDynamicMeshVertex& vert0 = VertexBuffer.Vertices[cur_packet.indices[cur_indice]];
-		FDynamicMeshVertex& vert1 = VertexBuffer.Vertices[cur_packet.indices[cur_indice + 1]];
-		FDynamicMeshVertex& vert2 = VertexBuffer.Vertices[cur_packet.indices[cur_indice + 2]];
-
-		const FVector Edge01 = (vert1.Position - vert0.Position);
-		const FVector Edge02 = (vert2.Position - vert0.Position);
-
-		const FVector TangentX = Edge01.GetSafeNormal();
-		const FVector TangentZ = (Edge02 ^ Edge01).GetSafeNormal();
-		const FVector TangentY = (TangentX ^ TangentZ).GetSafeNormal();
-
-		vert0.SetTangents(TangentX, TangentY, TangentZ);
-		vert1.SetTangents(TangentX, TangentY, TangentZ);
-		vert2.SetTangents(TangentX, TangentY, TangentZ);
+		cur_packet.VertexFactories[i].InitResource();
 	}
 
-	// Init vertex factory
-	VertexFactory.InitResource();
-
 	// Enqueue initialization of render resource
 	cur_packet.InitForRender();
 
@@ -621,6 +920,12 @@ void FCProceduralMeshSceneProxy::ResetAllRenderPackets()
 void FCProceduralMeshSceneProxy::SetActiveRenderPacketIdx(int idxIn)
 {
 	FScopeLock packetLock(&renderPacketsCS);
+	if ((idxIn != active_render_packet_idx) && renderPackets.IsValidIndex(idxIn))
+	{
+		// the packet missed the stream changes while it was inactive
+		renderPackets[idxIn].SetPendingStreams(EProceduralMeshStream::All);
+	}
+
 	active_render_packet_idx = idxIn;
 }
 
@@ -636,10 +941,17 @@ void FCProceduralMeshSceneProxy::UpdateDynamicComponentData()
 		UpdateMaterial();
 	}
 
-	FScopeLock packetLock(&renderPacketsCS);
+	// packets are only added or removed from this side, and the streams get built in a slot
+	// the render thread never reads, so renderPacketsCS is not held while building
+	FProceduralMeshRenderPacket * cur_packet = nullptr;
+	{
+		FScopeLock packetLock(&renderPacketsCS);
+		cur_packet = &renderPackets[active_render_packet_idx];
+	}
 
-	auto& cur_packet = renderPackets[active_render_packet_idx];
-	cur_packet.CreateDirectVertexData();
+	cur_packet->SetFlatTangents(use_flat_tangents, flat_tangents_mirrored);
+	cur_packet->CreateDirectVertexData(needs_vertex_streams);
+	needs_vertex_streams = EProceduralMeshStream::All;
 }
 
 void FCProceduralMeshSceneProxy::SetNeedsMaterialUpdate(bool flag_in)
@@ -653,10 +965,22 @@ void FCProceduralMeshSceneProxy::SetNeedsIndexUpdate(bool flag_in, int32 index_n
 	needs_index_update_num = index_new_num;
 }
 
+void FCProceduralMeshSceneProxy::SetNeedsVertexStreamUpdate(uint8 streams_in)
+{
+	needs_vertex_streams = streams_in;
+}
+
+void FCProceduralMeshSceneProxy::SetFlatTangents(bool flag_in, bool mirror_in)
+{
+	use_flat_tangents = flag_in;
+	flat_tangents_mirrored = mirror_in;
+}
+
 void FCProceduralMeshSceneProxy::SetDynamicData_RenderThread()
 {
 	SCOPE_CYCLE_COUNTER(STAT_ProceduralMeshSceneProxy_SetDynamicData);
 
+	// only keeps the packet alive, the streams come from the newest published slot
 	FScopeLock packetLock(&renderPacketsCS);
 
 	if (active_render_packet_idx < 0)
@@ -698,9 +1022,9 @@ void FCProceduralMeshSceneProxy::GetDynamicMeshElements(const TArray<const FScen
 	FScopeLock packetLock(&renderPacketsCS);
 
 	auto& cur_packet = renderPackets[active_render_packet_idx];
-	auto& VertexBuffer = cur_packet.VertexBuffer;
+	auto& VertexBuffer = cur_packet.GetVertexBuffer();
 	auto& IndexBuffer = cur_packet.IndexBuffer;
-	auto& VertexFactory = cur_packet.VertexFactory;
+	auto& VertexFactory = cur_packet.GetVertexFactory();
 	const FEngineShowFlags& EngineShowFlags = ViewFamily.EngineShowFlags;
 
 	if (cur_packet.point_num <= 0)
@@ -726,7 +1050,7 @@ void FCProceduralMeshSceneProxy::GetDynamicMeshElements(const TArray<const FScen
 			BatchElement.FirstIndex = 0;
 			BatchElement.NumPrimitives = cur_packet.real_indices_num / 3;
 			BatchElement.MinVertexIndex = 0;
-			BatchElement.MaxVertexIndex = VertexBuffer.Vertices.Num() - 1;
+			BatchElement.MaxVertexIndex = VertexBuffer.GetNumVertices() - 1;
 			Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
 			Mesh.Type = PT_TriangleList;
 			Mesh.DepthPriorityGroup = SDPG_World;
@@ -780,6 +1104,7 @@ UCustomProceduralMeshComponent::UCustomProceduralMeshComponent(const FObjectInit
 	PrimaryComponentTick.bCanEverTick = false;
 	bounds_scale = 1.0f;
 	bounds_offset = FVector(0, 0, 0);
+	compact_vertex_format = false;
 	render_proxy_ready = false;
 	calc_local_vec_min = FVector(FLT_MIN, FLT_MIN, FLT_MIN);
 	calc_local_vec_max = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
@@ -564,6 +564,22 @@ void meshBone::addChild(meshBone * bone_in)
     children.Add(bone_in);
 }
 
+meshBone *
+meshBone::cloneHierarchy() const
+{
+    meshBone * new_bone = new meshBone(*this);
+    new_bone->children.Empty();
+    new_bone->parent = NULL;
+    
+    for(auto i = 0; i < children.Num(); i++) {
+        meshBone * new_child = children[i]->cloneHierarchy();
+        new_child->setParent(new_bone);
+        new_bone->children.Add(new_child);
+    }
+    
+    return new_bone;
+}
+
 bool
 meshBone::hasBone(meshBone * bone_in) const
 {
@@ -628,6 +644,7 @@ meshRenderRegion::meshRenderRegion(glm::uint32 * indices_in,
 	red = 100.0f;
 	green = 100.0f;
 	blue = 100.0f;
+    skin_data = TSharedPtr<meshRenderRegionSkinData>(new meshRenderRegionSkinData());
 
     initUvWarp();
 }
@@ -635,6 +652,25 @@ meshRenderRegion::meshRenderRegion(glm::uint32 * indices_in,
 meshRenderRegion::~meshRenderRegion() {
 }
 
+meshRenderRegion *
+meshRenderRegion::cloneForInstance(glm::float32 * uvs_in) const
+{
+    meshRenderRegion * new_region = new meshRenderRegion(store_indices,
+                                                         store_rest_pts,
+                                                         uvs_in,
+                                                         start_pt_index,
+                                                         end_pt_index,
+                                                         start_index,
+                                                         end_index);
+    new_region->skin_data = skin_data;
+    new_region->main_bone_key = main_bone_key;
+    new_region->use_dq = use_dq;
+    new_region->name = name;
+    new_region->tag_id = tag_id;
+    
+    return new_region;
+}
+
 void meshRenderRegion::setUVLevel(int32 value_in)
 {
 	uv_level = value_in;
@@ -693,13 +729,20 @@ glm::float32 * meshRenderRegion::getUVs() const
 TMap<FName, TArray<float> >&
 meshRenderRegion::getWeights()
 {
-    return normal_weight_map;
+    return skin_data->normal_weight_map;
+}
+
+const TSharedPtr<meshRenderRegionSkinData>&
+meshRenderRegion::getSkinData() const
+{
+    return skin_data;
 }
 
 void
 meshRenderRegion::renameWeightValuesByKey(const FName& old_key,
                                           const FName& new_key)
 {
+    auto& normal_weight_map = skin_data->normal_weight_map;
     if(normal_weight_map.Contains(old_key) == false)
     {
         return;
@@ -708,59 +751,132 @@ meshRenderRegion::renameWeightValuesByKey(const FName& old_key,
     TArray<float> weight_values = normal_weight_map[old_key];
     normal_weight_map.Remove(old_key);
     normal_weight_map.Add(new_key, weight_values);
+    skin_data->fast_bone_keys.Empty();
 }
 
 void
 meshRenderRegion::initFastNormalWeightMap(const TMap<FName, meshBone *>& bones_map)
 {
-    fast_normal_weight_map.Empty();
     fast_bones_map.Empty();
-    reverse_fast_normal_weight_map.Empty();
-    relevant_bones_indices.Empty();
     fill_dq_array.Empty();
     
+    // The fast weight tables are shared with other instances, only the
+    // first region to get here builds them
+    if(skin_data->fast_bone_keys.Num() == bones_map.Num())
+    {
+        for(auto& cur_key : skin_data->fast_bone_keys)
+        {
+            meshBone * const * cur_bone = bones_map.Find(cur_key);
+            if(cur_bone == NULL)
+            {
+                break;
+            }
+            
+            fast_bones_map.Add(*cur_bone);
+        }
+        
+        if(fast_bones_map.Num() == bones_map.Num())
+        {
+            fill_dq_array.SetNumZeroed(fast_bones_map.Num() * 8);
+            return;
+        }
+        
+        fast_bones_map.Empty();
+    }
+    
+    auto& normal_weight_map = skin_data->normal_weight_map;
+    auto& influence_bones = skin_data->influence_bones;
+    auto& influence_weights = skin_data->influence_weights;
+    fast_normal_weight_map.Empty();
+    skin_data->fast_bone_keys.Empty();
+    influence_bones.Empty();
+    influence_weights.Empty();
+    
+    int32 num_weight_pts = 0;
     for(auto& bone_data : bones_map)
     {
         TArray<float> values = normal_weight_map[bone_data.Key];
         fast_normal_weight_map.Add(values);
         
         fast_bones_map.Add(bone_data.Value);
+        skin_data->fast_bone_keys.Add(bone_data.Key);
         
-        if(reverse_fast_normal_weight_map.Num() == 0)
+        if(num_weight_pts == 0)
         {
-            reverse_fast_normal_weight_map.SetNumZeroed(values.Num());
-            relevant_bones_indices.SetNumZeroed(values.Num());
+            num_weight_pts = values.Num();
         }
     }
     
-    fill_dq_array.SetNumZeroed(bones_map.Num());
+    fill_dq_array.SetNumZeroed(bones_map.Num() * 8);
     
-    for(auto i = 0; i < reverse_fast_normal_weight_map.Num(); i++)
+    // Only bones above the cutoff influence a point, pick 4 or 8 slots
+    // from the most influenced point in the region
+    const float cutoff_val = 0.05f;
+    int32 max_relevant = 0;
+    for(auto i = 0; i < num_weight_pts; i++)
     {
-        // reverse normal weight map
-        TArray<float> new_values;
-        new_values.SetNumZeroed(fast_normal_weight_map.Num());
-
+        int32 num_relevant = 0;
         for(auto j = 0; j < fast_normal_weight_map.Num(); j++)
         {
-            new_values[j]  = fast_normal_weight_map[j][i];
+            if(fast_normal_weight_map[j][i] > cutoff_val)
+            {
+                num_relevant++;
+            }
         }
         
-        reverse_fast_normal_weight_map[i] = new_values;
-        
-        // relevant bone indices
-        TArray<int32> relevant_array;
-        const float cutoff_val = 0.05f;
+        max_relevant = FMath::Max(max_relevant, num_relevant);
+    }
+    
+    const int32 num_influences = (max_relevant <= 4) ? 4 : meshRenderRegionSkinData::max_influences;
+    const int32 block_size = MESH_SKINNING_BLOCK_SIZE;
+    const int32 num_blocks = FMath::DivideAndRoundUp(num_weight_pts, block_size);
+    skin_data->num_pts = num_weight_pts;
+    skin_data->influences_per_pt = num_influences;
+    influence_bones.SetNumZeroed(num_blocks * block_size * num_influences);
+    influence_weights.SetNumZeroed(num_blocks * block_size * num_influences);
+    
+    auto& rest_pts = skin_data->rest_pts;
+    rest_pts.SetNumZeroed(num_blocks * block_size * 3);
+    for(auto i = 0; i < num_weight_pts; i++)
+    {
+        const glm::float32 * read_pt = getRestPts() + (i * 3);
+        float * write_pt = rest_pts.GetData() + ((i / block_size) * block_size * 3) + (i % block_size);
+        write_pt[0] = read_pt[0];
+        write_pt[block_size] = read_pt[1];
+        write_pt[2 * block_size] = read_pt[2];
+    }
+    
+    TArray<std::pair<int32, float> > relevant_array;
+    for(auto i = 0; i < num_weight_pts; i++)
+    {
+        relevant_array.Reset();
         for(auto j = 0; j < fast_normal_weight_map.Num(); j++)
         {
             float sample_val = fast_normal_weight_map[j][i];
             if(sample_val > cutoff_val)
             {
-                relevant_array.Add((int32)j);
+                relevant_array.Add(std::make_pair((int32)j, sample_val));
             }
         }
         
-        relevant_bones_indices[i] = relevant_array;
+        // Too many influences, keep the strongest ones in bone order
+        if(relevant_array.Num() > num_influences)
+        {
+            relevant_array.Sort([](const std::pair<int32, float>& a, const std::pair<int32, float>& b) {
+                return a.second > b.second;
+            });
+            relevant_array.SetNum(num_influences);
+            relevant_array.Sort([](const std::pair<int32, float>& a, const std::pair<int32, float>& b) {
+                return a.first < b.first;
+            });
+        }
+        
+        const int32 slot_start = ((i / block_size) * block_size * num_influences) + (i % block_size);
+        for(auto j = 0; j < relevant_array.Num(); j++)
+        {
+            influence_bones[slot_start + (j * block_size)] = relevant_array[j].first;
+            influence_weights[slot_start + (j * block_size)] = relevant_array[j].second;
+        }
     }
     
     fast_normal_weight_map.Empty();
@@ -939,13 +1055,16 @@ meshRenderRegion::initUvWarp()
 
 void
 meshRenderRegion::runUvWarp()
+{
+    runUvWarpRange(0, uv_warp_ref_uvs.Num());
+}
+
+void
+meshRenderRegion::runUvWarpRange(int32 start_pt, int32 end_pt)
 {
     glm::float32 * base_uvs = getUVs();
-#ifdef CREATURE_MULTICORE
-	ParallelFor(uv_warp_ref_uvs.Num(), [&](int32 i) {
-#else
-	for (auto i = 0; i < uv_warp_ref_uvs.Num(); i++) {
-#endif
+    end_pt = FMath::Min(end_pt, uv_warp_ref_uvs.Num());
+	for (auto i = start_pt; i < end_pt; i++) {
 		glm::float32 * cur_uvs = base_uvs + (i * 2);
 
 		glm::vec2 set_uv = uv_warp_ref_uvs[i];
@@ -955,11 +1074,7 @@ meshRenderRegion::runUvWarp()
 
 		cur_uvs[0] = set_uv.x;
 		cur_uvs[1] = set_uv.y;
-#ifdef CREATURE_MULTICORE
-	});
-#else
     }
-#endif
 }
 
 void
@@ -1075,7 +1190,7 @@ void meshRenderRegion::poseFinalPts(glm::float32 * output_pts,
                 cur_weight_val = fast_normal_weight_map[n_index][i];
             }
             else {
-                cur_weight_val = normal_weight_map[cur_key][i];
+                cur_weight_val = skin_data->normal_weight_map[cur_key][i];
             }
             
             float cur_im_weight_val = cur_weight_val;
@@ -1111,7 +1226,7 @@ void meshRenderRegion::poseFinalPts(glm::float32 * output_pts,
             write_pt[1] += post_displacements[i].y;
         }       
 #ifdef CREATURE_MULTICORE
-	});
+	}, getNumPts() < meshPoseScheduler::getMinParallelPts());
 #else
     }
 #endif
@@ -1122,71 +1237,48 @@ void meshRenderRegion::poseFinalPts(glm::float32 * output_pts,
     }
 }
 
+meshSkinningData
+meshRenderRegion::preparePose(glm::float32 * output_pts,
+                              bool try_local_displacements,
+                              bool try_post_displacements)
+{
+    // fill up dqs
+    for(auto i = 0; i < fast_bones_map.Num(); i++)
+    {
+        const dualQuat& world_dq = fast_bones_map[i]->getWorldDq();
+        float * write_dq = fill_dq_array.GetData() + (i * 8);
+        write_dq[0] = world_dq.real.x;
+        write_dq[1] = world_dq.real.y;
+        write_dq[2] = world_dq.real.z;
+        write_dq[3] = world_dq.real.w;
+        write_dq[4] = world_dq.imaginary.x;
+        write_dq[5] = world_dq.imaginary.y;
+        write_dq[6] = world_dq.imaginary.z;
+        write_dq[7] = world_dq.imaginary.w;
+    }
+    
+    meshSkinningData skin_in;
+    skin_in.rest_pts = skin_data->rest_pts.GetData();
+    skin_in.influence_bones = skin_data->influence_bones.GetData();
+    skin_in.influence_weights = skin_data->influence_weights.GetData();
+    skin_in.influences_per_pt = skin_data->influences_per_pt;
+    skin_in.bone_dqs = fill_dq_array.GetData();
+    skin_in.local_displacements = (use_local_displacements && try_local_displacements) ? local_displacements.GetData() : NULL;
+    skin_in.post_displacements = (use_post_displacements && try_post_displacements) ? post_displacements.GetData() : NULL;
+    skin_in.output_pts = output_pts;
+    skin_in.num_pts = skin_data->num_pts;
+    
+    return skin_in;
+}
+
 void meshRenderRegion::poseFastFinalPts(glm::float32 * output_pts,
 										bool try_local_displacements,
 										bool try_post_displacements,
 										bool try_uv_swap)
 {
-	glm::float32 * base_read_pt = getRestPts();
-	glm::float32 * base_write_pt = output_pts;
-    
-    // fill up dqs
-    for(auto i = 0; i < fill_dq_array.Num(); i++)
-    {
-        fill_dq_array[i] = fast_bones_map[i]->getWorldDq();
-    }
-    
-    // pose points
-#ifdef CREATURE_MULTICORE
-	ParallelFor(getNumPts(), [&](int32 i) {
-#else
-	for (int32 i = 0; i < getNumPts(); i++) {
-#endif
-		glm::float32 * read_pt = base_read_pt + (i * 3);
-		glm::float32 * write_pt = base_write_pt + (i * 3);
-        glm::vec4 cur_rest_pt(read_pt[0], read_pt[1], read_pt[2], 1);
-        
-        if(use_local_displacements && try_local_displacements) {
-            cur_rest_pt.x += local_displacements[i].x;
-            cur_rest_pt.y += local_displacements[i].y;
-        }
-        
-        glm::mat4 accum_mat(0);
-        dualQuat accum_dq;
-        
-        const auto& weight_map_vals = reverse_fast_normal_weight_map[i];
-        const auto& bone_indices = relevant_bones_indices[i];
-        
-        for(auto j : bone_indices)
-        {
-            float cur_im_weight_val = weight_map_vals[j];
-            const dualQuat& world_dq = fill_dq_array[j];
-            accum_dq.add(world_dq, cur_im_weight_val, cur_im_weight_val);
-        }
-        
-        glm::vec4 final_pt(0);
-        accum_dq.normalize();
-        final_pt = glm::vec4(accum_dq.transform(glm::vec3(cur_rest_pt)), 1);
-        
-        write_pt[0] = final_pt.x;
-        write_pt[1] = final_pt.y;
-        write_pt[2] = 0;
-        
-		if (use_post_displacements && try_post_displacements)
-		{
-            write_pt[0] += post_displacements[i].x;
-            write_pt[1] += post_displacements[i].y;
-        }       
-#ifdef CREATURE_MULTICORE
-	});
-#else
-	}
-#endif
-    
-    // uv warping
-	if (use_uv_warp && try_uv_swap) {
-        runUvWarp();
-    }
+    meshPoseScheduler region_scheduler;
+    region_scheduler.addRegion(this, output_pts, try_local_displacements, try_post_displacements, try_uv_swap);
+    region_scheduler.run();
 }
 
 // meshRenderBoneComposition
@@ -1235,6 +1327,18 @@ meshRenderBoneComposition::getRootBone()
 void meshRenderBoneComposition::initBoneMap()
 {
     bones_map = meshRenderBoneComposition::genBoneMap(root_bone);
+    
+    bones_list.Reset(bones_map.Num());
+    for(auto& cur_iter : bones_map)
+    {
+        bones_list.Add(cur_iter.Value);
+    }
+}
+
+TArray<meshBone *>&
+meshRenderBoneComposition::getBonesList()
+{
+    return bones_list;
 }
 
 TMap<FName, meshBone *>
@@ -1288,24 +1392,246 @@ void meshRenderBoneComposition::updateAllTransforms(bool update_parent_xf)
     getRootBone()->fixDQs(getRootBone()->getWorldDq());
 }
 
+// meshPoseScheduler
+static int32 pose_min_parallel_pts = 4096;
+static int32 pose_chunk_pts = 1024;
+
+meshPoseScheduler::meshPoseScheduler()
+: total_blocks(0)
+{
+}
+
 void
-meshRenderBoneComposition::resetToWorldRestPts()
+meshPoseScheduler::addRegion(meshRenderRegion * region_in,
+                             glm::float32 * output_pts,
+                             bool try_local_displacements,
+                             bool try_post_displacements,
+                             bool try_uv_swap)
+{
+    meshPoseJob new_job;
+    new_job.region = region_in;
+    new_job.skin_data = region_in->preparePose(output_pts, try_local_displacements, try_post_displacements);
+    new_job.first_block = total_blocks;
+    new_job.num_blocks = FMath::DivideAndRoundUp(new_job.skin_data.num_pts, MESH_SKINNING_BLOCK_SIZE);
+    new_job.run_uv_warp = region_in->getUseUvWarp() && try_uv_swap;
+    
+    if(new_job.num_blocks == 0)
+    {
+        if(new_job.run_uv_warp)
+        {
+            region_in->runUvWarp();
+        }
+        
+        return;
+    }
+    
+    jobs.Add(new_job);
+    total_blocks += new_job.num_blocks;
+}
+
+void
+meshPoseScheduler::addComposition(meshRenderBoneComposition * composition_in,
+                                  glm::float32 * output_pts)
 {
-    getRootBone()->initWorldPts();
+    for(auto cur_region : composition_in->getRegions())
+    {
+        addRegion(cur_region, output_pts + (cur_region->getStartPtIndex() * 3));
+    }
 }
 
+void
+meshPoseScheduler::takeJobs(meshPoseScheduler& scheduler_in)
+{
+    for(auto& cur_job : scheduler_in.jobs)
+    {
+        jobs.Add(cur_job);
+        jobs.Last().first_block += total_blocks;
+    }
+    
+    total_blocks += scheduler_in.total_blocks;
+    scheduler_in.jobs.Reset();
+    scheduler_in.total_blocks = 0;
+}
 
-// meshBoneCache
-meshBoneCache::meshBoneCache(const FName& key_in)
+void
+meshPoseScheduler::run()
 {
-    key = key_in;
+    const meshSkinningMode skin_mode = getMeshSkinningMode();
+    const int32 chunk_blocks = FMath::Max(1, pose_chunk_pts / MESH_SKINNING_BLOCK_SIZE);
+    const int32 num_chunks = FMath::DivideAndRoundUp(total_blocks, chunk_blocks);
+    
+    bool run_parallel = false;
+#ifdef CREATURE_MULTICORE
+    run_parallel = (num_chunks > 1) && (getNumQueuedPts() >= pose_min_parallel_pts);
+#endif
+    
+    if(run_parallel)
+    {
+        ParallelFor(num_chunks, [&](int32 i) {
+            runBlocks(i * chunk_blocks, FMath::Min(total_blocks, (i + 1) * chunk_blocks), skin_mode);
+        });
+    }
+    else
+    {
+        runBlocks(0, total_blocks, skin_mode);
+    }
+    
+    jobs.Reset();
+    total_blocks = 0;
+}
+
+void
+meshPoseScheduler::runBlocks(int32 start_block, int32 end_block, meshSkinningMode skin_mode)
+{
+    // find the job holding start_block
+    int32 low = 0, high = jobs.Num() - 1;
+    while(low < high)
+    {
+        int32 mid = (low + high + 1) / 2;
+        if(jobs[mid].first_block <= start_block)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+    
+    int32 cur_block = start_block;
+    for(int32 job_index = low; (job_index < jobs.Num()) && (cur_block < end_block); job_index++)
+    {
+        const meshPoseJob& cur_job = jobs[job_index];
+        const int32 job_end_block = FMath::Min(end_block, cur_job.first_block + cur_job.num_blocks);
+        for(int32 i = cur_block; i < job_end_block; i++)
+        {
+            meshSkinBlock(cur_job.skin_data, i - cur_job.first_block, skin_mode);
+        }
+        
+        if(cur_job.run_uv_warp)
+        {
+            cur_job.region->runUvWarpRange((cur_block - cur_job.first_block) * MESH_SKINNING_BLOCK_SIZE,
+                                           (job_end_block - cur_job.first_block) * MESH_SKINNING_BLOCK_SIZE);
+        }
+        
+        cur_block = job_end_block;
+    }
+}
+
+int32
+meshPoseScheduler::getNumQueuedPts() const
+{
+    return total_blocks * MESH_SKINNING_BLOCK_SIZE;
+}
+
+void
+meshPoseScheduler::setMinParallelPts(int32 value_in)
+{
+    pose_min_parallel_pts = value_in;
+}
+
+int32
+meshPoseScheduler::getMinParallelPts()
+{
+    return pose_min_parallel_pts;
+}
+
+void
+meshPoseScheduler::setChunkPts(int32 value_in)
+{
+    pose_chunk_pts = FMath::Max(MESH_SKINNING_BLOCK_SIZE, value_in);
+}
+
+int32
+meshPoseScheduler::getChunkPts()
+{
+    return pose_chunk_pts;
+}
+
+meshTripleBufferIndex::meshTripleBufferIndex()
+    : write_idx(0), read_idx(1), published_idx(-1), cur_serial(0), ready_state(2), has_published(false)
+{
+    FMemory::Memzero(flag_serials, sizeof(flag_serials));
+    FMemory::Memzero(slot_serials, sizeof(slot_serials));
+    FMemory::Memzero(slot_flag_serials, sizeof(slot_flag_serials));
+}
+
+int32
+meshTripleBufferIndex::getWriteIdx() const
+{
+    return write_idx;
 }
 
-meshBoneCache::~meshBoneCache()
+int32
+meshTripleBufferIndex::getPublishedIdx() const
+{
+    return published_idx;
+}
+
+void
+meshTripleBufferIndex::publish(uint32 changed_flags)
+{
+    // the serials are written with the slot, so the reader gets them along with its data
+    cur_serial++;
+    for(int32 i = 0; i < max_flags; i++) {
+        if(changed_flags & (1 << i)) {
+            flag_serials[i] = cur_serial;
+        }
+    }
+    
+    slot_serials[write_idx] = cur_serial;
+    FMemory::Memcpy(slot_flag_serials[write_idx], flag_serials, sizeof(flag_serials));
+    
+    // the slot the reader did not take becomes the next one to write
+    published_idx = write_idx;
+    int32 old_state = ready_state.exchange(write_idx | ready_fresh_bit, std::memory_order_acq_rel);
+    write_idx = old_state & ready_index_mask;
+    has_published.store(true, std::memory_order_release);
+}
+
+int32
+meshTripleBufferIndex::acquireLatest()
+{
+    if(ready_state.load(std::memory_order_acquire) & ready_fresh_bit) {
+        int32 old_state = ready_state.exchange(read_idx, std::memory_order_acq_rel);
+        read_idx = old_state & ready_index_mask;
+    }
+    
+    return read_idx;
+}
+
+bool
+meshTripleBufferIndex::hasPublished() const
+{
+    return has_published.load(std::memory_order_acquire);
+}
+
+uint32
+meshTripleBufferIndex::getSerial(int32 slot_idx) const
+{
+    return slot_serials[slot_idx];
+}
+
+uint32
+meshTripleBufferIndex::getChangedFlags(int32 slot_idx, uint32 since_serial) const
 {
+    uint32 changed_flags = 0;
+    for(int32 i = 0; i < max_flags; i++) {
+        if(slot_flag_serials[slot_idx][i] > since_serial) {
+            changed_flags |= (1 << i);
+        }
+    }
     
+    return changed_flags;
+}
+
+void
+meshRenderBoneComposition::resetToWorldRestPts()
+{
+    getRootBone()->initWorldPts();
 }
 
+
 // meshDisplacementCache
 meshDisplacementCache::meshDisplacementCache(const FName& key_in)
 {
@@ -1381,56 +1707,251 @@ meshUVWarpCache::getUvWarpScale() const
     return uv_warp_scale;
 }
 
-// meshBoneCacheManager
-meshBoneCacheManager::meshBoneCacheManager()
-{
-    is_ready = false;
-}
-
-meshBoneCacheManager::~meshBoneCacheManager()
+// meshCacheKeyframes
+meshCacheKeyframes::meshCacheKeyframes()
+: start_time(0), num_frames(0)
 {
     
 }
 
-void
-meshBoneCacheManager::init(int32 start_time_in, int32 end_time_in)
+bool
+meshCacheKeyframes::init(int32 start_time_in, int32 end_time_in, const TArray<int32>& key_times_in)
 {
     start_time = start_time_in;
-    end_time = end_time_in;
+    num_frames = end_time_in - start_time_in + 1;
+    key_times.Empty();
+    frame_keys.Empty();
     
-    int32 num_frames = end_time - start_time + 1;
-    bone_cache_table.Empty();
-    bone_cache_table.SetNumZeroed(num_frames);
+    for(auto i = 0; i < key_times_in.Num(); i++) {
+        if((key_times_in[i] < start_time_in) || (key_times_in[i] > end_time_in)
+           || ((i > 0) && (key_times_in[i] <= key_times_in[i - 1])))
+        {
+            return false;
+        }
+    }
     
-    bone_cache_data_ready.Empty();
-    bone_cache_data_ready.SetNumZeroed(num_frames);
-    for(auto i = 0; i < bone_cache_data_ready.Num(); i++) {
-        bone_cache_data_ready[i] = false;
+    // every frame is keyed
+    if((key_times_in.Num() == 0) || (key_times_in.Num() == num_frames)) {
+        return true;
     }
     
-    is_ready = false;
+    key_times = key_times_in;
+    frame_keys.SetNumUninitialized(num_frames);
+    int32 cur_key = 0;
+    for(auto i = 0; i < num_frames; i++) {
+        while(((cur_key + 1) < key_times.Num()) && (key_times[cur_key + 1] <= (start_time + i))) {
+            cur_key++;
+        }
+        
+        frame_keys[i] = cur_key;
+    }
+    
+    return true;
 }
 
-void
-meshBoneCacheManager::makeAllReady()
+bool
+meshCacheKeyframes::isSparse() const
 {
-    for(auto i = 0; i < bone_cache_data_ready.Num(); i++) {
-        bone_cache_data_ready[i] = true;
-    }
+    return frame_keys.Num() > 0;
 }
 
-TArray<TArray<meshBoneCache> >&
-meshBoneCacheManager::getCacheTable()
+int32
+meshCacheKeyframes::getNumFrames() const
 {
-    return bone_cache_table;
+    return isSparse() ? key_times.Num() : num_frames;
 }
 
-int32 meshBoneCacheManager::getStartTime() const
+const TArray<int32>&
+meshCacheKeyframes::getKeyTimes() const
 {
-    return start_time;
+    return key_times;
 }
 
-int32 meshBoneCacheManager::getEndime() const
+int32
+meshCacheKeyframes::getKeyAtTime(int32 time_in) const
+{
+    return frame_keys[clipNumber(time_in - start_time, 0, frame_keys.Num() - 1)];
+}
+
+void
+meshCacheKeyframes::getKeysAtTime(float time_in, int32& base_key, int32& end_key, float& ratio) const
+{
+    base_key = getKeyAtTime((int32)floorf(time_in));
+    end_key = FMath::Min(base_key + 1, key_times.Num() - 1);
+    
+    const int32 key_span = key_times[end_key] - key_times[base_key];
+    ratio = (key_span > 0) ?
+        FMath::Clamp((time_in - (float)key_times[base_key]) / (float)key_span, 0.0f, 1.0f) : 0.0f;
+}
+
+int64
+meshCacheKeyframes::getAllocatedSize() const
+{
+    return (int64)(key_times.GetAllocatedSize() + frame_keys.GetAllocatedSize());
+}
+
+// Bytes of a per frame cache table, the rows and every entry
+template <typename CacheType>
+static int64 getCacheTableSize(const TArray<TArray<CacheType> >& table_in, const TArray<bool>& ready_in)
+{
+    int64 retval = (int64)(table_in.GetAllocatedSize() + ready_in.GetAllocatedSize());
+    for(auto& cur_row : table_in) {
+        retval += (int64)cur_row.GetAllocatedSize();
+    }
+    
+    return retval;
+}
+
+// meshBoneCacheManager
+static const int32 bone_cache_values_per_key = 4;
+
+meshBoneCacheManager::meshBoneCacheManager()
+: start_time(0), end_time(0)
+{
+    is_ready = false;
+}
+
+meshBoneCacheManager::~meshBoneCacheManager()
+{
+    
+}
+
+void
+meshBoneCacheManager::init(int32 start_time_in, int32 end_time_in)
+{
+    start_time = start_time_in;
+    end_time = end_time_in;
+    flat_view = meshCacheFlatView();
+    keyframes.init(start_time, end_time, TArray<int32>());
+    bone_data.Empty();
+    bone_frame_counts.Empty();
+    is_ready = false;
+}
+
+bool
+meshBoneCacheManager::initKeyframes(const TArray<int32>& key_times_in)
+{
+    return keyframes.init(start_time, end_time, key_times_in);
+}
+
+const meshCacheKeyframes&
+meshBoneCacheManager::getKeyframes() const
+{
+    return keyframes;
+}
+
+void
+meshBoneCacheManager::initKeys(const TArray<FName>& keys_in)
+{
+    const int32 num_frames = getNumFrames();
+    flat_view.keys = keys_in;
+    flat_view.num_frames = num_frames;
+    flat_view.frame_stride = keys_in.Num() * bone_cache_values_per_key;
+    flat_view.key_offsets.SetNumUninitialized(keys_in.Num());
+    for(auto i = 0; i < keys_in.Num(); i++) {
+        flat_view.key_offsets[i] = i * bone_cache_values_per_key;
+    }
+    
+    bone_data.Empty();
+    bone_data.SetNumZeroed(num_frames * flat_view.frame_stride);
+    bone_frame_counts.Empty();
+    bone_frame_counts.SetNumZeroed(num_frames);
+    pointViewAtData();
+    is_ready = false;
+}
+
+bool
+meshBoneCacheManager::ownsData() const
+{
+    return bone_frame_counts.Num() > 0;
+}
+
+void
+meshBoneCacheManager::pointViewAtData()
+{
+    flat_view.data = bone_data.GetData();
+    flat_view.frame_counts = bone_frame_counts.GetData();
+}
+
+void
+meshBoneCacheManager::makeAllReady()
+{
+    for(auto i = 0; i < bone_frame_counts.Num(); i++) {
+        bone_frame_counts[i] = flat_view.keys.Num();
+    }
+}
+
+void
+meshBoneCacheManager::setFrameValue(int32 frame_index, int32 key_index,
+                                    const glm::vec4& start_pt, const glm::vec4& end_pt)
+{
+    float * set_data = bone_data.GetData() + (frame_index * flat_view.frame_stride) + (key_index * bone_cache_values_per_key);
+    set_data[0] = start_pt.x;
+    set_data[1] = start_pt.y;
+    set_data[2] = end_pt.x;
+    set_data[3] = end_pt.y;
+}
+
+void
+meshBoneCacheManager::setFrameReady(int32 frame_index)
+{
+    bone_frame_counts[frame_index] = flat_view.keys.Num();
+}
+
+bool
+meshBoneCacheManager::isFrameReady(int32 frame_index) const
+{
+    return flat_view.isValid() && flat_view.hasFrame(frame_index);
+}
+
+const float *
+meshBoneCacheManager::getFrameData(int32 frame_index) const
+{
+    return flat_view.data + (int64)frame_index * flat_view.frame_stride;
+}
+
+int32
+meshBoneCacheManager::getNumFrames() const
+{
+    return keyframes.getNumFrames();
+}
+
+int32
+meshBoneCacheManager::getNumKeys() const
+{
+    return flat_view.keys.Num();
+}
+
+int32
+meshBoneCacheManager::getKeyIndex(const FName& key_in) const
+{
+    return flat_view.keys.Find(key_in);
+}
+
+void
+meshBoneCacheManager::initFlatView(int32 start_time_in, int32 end_time_in, const meshCacheFlatView& view_in)
+{
+    init(start_time_in, end_time_in);
+    if(!view_in.isValid()) {
+        return;
+    }
+    
+    flat_view = view_in;
+    is_ready = true;
+}
+
+bool
+meshBoneCacheManager::hasFlatView() const
+{
+    return flat_view.isValid() && !ownsData();
+}
+
+int32 meshBoneCacheManager::getStartTime() const
+{
+    return start_time;
+}
+
+int32 meshBoneCacheManager::getEndime() const
 {
     return end_time;
 }
@@ -1438,31 +1959,94 @@ int32 meshBoneCacheManager::getEndime() const
 int32
 meshBoneCacheManager::getIndexByTime(int32 time_in) const
 {
+    if(keyframes.isSparse()) {
+        return keyframes.getKeyAtTime(time_in);
+    }
+    
     int32 retval = time_in - start_time;
-    retval = clipNumber(retval, 0, (int32)bone_cache_table.Num() - 1);
+    retval = clipNumber(retval, 0, getNumFrames() - 1);
 
     return retval;
 }
 
+void
+meshBoneCacheManager::getFramesAtTime(float time_in, int32& base_frame, int32& end_frame, float& ratio) const
+{
+    if(keyframes.isSparse()) {
+        keyframes.getKeysAtTime(time_in, base_frame, end_frame, ratio);
+        return;
+    }
+    
+    base_frame = getIndexByTime((int32)floorf(time_in));
+    end_frame = getIndexByTime((int32)ceilf(time_in));
+    ratio = (time_in - (float)floorf(time_in));
+}
+
+void
+meshBoneCacheManager::makeDense()
+{
+    if(!keyframes.isSparse()) {
+        return;
+    }
+    
+    const int32 num_frames = end_time - start_time + 1;
+    const int32 frame_stride = flat_view.frame_stride;
+    TArray<float> new_data;
+    TArray<int32> new_frame_counts;
+    new_data.SetNumZeroed(num_frames * frame_stride);
+    new_frame_counts.SetNumZeroed(num_frames);
+    for(auto i = 0; i < num_frames; i++) {
+        int32 base_frame = 0, end_frame = 0;
+        float ratio = 0;
+        keyframes.getKeysAtTime((float)(start_time + i), base_frame, end_frame, ratio);
+        if(!isFrameReady(base_frame) || !isFrameReady(end_frame)) {
+            continue;
+        }
+        
+        const float * base_row = getFrameData(base_frame);
+        const float * end_row = getFrameData(end_frame);
+        float * set_row = new_data.GetData() + (int64)i * frame_stride;
+        for(auto j = 0; j < frame_stride; j++) {
+            set_row[j] = ((1.0f - ratio) * base_row[j]) + (ratio * end_row[j]);
+        }
+        
+        new_frame_counts[i] = flat_view.keys.Num();
+    }
+    
+    keyframes.init(start_time, end_time, TArray<int32>());
+    bone_data = new_data;
+    bone_frame_counts = new_frame_counts;
+    flat_view.num_frames = num_frames;
+    pointViewAtData();
+}
+
 void
 meshBoneCacheManager::setValuesAtTime(int32 time_in,
                                       TMap<FName, meshBone *>& bone_map)
 {
-    TArray<meshBoneCache> cache_list;
+    if(!ownsData()) {
+        // cooked views are read only
+        if(flat_view.isValid()) {
+            return;
+        }
+        
+        TArray<FName> new_keys;
+        bone_map.GetKeys(new_keys);
+        initKeys(new_keys);
+    }
+    
+    makeDense();
+    
     int32 set_index = getIndexByTime(time_in);
-    for(auto& cur_iter : bone_map)
+    for(auto i = 0; i < flat_view.keys.Num(); i++)
     {
-        const FName& cur_key = cur_iter.Key;
-        meshBone * cur_bone = cur_iter.Value;
-        
-        meshBoneCache new_cache(cur_key);
-        new_cache.setWorldStartPt(cur_bone->getWorldStartPt());
-        new_cache.setWorldEndPt(cur_bone->getWorldEndPt());
-        cache_list.Add(new_cache);
+        meshBone * cur_bone = bone_map.FindRef(flat_view.keys[i]);
+        if(cur_bone) {
+            setFrameValue(set_index, i, cur_bone->getWorldStartPt(), cur_bone->getWorldEndPt());
+        }
     }
     
-    bone_cache_table[set_index] = cache_list;
-    bone_cache_data_ready[set_index] = true;    
+    setFrameReady(set_index);
 }
 
 bool
@@ -1472,10 +2056,10 @@ meshBoneCacheManager::allReady()
         return true;
     }
     else {
-        int32 num_frames = end_time - start_time + 1;
+        int32 num_frames = getNumFrames();
         int32 ready_cnt = 0;
-        for(auto i = 0; i < bone_cache_data_ready.Num(); i++) {
-            if(bone_cache_data_ready[i]) {
+        for(auto i = 0; i < bone_frame_counts.Num(); i++) {
+            if(bone_frame_counts[i] != 0) {
                 ready_cnt++;
             }
         }
@@ -1492,82 +2076,83 @@ void
 meshBoneCacheManager::retrieveValuesAtTime(float time_in,
                                            TMap<FName, meshBone *>& bone_map)
 {
-	SCOPE_CYCLE_COUNTER(STAT_MeshBoneCacheManager_retrieveValuesAtTime);
+    retrieveBoundValuesAtTime(time_in, [&bone_map](int32, const FName& key_in) {
+        return bone_map.FindRef(key_in);
+    });
+}
 
-    int32 base_time = getIndexByTime((int32)floorf(time_in));
-    int32 final_time = getIndexByTime((int32)ceilf(time_in));
+void
+meshBoneCacheManager::retrieveValuesAtTime(float time_in,
+                                           const TArray<meshBone *>& bones_list,
+                                           const TArray<int32>& bone_indices)
+{
+    retrieveBoundValuesAtTime(time_in, [&bones_list, &bone_indices](int32 entry_index, const FName&) {
+        const int32 bone_index = bone_indices[entry_index];
+        return (bone_index >= 0) ? bones_list[bone_index] : nullptr;
+    });
+}
+
+void
+meshBoneCacheManager::getKeys(TArray<FName>& out_keys)
+{
+    out_keys = flat_view.keys;
+}
+
+int64
+meshBoneCacheManager::getAllocatedSize() const
+{
+    return (int64)(bone_data.GetAllocatedSize() + bone_frame_counts.GetAllocatedSize())
+        + flat_view.getAllocatedSize() + keyframes.getAllocatedSize();
+}
+
+template <typename GetBoneFunc>
+void
+meshBoneCacheManager::retrieveBoundValuesAtTime(float time_in, GetBoneFunc get_bone)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MeshBoneCacheManager_retrieveValuesAtTime);
 
-    float ratio = (time_in - (float)floorf(time_in));
+    int32 base_time = 0, final_time = 0;
+    float ratio = 0;
+    getFramesAtTime(time_in, base_time, final_time, ratio);
 
-    if(bone_cache_data_ready.Num() == 0) {
+    if(!isFrameReady(base_time) || !isFrameReady(final_time)) {
         return;
     }
     
-    if((bone_cache_data_ready[base_time] == false)
-       || (bone_cache_data_ready[final_time] == false))
-    {
-        return;
+    // each bone is one 4 wide blend of its two rows
+    const glm::vec4 * base_row = (const glm::vec4 *)getFrameData(base_time);
+    const glm::vec4 * end_row = (const glm::vec4 *)getFrameData(final_time);
+    for(auto i = 0; i < flat_view.keys.Num(); i++) {
+        meshBone * set_bone = get_bone(i, flat_view.keys[i]);
+        if(set_bone) {
+            glm::vec4 final_pts = ((1.0f - ratio) * base_row[i]) + (ratio * end_row[i]);
+            set_bone->setWorldStartPt(glm::vec4(final_pts.x, final_pts.y, 0, 1.0f));
+            set_bone->setWorldEndPt(glm::vec4(final_pts.z, final_pts.w, 0, 1.0f));
+        }
     }
-    
-    TArray<meshBoneCache>& base_cache = bone_cache_table[base_time];
-    TArray<meshBoneCache>& end_cache = bone_cache_table[final_time];
-    
-    for(auto i = 0; i < base_cache.Num(); i++) {
-        const meshBoneCache& base_data = base_cache[i];
-        const meshBoneCache& end_data = end_cache[i];
-        const FName& cur_key = base_data.getKey();
-        
-        glm::vec4 final_world_start_pt = ((1.0f - ratio) * base_data.getWorldStartPt()) +
-                                        (ratio * end_data.getWorldStartPt());
-        
-        glm::vec4 final_world_end_pt = ((1.0f - ratio) * base_data.getWorldEndPt()) +
-                                        (ratio * end_data.getWorldEndPt());
-        
-        bone_map[cur_key]->setWorldStartPt(final_world_start_pt);
-        bone_map[cur_key]->setWorldEndPt(final_world_end_pt);
-    }    
 }
 
 std::pair<glm::vec4, glm::vec4>
 meshBoneCacheManager::retrieveSingleBoneValueAtTime(const FName& key_in,
 	float time_in)
 {
-	int32 base_time = getIndexByTime((int32)floorf(time_in));
-	int32 final_time = getIndexByTime((int32)ceilf(time_in));
-	float ratio = (time_in - (float)floorf(time_in));
+	int32 base_time = 0, final_time = 0;
+	float ratio = 0;
+	getFramesAtTime(time_in, base_time, final_time, ratio);
 	std::pair<glm::vec4, glm::vec4> ret_data;
 
-	if (bone_cache_data_ready.Num() == 0) {
-		return ret_data;
-	}
-
-	if ((bone_cache_data_ready[base_time] == false)
-		|| (bone_cache_data_ready[final_time] == false))
+	int32 key_index = getKeyIndex(key_in);
+	if ((key_index < 0) || !isFrameReady(base_time) || !isFrameReady(final_time))
 	{
 		return ret_data;
 	}
 
-	TArray<meshBoneCache>& base_cache = bone_cache_table[base_time];
-	TArray<meshBoneCache>& end_cache = bone_cache_table[final_time];
-
-	for (auto i = 0; i < base_cache.Num(); i++) {
-		const meshBoneCache& base_data = base_cache[i];
-		const meshBoneCache& end_data = end_cache[i];
-		const FName& cur_key = base_data.getKey();
-
-		if (cur_key == key_in) {
-			glm::vec4 final_world_start_pt = ((1.0f - ratio) * base_data.getWorldStartPt()) +
-				(ratio * end_data.getWorldStartPt());
-
-			glm::vec4 final_world_end_pt = ((1.0f - ratio) * base_data.getWorldEndPt()) +
-				(ratio * end_data.getWorldEndPt());
-
-			ret_data.first = final_world_start_pt;
-			ret_data.second = final_world_end_pt;
+	const glm::vec4& base_data = ((const glm::vec4 *)getFrameData(base_time))[key_index];
+	const glm::vec4& end_data = ((const glm::vec4 *)getFrameData(final_time))[key_index];
+	glm::vec4 final_pts = ((1.0f - ratio) * base_data) + (ratio * end_data);
 
-			break;
-		}
-	}
+	ret_data.first = glm::vec4(final_pts.x, final_pts.y, 0, 1.0f);
+	ret_data.second = glm::vec4(final_pts.z, final_pts.w, 0, 1.0f);
 
 	return ret_data;
 }
@@ -1577,6 +2162,7 @@ meshBoneCacheManager::retrieveSingleBoneValueAtTime(const FName& key_in,
 meshDisplacementCacheManager::meshDisplacementCacheManager()
 {
     is_ready = false;
+    table_unpacked = false;
 }
 
 meshDisplacementCacheManager::~meshDisplacementCacheManager()
@@ -1588,6 +2174,13 @@ void meshDisplacementCacheManager::init(int32 start_time_in, int32 end_time_in)
 {
     start_time = start_time_in;
     end_time = end_time_in;
+    flat_view = meshCacheFlatView();
+    keyframes.init(start_time, end_time, TArray<int32>());
+    quantized_view = meshQuantizedDisplacementView();
+    quantized_ranges.Empty();
+    quantized_frame_counts.Empty();
+    quantized_values.Empty();
+    table_unpacked = false;
     
     int32 num_frames = end_time - start_time + 1;
     displacement_cache_table.Empty();
@@ -1603,6 +2196,31 @@ void meshDisplacementCacheManager::init(int32 start_time_in, int32 end_time_in)
 
 }
 
+bool
+meshDisplacementCacheManager::initKeyframes(const TArray<int32>& key_times_in)
+{
+    if(!keyframes.init(start_time, end_time, key_times_in)) {
+        return false;
+    }
+    
+    if(!hasPackedView()) {
+        const int32 num_frames = keyframes.getNumFrames();
+        displacement_cache_table.Empty();
+        displacement_cache_table.SetNumZeroed(num_frames);
+        displacement_cache_data_ready.Empty();
+        displacement_cache_data_ready.SetNumZeroed(num_frames);
+        is_ready = false;
+    }
+    
+    return true;
+}
+
+const meshCacheKeyframes&
+meshDisplacementCacheManager::getKeyframes() const
+{
+    return keyframes;
+}
+
 void
 meshDisplacementCacheManager::makeAllReady()
 {
@@ -1614,9 +2232,382 @@ meshDisplacementCacheManager::makeAllReady()
 TArray<TArray<meshDisplacementCache> >&
 meshDisplacementCacheManager::getCacheTable()
 {
+    if(hasPackedView()) {
+        unpackFlatView();
+    }
+    
     return displacement_cache_table;
 }
 
+void
+meshDisplacementCacheManager::initFlatView(int32 start_time_in, int32 end_time_in, const meshCacheFlatView& view_in,
+                                           const TArray<int32>& local_counts_in, const TArray<int32>& post_counts_in)
+{
+    if(!view_in.isValid()) {
+        init(start_time_in, end_time_in);
+        return;
+    }
+    
+    init(start_time_in, end_time_in);
+    displacement_cache_table.Empty();
+    displacement_cache_data_ready.Empty();
+    flat_view = view_in;
+    flat_local_counts = local_counts_in;
+    flat_post_counts = post_counts_in;
+    is_ready = true;
+}
+
+bool
+meshDisplacementCacheManager::hasFlatView() const
+{
+    return hasPackedView() && flat_view.isValid();
+}
+
+void
+meshDisplacementCacheManager::getFirstFrameDisplacementUse(int32 entry_index, bool& out_use_local, bool& out_use_post)
+{
+    out_use_local = out_use_post = false;
+    if(hasQuantizedView()) {
+        const meshCacheFlatView& ranges = quantized_view.ranges;
+        if((ranges.num_frames > 0) && ranges.hasFrame(0) && ranges.keys.IsValidIndex(entry_index)) {
+            out_use_local = (quantized_view.local_counts[entry_index] > 0);
+            out_use_post = (quantized_view.post_counts[entry_index] > 0);
+        }
+        
+        return;
+    }
+    
+    if(hasFlatView()) {
+        if((flat_view.num_frames > 0) && flat_view.hasFrame(0) && flat_view.keys.IsValidIndex(entry_index)) {
+            out_use_local = (flat_local_counts[entry_index] > 0);
+            out_use_post = (flat_post_counts[entry_index] > 0);
+        }
+        
+        return;
+    }
+    
+    if((displacement_cache_table.Num() > 0) && displacement_cache_table[0].IsValidIndex(entry_index)) {
+        const meshDisplacementCache& cur_data = displacement_cache_table[0][entry_index];
+        out_use_local = (cur_data.getLocalDisplacements().Num() > 0);
+        out_use_post = (cur_data.getPostDisplacements().Num() > 0);
+    }
+}
+
+bool
+meshDisplacementCacheManager::hasPackedView() const
+{
+    return (flat_view.isValid() || quantized_view.isValid()) && !table_unpacked.load(std::memory_order_acquire);
+}
+
+template <typename T>
+static void dequantizeDisplacements(const T * src_values,
+                                    const float * src_range,
+                                    int32 num_pts,
+                                    TArray<glm::vec2>& displacements)
+{
+    const glm::vec2 min_val(src_range[0], src_range[1]);
+    const glm::vec2 step_val(src_range[2], src_range[3]);
+    displacements.SetNumUninitialized(num_pts);
+    for(auto j = 0; j < num_pts; j++) {
+        displacements[j] = min_val + (step_val * glm::vec2((float)src_values[j * 2], (float)src_values[j * 2 + 1]));
+    }
+}
+
+template <typename T>
+static void unpackQuantizedView(const meshQuantizedDisplacementView& src_view,
+                                TArray<TArray<meshDisplacementCache> >& table_out)
+{
+    const meshCacheFlatView& ranges = src_view.ranges;
+    for(auto i = 0; i < ranges.num_frames; i++) {
+        if(!ranges.hasFrame(i)) {
+            continue;
+        }
+        
+        TArray<meshDisplacementCache>& cache_list = table_out[i];
+        cache_list.Reserve(ranges.keys.Num());
+        for(auto j = 0; j < ranges.keys.Num(); j++) {
+            const float * src_range = ranges.getEntry(i, j);
+            const T * src_values = (const T *)src_view.getValues(i, j);
+            const int32 num_local = src_view.local_counts[j];
+            meshDisplacementCache new_cache(ranges.keys[j]);
+            
+            TArray<glm::vec2> cur_displacements;
+            dequantizeDisplacements(src_values, src_range, num_local, cur_displacements);
+            new_cache.setLocalDisplacements(cur_displacements);
+            
+            dequantizeDisplacements(src_values + num_local * 2, src_range + 4, src_view.post_counts[j], cur_displacements);
+            new_cache.setPostDisplacements(cur_displacements);
+            
+            cache_list.Add(new_cache);
+        }
+    }
+}
+
+void
+meshDisplacementCacheManager::unpackFlatView()
+{
+    // Other users of the animation may be reading the view, so it is left as it is and
+    // the table is built on the side, then handed over to readers in one step
+    FScopeLock scope_lock(&data_lock);
+    if(!hasPackedView()) {
+        return;
+    }
+    
+    TArray<TArray<meshDisplacementCache> > new_table;
+    if(quantized_view.isValid()) {
+        new_table.SetNum(quantized_view.ranges.num_frames);
+        if(quantized_view.value_bits == 16) {
+            unpackQuantizedView<uint16>(quantized_view, new_table);
+        }
+        else {
+            unpackQuantizedView<uint8>(quantized_view, new_table);
+        }
+    }
+    else {
+        new_table.SetNum(keyframes.getNumFrames());
+        for(auto i = 0; i < flat_view.num_frames; i++) {
+            if(!flat_view.hasFrame(i)) {
+                continue;
+            }
+            
+            TArray<meshDisplacementCache>& cache_list = new_table[i];
+            cache_list.Reserve(flat_view.keys.Num());
+            for(auto j = 0; j < flat_view.keys.Num(); j++) {
+                const glm::vec2 * src_data = (const glm::vec2 *)flat_view.getEntry(i, j);
+                meshDisplacementCache new_cache(flat_view.keys[j]);
+                
+                TArray<glm::vec2> cur_displacements;
+                cur_displacements.Append(src_data, flat_local_counts[j]);
+                new_cache.setLocalDisplacements(cur_displacements);
+                
+                cur_displacements.Reset();
+                cur_displacements.Append(src_data + flat_local_counts[j], flat_post_counts[j]);
+                new_cache.setPostDisplacements(cur_displacements);
+                
+                cache_list.Add(new_cache);
+            }
+        }
+    }
+    
+    displacement_cache_table = new_table;
+    displacement_cache_data_ready.Init(true, keyframes.getNumFrames());
+    is_ready = true;
+    table_unpacked.store(true, std::memory_order_release);
+}
+
+void
+meshQuantizedDisplacementView::initLayout()
+{
+    const int32 value_bytes = value_bits / 8;
+    ranges.key_offsets.SetNumUninitialized(ranges.keys.Num());
+    value_offsets.SetNumUninitialized(ranges.keys.Num());
+    frame_bytes = 0;
+    for(auto i = 0; i < ranges.keys.Num(); i++) {
+        ranges.key_offsets[i] = i * 8;
+        value_offsets[i] = frame_bytes;
+        frame_bytes += (local_counts[i] + post_counts[i]) * 2 * value_bytes;
+    }
+    
+    ranges.frame_stride = ranges.keys.Num() * 8;
+    frame_bytes = (frame_bytes + 3) / 4 * 4;
+}
+
+static int32 displacement_quantize_bits = 0;
+
+template <typename T>
+static void quantizeDisplacements(const TArray<glm::vec2>& displacements,
+                                  float * range_out,
+                                  T * values_out)
+{
+    const float max_value = (float)((T)~(T)0);
+    glm::vec2 min_val(0, 0), max_val(0, 0);
+    if(displacements.Num() > 0) {
+        min_val = max_val = displacements[0];
+    }
+    
+    for(auto& cur_pt : displacements) {
+        min_val = glm::min(min_val, cur_pt);
+        max_val = glm::max(max_val, cur_pt);
+    }
+    
+    const glm::vec2 step_val = (max_val - min_val) / max_value;
+    range_out[0] = min_val.x;
+    range_out[1] = min_val.y;
+    range_out[2] = step_val.x;
+    range_out[3] = step_val.y;
+    
+    for(auto j = 0; j < displacements.Num(); j++) {
+        for(auto k = 0; k < 2; k++) {
+            float cur_value = (step_val[k] > 0) ? ((displacements[j][k] - min_val[k]) / step_val[k]) : 0.0f;
+            values_out[j * 2 + k] = (T)FMath::Clamp(floorf(cur_value + 0.5f), 0.0f, max_value);
+        }
+    }
+}
+
+template <typename T>
+static void quantizeCacheList(const TArray<meshDisplacementCache>& cache_list,
+                              const meshQuantizedDisplacementView& layout_view,
+                              float * ranges_out,
+                              uint8 * values_out)
+{
+    for(auto j = 0; j < cache_list.Num(); j++) {
+        const meshDisplacementCache& cur_data = cache_list[j];
+        float * cur_range = ranges_out + layout_view.ranges.key_offsets[j];
+        T * cur_values = (T *)(values_out + layout_view.value_offsets[j]);
+        
+        quantizeDisplacements(cur_data.getLocalDisplacements(), cur_range, cur_values);
+        quantizeDisplacements(cur_data.getPostDisplacements(), cur_range + 4,
+                              cur_values + cur_data.getLocalDisplacements().Num() * 2);
+    }
+}
+
+bool
+meshDisplacementCacheManager::quantize(int32 value_bits)
+{
+    if(((value_bits != 16) && (value_bits != 8)) || !allReady()) {
+        return false;
+    }
+    
+    TArray<TArray<meshDisplacementCache> >& src_table = getCacheTable();
+    
+    // Every frame needs the same keys and point counts
+    const TArray<meshDisplacementCache> * ref_list = nullptr;
+    for(auto& cur_list : src_table) {
+        if(cur_list.Num() == 0) {
+            continue;
+        }
+        
+        if(ref_list == nullptr) {
+            ref_list = &cur_list;
+            continue;
+        }
+        
+        if(cur_list.Num() != ref_list->Num()) {
+            return false;
+        }
+        
+        for(auto i = 0; i < cur_list.Num(); i++) {
+            const meshDisplacementCache& cur_data = cur_list[i];
+            const meshDisplacementCache& ref_data = (*ref_list)[i];
+            if((cur_data.getKey() != ref_data.getKey())
+               || (cur_data.getLocalDisplacements().Num() != ref_data.getLocalDisplacements().Num())
+               || (cur_data.getPostDisplacements().Num() != ref_data.getPostDisplacements().Num()))
+            {
+                return false;
+            }
+        }
+    }
+    
+    if(ref_list == nullptr) {
+        return false;
+    }
+    
+    meshQuantizedDisplacementView new_view;
+    for(auto& cur_data : *ref_list) {
+        new_view.ranges.keys.Add(cur_data.getKey());
+        new_view.local_counts.Add(cur_data.getLocalDisplacements().Num());
+        new_view.post_counts.Add(cur_data.getPostDisplacements().Num());
+    }
+    
+    new_view.value_bits = value_bits;
+    new_view.initLayout();
+    
+    const int32 num_frames = src_table.Num();
+    TArray<float> new_ranges;
+    TArray<int32> new_frame_counts;
+    TArray<uint8> new_values;
+    new_ranges.SetNumZeroed(num_frames * new_view.ranges.frame_stride);
+    new_frame_counts.SetNumZeroed(num_frames);
+    new_values.SetNumZeroed(num_frames * new_view.frame_bytes);
+    
+    for(auto i = 0; i < num_frames; i++) {
+        const TArray<meshDisplacementCache>& cur_list = src_table[i];
+        if(cur_list.Num() == 0) {
+            continue;
+        }
+        
+        float * frame_ranges = new_ranges.GetData() + (int64)i * new_view.ranges.frame_stride;
+        uint8 * frame_values = new_values.GetData() + (int64)i * new_view.frame_bytes;
+        if(value_bits == 16) {
+            quantizeCacheList<uint16>(cur_list, new_view, frame_ranges, frame_values);
+        }
+        else {
+            quantizeCacheList<uint8>(cur_list, new_view, frame_ranges, frame_values);
+        }
+        
+        new_frame_counts[i] = cur_list.Num();
+    }
+    
+    TArray<int32> src_key_times = keyframes.getKeyTimes();
+    init(start_time, end_time);
+    initKeyframes(src_key_times);
+    displacement_cache_table.Empty();
+    displacement_cache_data_ready.Empty();
+    
+    new_view.ranges.num_frames = num_frames;
+    quantized_view = new_view;
+    quantized_ranges = new_ranges;
+    quantized_frame_counts = new_frame_counts;
+    quantized_values = new_values;
+    pointQuantizedViewAtData();
+    is_ready = true;
+    
+    return true;
+}
+
+void
+meshDisplacementCacheManager::initQuantizedView(int32 start_time_in, int32 end_time_in,
+                                                const meshQuantizedDisplacementView& view_in)
+{
+    init(start_time_in, end_time_in);
+    if(!view_in.isValid()) {
+        return;
+    }
+    
+    displacement_cache_table.Empty();
+    displacement_cache_data_ready.Empty();
+    quantized_view = view_in;
+    is_ready = true;
+}
+
+bool
+meshDisplacementCacheManager::hasQuantizedView() const
+{
+    return hasPackedView() && quantized_view.isValid();
+}
+
+const meshQuantizedDisplacementView&
+meshDisplacementCacheManager::getQuantizedView() const
+{
+    return quantized_view;
+}
+
+bool
+meshDisplacementCacheManager::ownsQuantizedData() const
+{
+    return quantized_frame_counts.Num() > 0;
+}
+
+void
+meshDisplacementCacheManager::pointQuantizedViewAtData()
+{
+    quantized_view.ranges.data = quantized_ranges.GetData();
+    quantized_view.ranges.frame_counts = quantized_frame_counts.GetData();
+    quantized_view.values = quantized_values.GetData();
+}
+
+void
+meshDisplacementCacheManager::setDefaultQuantizeBits(int32 value_in)
+{
+    displacement_quantize_bits = ((value_in == 16) || (value_in == 8)) ? value_in : 0;
+}
+
+int32
+meshDisplacementCacheManager::getDefaultQuantizeBits()
+{
+    return displacement_quantize_bits;
+}
+
 int32 meshDisplacementCacheManager::getStartTime() const
 {
     return start_time;
@@ -1629,15 +2620,106 @@ int32 meshDisplacementCacheManager::getEndime() const
 
 int32 meshDisplacementCacheManager::getIndexByTime(int32 time_in) const
 {
+    if(keyframes.isSparse()) {
+        return keyframes.getKeyAtTime(time_in);
+    }
+    
     int32 retval = time_in - start_time;
-    retval = clipNumber(retval, 0, (int32)displacement_cache_table.Num() - 1);
+    int32 num_frames = 0;
+    if(hasQuantizedView()) {
+        num_frames = quantized_view.ranges.num_frames;
+    }
+    else if(hasFlatView()) {
+        num_frames = flat_view.num_frames;
+    }
+    else {
+        num_frames = (int32)displacement_cache_table.Num();
+    }
+    retval = clipNumber(retval, 0, num_frames - 1);
 
     return retval;
 }
 
+void
+meshDisplacementCacheManager::getFramesAtTime(float time_in, int32& base_frame, int32& end_frame, float& ratio) const
+{
+    if(keyframes.isSparse()) {
+        keyframes.getKeysAtTime(time_in, base_frame, end_frame, ratio);
+        return;
+    }
+    
+    base_frame = getIndexByTime((int32)floorf(time_in));
+    end_frame = getIndexByTime((int32)ceilf(time_in));
+    ratio = (time_in - (float)floorf(time_in));
+}
+
+static TArray<glm::vec2> interpDisplacementList(const TArray<glm::vec2>& base_pts,
+                                                const TArray<glm::vec2>& end_pts,
+                                                float ratio)
+{
+    TArray<glm::vec2> ret_pts;
+    if(base_pts.Num() == end_pts.Num()) {
+        ret_pts.SetNumUninitialized(base_pts.Num());
+        for(auto j = 0; j < base_pts.Num(); j++) {
+            ret_pts[j] = ((1.0f - ratio) * base_pts[j]) + (ratio * end_pts[j]);
+        }
+    }
+    
+    return ret_pts;
+}
+
+void
+meshDisplacementCacheManager::makeDense()
+{
+    if(!keyframes.isSparse()) {
+        return;
+    }
+    
+    if(hasPackedView()) {
+        unpackFlatView();
+    }
+    
+    const int32 num_frames = end_time - start_time + 1;
+    TArray<TArray<meshDisplacementCache> > new_table;
+    TArray<bool> new_data_ready;
+    new_table.SetNum(num_frames);
+    new_data_ready.SetNumZeroed(num_frames);
+    for(auto i = 0; i < num_frames; i++) {
+        int32 base_frame = 0, end_frame = 0;
+        float ratio = 0;
+        keyframes.getKeysAtTime((float)(start_time + i), base_frame, end_frame, ratio);
+        if(!displacement_cache_data_ready[base_frame] || !displacement_cache_data_ready[end_frame]) {
+            continue;
+        }
+        
+        const TArray<meshDisplacementCache>& base_list = displacement_cache_table[base_frame];
+        const TArray<meshDisplacementCache>& end_list = displacement_cache_table[end_frame];
+        for(auto j = 0; (j < base_list.Num()) && (j < end_list.Num()); j++) {
+            meshDisplacementCache new_cache(base_list[j].getKey());
+            new_cache.setLocalDisplacements(
+                interpDisplacementList(base_list[j].getLocalDisplacements(), end_list[j].getLocalDisplacements(), ratio));
+            new_cache.setPostDisplacements(
+                interpDisplacementList(base_list[j].getPostDisplacements(), end_list[j].getPostDisplacements(), ratio));
+            new_table[i].Add(new_cache);
+        }
+        
+        new_data_ready[i] = true;
+    }
+    
+    keyframes.init(start_time, end_time, TArray<int32>());
+    displacement_cache_table = new_table;
+    displacement_cache_data_ready = new_data_ready;
+}
+
 void meshDisplacementCacheManager::setValuesAtTime(int32 time_in,
                                                    TMap<FName,meshRenderRegion *>& regions_map)
 {
+    if(hasPackedView()) {
+        unpackFlatView();
+    }
+    
+    makeDense();
+    
     TArray<meshDisplacementCache> cache_list;
     int32 set_index = getIndexByTime(time_in);
     for(auto& cur_iter : regions_map)
@@ -1661,13 +2743,207 @@ void meshDisplacementCacheManager::setValuesAtTime(int32 time_in,
     displacement_cache_data_ready[set_index] = true;
 }
 
+static void interpFlatDisplacements(const glm::vec2 * base_data,
+                                   const glm::vec2 * end_data,
+                                   int32 num_pts,
+                                   float ratio,
+                                   TArray<glm::vec2>& displacements)
+{
+    if(num_pts == displacements.Num()) {
+        for(auto j = 0; j < displacements.Num(); j++) {
+            displacements[j] = ((1.0f - ratio) * base_data[j]) + (ratio * end_data[j]);
+        }
+    }
+    else {
+        for(auto j = 0; j < displacements.Num(); j++) {
+            displacements[j] = glm::vec2(0, 0);
+        }
+    }
+}
+
+// Blends two quantized frames, folding both ranges into one offset and two scales
+template <typename T>
+static void interpQuantizedDisplacements(const T * base_values,
+                                         const float * base_range,
+                                         const T * end_values,
+                                         const float * end_range,
+                                         int32 num_pts,
+                                         float ratio,
+                                         TArray<glm::vec2>& displacements)
+{
+    if(num_pts != displacements.Num()) {
+        for(auto j = 0; j < displacements.Num(); j++) {
+            displacements[j] = glm::vec2(0, 0);
+        }
+        
+        return;
+    }
+    
+    const glm::vec2 offset = ((1.0f - ratio) * glm::vec2(base_range[0], base_range[1]))
+        + (ratio * glm::vec2(end_range[0], end_range[1]));
+    const glm::vec2 base_step = (1.0f - ratio) * glm::vec2(base_range[2], base_range[3]);
+    const glm::vec2 end_step = ratio * glm::vec2(end_range[2], end_range[3]);
+    for(auto j = 0; j < num_pts; j++) {
+        displacements[j] = offset
+            + (base_step * glm::vec2((float)base_values[j * 2], (float)base_values[j * 2 + 1]))
+            + (end_step * glm::vec2((float)end_values[j * 2], (float)end_values[j * 2 + 1]));
+    }
+}
+
+template <typename T, typename GetRegionFunc>
+void meshDisplacementCacheManager::retrieveQuantizedValuesAtTime(int32 base_time,
+                                                                 int32 final_time,
+                                                                 float ratio,
+                                                                 GetRegionFunc get_region)
+{
+    const meshCacheFlatView& ranges = quantized_view.ranges;
+    if(!ranges.hasFrame(base_time) || !ranges.hasFrame(final_time)) {
+        return;
+    }
+    
+    for(auto i = 0; i < ranges.keys.Num(); i++) {
+        meshRenderRegion * set_region = get_region(i, ranges.keys[i]);
+        if(set_region == nullptr) {
+            continue;
+        }
+        
+        const T * base_values = (const T *)quantized_view.getValues(base_time, i);
+        const T * end_values = (const T *)quantized_view.getValues(final_time, i);
+        const float * base_range = ranges.getEntry(base_time, i);
+        const float * end_range = ranges.getEntry(final_time, i);
+        int32 num_local = quantized_view.local_counts[i];
+        
+        if(set_region->getUseLocalDisplacements()) {
+            interpQuantizedDisplacements(base_values, base_range, end_values, end_range, num_local, ratio,
+                                         set_region->getLocalDisplacements());
+        }
+        
+        if(set_region->getUsePostDisplacements()) {
+            interpQuantizedDisplacements(base_values + num_local * 2, base_range + 4,
+                                         end_values + num_local * 2, end_range + 4,
+                                         quantized_view.post_counts[i], ratio,
+                                         set_region->getPostDisplacements());
+        }
+    }
+}
+
+template <typename GetRegionFunc>
+void meshDisplacementCacheManager::retrieveFlatValuesAtTime(int32 base_time,
+                                                            int32 final_time,
+                                                            float ratio,
+                                                            GetRegionFunc get_region)
+{
+    if(!flat_view.hasFrame(base_time) || !flat_view.hasFrame(final_time)) {
+        return;
+    }
+    
+    for(auto i = 0; i < flat_view.keys.Num(); i++) {
+        const glm::vec2 * base_data = (const glm::vec2 *)flat_view.getEntry(base_time, i);
+        const glm::vec2 * end_data = (const glm::vec2 *)flat_view.getEntry(final_time, i);
+        int32 num_local = flat_local_counts[i];
+        
+        meshRenderRegion * set_region = get_region(i, flat_view.keys[i]);
+        if(set_region == nullptr) {
+            continue;
+        }
+        
+        if(set_region->getUseLocalDisplacements()) {
+            interpFlatDisplacements(base_data, end_data, num_local, ratio,
+                                    set_region->getLocalDisplacements());
+        }
+        
+        if(set_region->getUsePostDisplacements()) {
+            interpFlatDisplacements(base_data + num_local, end_data + num_local, flat_post_counts[i], ratio,
+                                    set_region->getPostDisplacements());
+        }
+    }
+}
+
 void meshDisplacementCacheManager::retrieveValuesAtTime(float time_in,
                                                         TMap<FName,meshRenderRegion *>& regions_map)
 {
-    int32 base_time = getIndexByTime((int32)floorf(time_in));
-    int32 final_time = getIndexByTime((int32)ceilf(time_in));
+    retrieveBoundValuesAtTime(time_in, [&regions_map](int32, const FName& key_in) {
+        return regions_map.FindRef(key_in);
+    });
+}
+
+void meshDisplacementCacheManager::retrieveValuesAtTime(float time_in,
+                                                        const TArray<meshRenderRegion *>& regions_list,
+                                                        const TArray<int32>& region_indices)
+{
+    retrieveBoundValuesAtTime(time_in, [&regions_list, &region_indices](int32 entry_index, const FName&) {
+        const int32 region_index = region_indices[entry_index];
+        return (region_index >= 0) ? regions_list[region_index] : nullptr;
+    });
+}
+
+void
+meshDisplacementCacheManager::getKeys(TArray<FName>& out_keys)
+{
+    out_keys.Reset();
+    if(hasQuantizedView()) {
+        out_keys = quantized_view.ranges.keys;
+        return;
+    }
     
-    float ratio = (time_in - (float)floorf(time_in));
+    if(hasFlatView()) {
+        out_keys = flat_view.keys;
+        return;
+    }
+    
+    for(auto i = 0; i < displacement_cache_table.Num(); i++) {
+        if(displacement_cache_data_ready[i]) {
+            for(auto& cur_cache : displacement_cache_table[i]) {
+                out_keys.Add(cur_cache.getKey());
+            }
+            
+            return;
+        }
+    }
+}
+
+int64
+meshDisplacementCacheManager::getAllocatedSize() const
+{
+    int64 retval = getCacheTableSize(displacement_cache_table, displacement_cache_data_ready);
+    for(auto& cur_row : displacement_cache_table) {
+        for(auto& cur_cache : cur_row) {
+            retval += cur_cache.getAllocatedSize();
+        }
+    }
+    
+    retval += flat_view.getAllocatedSize()
+        + (int64)(flat_local_counts.GetAllocatedSize() + flat_post_counts.GetAllocatedSize())
+        + keyframes.getAllocatedSize()
+        + quantized_view.getAllocatedSize()
+        + (int64)(quantized_ranges.GetAllocatedSize() + quantized_frame_counts.GetAllocatedSize()
+                  + quantized_values.GetAllocatedSize());
+    
+    return retval;
+}
+
+template <typename GetRegionFunc>
+void meshDisplacementCacheManager::retrieveBoundValuesAtTime(float time_in, GetRegionFunc get_region)
+{
+    int32 base_time = 0, final_time = 0;
+    float ratio = 0;
+    getFramesAtTime(time_in, base_time, final_time, ratio);
+    
+    if(hasQuantizedView()) {
+        if(quantized_view.value_bits == 16) {
+            retrieveQuantizedValuesAtTime<uint16>(base_time, final_time, ratio, get_region);
+        }
+        else {
+            retrieveQuantizedValuesAtTime<uint8>(base_time, final_time, ratio, get_region);
+        }
+        
+        return;
+    }
+    
+    if(hasFlatView()) {
+        retrieveFlatValuesAtTime(base_time, final_time, ratio, get_region);
+        return;
+    }
     
     if(displacement_cache_data_ready.Num() == 0) {
         return;
@@ -1687,7 +2963,10 @@ void meshDisplacementCacheManager::retrieveValuesAtTime(float time_in,
         const meshDisplacementCache& end_data = end_cache[i];
         const FName cur_key = base_data.getKey();
         
-        meshRenderRegion * set_region = regions_map[cur_key];
+        meshRenderRegion * set_region = get_region(i, cur_key);
+        if(set_region == nullptr) {
+            continue;
+        }
 
         if(set_region->getUseLocalDisplacements()) {
             TArray<glm::vec2>& displacements =
@@ -1737,11 +3016,15 @@ meshDisplacementCacheManager::retrieveSingleDisplacementValueAtTime(const FName&
                                                                    float time_in,
                                                                     meshRenderRegion * region)
 {
-    int32 base_time = getIndexByTime((int32)floorf(time_in));
-    int32 final_time = getIndexByTime((int32)ceilf(time_in));
-    float ratio = (time_in - (float)floorf(time_in));
+    int32 base_time = 0, final_time = 0;
+    float ratio = 0;
+    getFramesAtTime(time_in, base_time, final_time, ratio);
     std::pair<glm::vec4, glm::vec4> ret_data;
     
+    if(hasPackedView()) {
+        unpackFlatView();
+    }
+    
     if(displacement_cache_data_ready.Num() == 0) {
         return;
     }
@@ -1795,11 +3078,15 @@ meshDisplacementCacheManager::retrieveSingleDisplacementValueNoRegionAtTime(cons
                                                                             meshRenderRegion * region,
                                                                             TArray<glm::vec2>& out_displacements)
 {
-    int32 base_time = getIndexByTime((int32)floorf(time_in));
-    int32 final_time = getIndexByTime((int32)ceilf(time_in));
-    float ratio = (time_in - (float)floorf(time_in));
+    int32 base_time = 0, final_time = 0;
+    float ratio = 0;
+    getFramesAtTime(time_in, base_time, final_time, ratio);
     std::pair<glm::vec4, glm::vec4> ret_data;
     
+    if(hasPackedView()) {
+        unpackFlatView();
+    }
+    
     if(displacement_cache_data_ready.Num() == 0) {
         return;
     }
@@ -1853,11 +3140,15 @@ meshDisplacementCacheManager::retrieveSingleDisplacementValueDirectAtTime(const
                                                                           TArray<glm::vec2>& out_local_displacements,
                                                                           TArray<glm::vec2>& out_post_displacements)
 {
-    int32 base_time = getIndexByTime((int32)floorf(time_in));
-    int32 final_time = getIndexByTime((int32)ceilf(time_in));
-    float ratio = (time_in - (float)floorf(time_in));
+    int32 base_time = 0, final_time = 0;
+    float ratio = 0;
+    getFramesAtTime(time_in, base_time, final_time, ratio);
     std::pair<glm::vec4, glm::vec4> ret_data;
     
+    if(hasPackedView()) {
+        unpackFlatView();
+    }
+    
     if(displacement_cache_data_ready.Num() == 0) {
         return;
     }
@@ -1913,7 +3204,7 @@ bool meshDisplacementCacheManager::allReady()
         return true;
     }
     else {
-        int32 num_frames = end_time - start_time + 1;
+        int32 num_frames = keyframes.getNumFrames();
         int32 ready_cnt = 0;
         for(auto i = 0; i < displacement_cache_data_ready.Num(); i++) {
             if(displacement_cache_data_ready[i]) {
@@ -1933,6 +3224,7 @@ bool meshDisplacementCacheManager::allReady()
 meshUVWarpCacheManager::meshUVWarpCacheManager()
 {
     is_ready = false;
+    table_unpacked = false;
 }
 
 meshUVWarpCacheManager::~meshUVWarpCacheManager()
@@ -1945,6 +3237,8 @@ meshUVWarpCacheManager::init(int32 start_time_in, int32 end_time_in)
 {
     start_time = start_time_in;
     end_time = end_time_in;
+    flat_view = meshCacheFlatView();
+    table_unpacked = false;
     
     int32 num_frames = end_time - start_time + 1;
     uv_cache_table.Empty();
@@ -1982,14 +3276,97 @@ meshUVWarpCacheManager::getEndime() const
 TArray<TArray<meshUVWarpCache> >&
 meshUVWarpCacheManager::getCacheTable()
 {
+    if(hasPackedView()) {
+        unpackFlatView();
+    }
+    
     return uv_cache_table;
 }
 
+void
+meshUVWarpCacheManager::initFlatView(int32 start_time_in, int32 end_time_in, const meshCacheFlatView& view_in)
+{
+    if(!view_in.isValid()) {
+        init(start_time_in, end_time_in);
+        return;
+    }
+    
+    start_time = start_time_in;
+    end_time = end_time_in;
+    
+    uv_cache_table.Empty();
+    uv_cache_data_ready.Empty();
+    flat_view = view_in;
+    table_unpacked = false;
+    is_ready = true;
+}
+
+bool
+meshUVWarpCacheManager::hasFlatView() const
+{
+    return hasPackedView();
+}
+
+bool
+meshUVWarpCacheManager::hasPackedView() const
+{
+    return flat_view.isValid() && !table_unpacked.load(std::memory_order_acquire);
+}
+
+bool
+meshUVWarpCacheManager::getFirstFrameEnabled(int32 entry_index)
+{
+    if(hasPackedView()) {
+        return (flat_view.num_frames > 0) && flat_view.hasFrame(0) && flat_view.keys.IsValidIndex(entry_index)
+            && (flat_view.getEntry(0, entry_index)[0] != 0);
+    }
+    
+    return (uv_cache_table.Num() > 0) && uv_cache_table[0].IsValidIndex(entry_index)
+        && uv_cache_table[0][entry_index].getEnabled();
+}
+
+void
+meshUVWarpCacheManager::unpackFlatView()
+{
+    // the view stays valid for readers still on it, see meshDisplacementCacheManager::unpackFlatView()
+    FScopeLock scope_lock(&data_lock);
+    if(!hasPackedView()) {
+        return;
+    }
+    
+    TArray<TArray<meshUVWarpCache> > new_table;
+    new_table.SetNum(end_time - start_time + 1);
+    for(auto i = 0; i < flat_view.num_frames; i++) {
+        if(!flat_view.hasFrame(i)) {
+            continue;
+        }
+        
+        TArray<meshUVWarpCache>& cache_list = new_table[i];
+        cache_list.Reserve(flat_view.keys.Num());
+        for(auto j = 0; j < flat_view.keys.Num(); j++) {
+            const float * src_data = flat_view.getEntry(i, j);
+            meshUVWarpCache new_data(flat_view.keys[j]);
+            new_data.setEnabled(src_data[0] != 0);
+            new_data.setLevel((int32)src_data[1]);
+            new_data.setUvWarpLocalOffset(glm::vec2(src_data[2], src_data[3]));
+            new_data.setUvWarpGlobalOffset(glm::vec2(src_data[4], src_data[5]));
+            new_data.setUvWarpScale(glm::vec2(src_data[6], src_data[7]));
+            cache_list.Add(new_data);
+        }
+    }
+    
+    uv_cache_table = new_table;
+    uv_cache_data_ready.Init(true, new_table.Num());
+    is_ready = true;
+    table_unpacked.store(true, std::memory_order_release);
+}
+
 int32
 meshUVWarpCacheManager::getIndexByTime(int32 time_in) const
 {
     int32 retval = time_in - start_time;
-    retval = clipNumber(retval, 0, (int32)uv_cache_table.Num() - 1);
+    int32 num_frames = hasPackedView() ? flat_view.num_frames : (int32)uv_cache_table.Num();
+    retval = clipNumber(retval, 0, num_frames - 1);
 
     return retval;
 }
@@ -1998,6 +3375,10 @@ void
 meshUVWarpCacheManager::setValuesAtTime(int32 time_in,
                                         TMap<FName, meshRenderRegion *>& regions_map)
 {
+    if(hasPackedView()) {
+        unpackFlatView();
+    }
+    
     int32 set_index = getIndexByTime(time_in);
     TArray<meshUVWarpCache> cache_list;
     for(auto& cur_iter : regions_map) {
@@ -2023,10 +3404,76 @@ meshUVWarpCacheManager::setValuesAtTime(int32 time_in,
 void
 meshUVWarpCacheManager::retrieveValuesAtTime(float time_in,
                                             TMap<FName, meshRenderRegion *>& regions_map)
+{
+    retrieveBoundValuesAtTime(time_in, [&regions_map](int32, const FName& key_in) {
+        return regions_map.FindRef(key_in);
+    });
+}
+
+void
+meshUVWarpCacheManager::retrieveValuesAtTime(float time_in,
+                                            const TArray<meshRenderRegion *>& regions_list,
+                                            const TArray<int32>& region_indices)
+{
+    retrieveBoundValuesAtTime(time_in, [&regions_list, &region_indices](int32 entry_index, const FName&) {
+        const int32 region_index = region_indices[entry_index];
+        return (region_index >= 0) ? regions_list[region_index] : nullptr;
+    });
+}
+
+void
+meshUVWarpCacheManager::getKeys(TArray<FName>& out_keys)
+{
+    out_keys.Reset();
+    if(hasPackedView()) {
+        out_keys = flat_view.keys;
+        return;
+    }
+    
+    for(auto i = 0; i < uv_cache_table.Num(); i++) {
+        if(uv_cache_data_ready[i]) {
+            for(auto& cur_cache : uv_cache_table[i]) {
+                out_keys.Add(cur_cache.getKey());
+            }
+            
+            return;
+        }
+    }
+}
+
+int64
+meshUVWarpCacheManager::getAllocatedSize() const
+{
+    return getCacheTableSize(uv_cache_table, uv_cache_data_ready) + flat_view.getAllocatedSize();
+}
+
+template <typename GetRegionFunc>
+void
+meshUVWarpCacheManager::retrieveBoundValuesAtTime(float time_in, GetRegionFunc get_region)
 {
     int32 base_time = getIndexByTime((int32)floorf(time_in));
     int32 final_time = getIndexByTime((int32)ceilf(time_in));
     
+    if(hasPackedView()) {
+        if(!flat_view.hasFrame(base_time)) {
+            return;
+        }
+        
+        for(auto i = 0; i < flat_view.keys.Num(); i++) {
+            const float * base_data = flat_view.getEntry(base_time, i);
+            meshRenderRegion * set_region = get_region(i, flat_view.keys[i]);
+            if(set_region && (set_region->getUseUvWarp() || (base_data[0] != 0)))
+            {
+                set_region->setUvWarpLocalOffset(glm::vec2(base_data[2], base_data[3]));
+                set_region->setUvWarpGlobalOffset(glm::vec2(base_data[4], base_data[5]));
+                set_region->setUvWarpScale(glm::vec2(base_data[6], base_data[7]));
+                set_region->setUVLevel((int32)base_data[1]);
+            }
+        }
+        
+        return;
+    }
+    
     if(uv_cache_data_ready.Num() == 0) {
         return;
     }
@@ -2043,8 +3490,8 @@ meshUVWarpCacheManager::retrieveValuesAtTime(float time_in,
         const meshUVWarpCache& base_data = base_cache[i];
         const FName& cur_key = base_data.getKey();
         
-        meshRenderRegion * set_region = regions_map[cur_key];
-        if(set_region->getUseUvWarp() || base_data.getEnabled())
+        meshRenderRegion * set_region = get_region(i, cur_key);
+        if(set_region && (set_region->getUseUvWarp() || base_data.getEnabled()))
         {
             glm::vec2 final_local_offset = base_data.getUvWarpLocalOffset();
             
@@ -2068,6 +3515,10 @@ meshUVWarpCacheManager::retrieveSingleValueAtTime(float time_in,
                                                   glm::vec2& global_offset,
                                                   glm::vec2& scale)
 {
+    if(hasPackedView()) {
+        unpackFlatView();
+    }
+    
     int32 base_time = getIndexByTime((int32)floorf(time_in));
     int32 final_time = getIndexByTime((int32)ceilf(time_in));
     
@@ -2135,6 +3586,7 @@ meshUVWarpCacheManager::allReady()
 meshOpacityCacheManager::meshOpacityCacheManager()
 {
 	is_ready = false;
+	table_unpacked = false;
 }
 
 meshOpacityCacheManager::~meshOpacityCacheManager()
@@ -2147,6 +3599,8 @@ meshOpacityCacheManager::init(int32 start_time_in, int32 end_time_in)
 {
 	start_time = start_time_in;
 	end_time = end_time_in;
+	flat_view = meshCacheFlatView();
+	table_unpacked = false;
 
 	int32 num_frames = end_time - start_time + 1;
 	opacity_cache_table.Empty();
@@ -2184,14 +3638,84 @@ meshOpacityCacheManager::getEndime() const
 TArray<TArray<meshOpacityCache> >&
 meshOpacityCacheManager::getCacheTable()
 {
+	if (hasPackedView()) {
+		unpackFlatView();
+	}
+
 	return opacity_cache_table;
 }
 
+void
+meshOpacityCacheManager::initFlatView(int32 start_time_in, int32 end_time_in, const meshCacheFlatView& view_in)
+{
+	if (!view_in.isValid()) {
+		init(start_time_in, end_time_in);
+		return;
+	}
+
+	start_time = start_time_in;
+	end_time = end_time_in;
+
+	opacity_cache_table.Empty();
+	opacity_cache_data_ready.Empty();
+	flat_view = view_in;
+	table_unpacked = false;
+	is_ready = true;
+}
+
+bool
+meshOpacityCacheManager::hasFlatView() const
+{
+	return hasPackedView();
+}
+
+bool
+meshOpacityCacheManager::hasPackedView() const
+{
+	return flat_view.isValid() && !table_unpacked.load(std::memory_order_acquire);
+}
+
+void
+meshOpacityCacheManager::unpackFlatView()
+{
+	// the view stays valid for readers still on it, see meshDisplacementCacheManager::unpackFlatView()
+	FScopeLock scope_lock(&data_lock);
+	if (!hasPackedView()) {
+		return;
+	}
+
+	TArray<TArray<meshOpacityCache> > new_table;
+	new_table.SetNum(end_time - start_time + 1);
+	for (auto i = 0; i < flat_view.num_frames; i++) {
+		if (!flat_view.hasFrame(i)) {
+			continue;
+		}
+
+		TArray<meshOpacityCache>& cache_list = new_table[i];
+		cache_list.Reserve(flat_view.keys.Num());
+		for (auto j = 0; j < flat_view.keys.Num(); j++) {
+			const float * src_data = flat_view.getEntry(i, j);
+			meshOpacityCache new_data(flat_view.keys[j]);
+			new_data.setOpacity(src_data[0]);
+			new_data.setRed(src_data[1]);
+			new_data.setGreen(src_data[2]);
+			new_data.setBlue(src_data[3]);
+			cache_list.Add(new_data);
+		}
+	}
+
+	opacity_cache_table = new_table;
+	opacity_cache_data_ready.Init(true, new_table.Num());
+	is_ready = true;
+	table_unpacked.store(true, std::memory_order_release);
+}
+
 int32
 meshOpacityCacheManager::getIndexByTime(int32 time_in) const
 {
 	int32 retval = time_in - start_time;
-	retval = clipNumber(retval, 0, (int32)opacity_cache_table.Num() - 1);
+	int32 num_frames = hasPackedView() ? flat_view.num_frames : (int32)opacity_cache_table.Num();
+	retval = clipNumber(retval, 0, num_frames - 1);
 
 	return retval;
 }
@@ -2200,6 +3724,10 @@ void
 meshOpacityCacheManager::setValuesAtTime(int32 time_in,
 						TMap<FName, meshRenderRegion *>& regions_map)
 {
+	if (hasPackedView()) {
+		unpackFlatView();
+	}
+
 	int32 set_index = getIndexByTime(time_in);
 	TArray<meshOpacityCache> cache_list;
 	for (auto cur_iter : regions_map) {
@@ -2219,12 +3747,79 @@ meshOpacityCacheManager::setValuesAtTime(int32 time_in,
 void
 meshOpacityCacheManager::retrieveValuesAtTime(float time_in,
 											TMap<FName, meshRenderRegion *>& regions_map)
+{
+	retrieveBoundValuesAtTime(time_in, [&regions_map](int32, const FName& key_in) {
+		return regions_map.FindRef(key_in);
+	});
+}
+
+void
+meshOpacityCacheManager::retrieveValuesAtTime(float time_in,
+											const TArray<meshRenderRegion *>& regions_list,
+											const TArray<int32>& region_indices)
+{
+	retrieveBoundValuesAtTime(time_in, [&regions_list, &region_indices](int32 entry_index, const FName&) {
+		const int32 region_index = region_indices[entry_index];
+		return (region_index >= 0) ? regions_list[region_index] : nullptr;
+	});
+}
+
+void
+meshOpacityCacheManager::getKeys(TArray<FName>& out_keys)
+{
+	out_keys.Reset();
+	if (hasPackedView()) {
+		out_keys = flat_view.keys;
+		return;
+	}
+
+	for (auto i = 0; i < opacity_cache_table.Num(); i++) {
+		if (opacity_cache_data_ready[i]) {
+			for (auto& cur_cache : opacity_cache_table[i]) {
+				out_keys.Add(cur_cache.getKey());
+			}
+
+			return;
+		}
+	}
+}
+
+int64
+meshOpacityCacheManager::getAllocatedSize() const
+{
+	return getCacheTableSize(opacity_cache_table, opacity_cache_data_ready) + flat_view.getAllocatedSize();
+}
+
+template <typename GetRegionFunc>
+void
+meshOpacityCacheManager::retrieveBoundValuesAtTime(float time_in, GetRegionFunc get_region)
 {
 	SCOPE_CYCLE_COUNTER(STAT_MeshOpacityCacheManager_retrieveValuesAtTime);
 
 	int32 base_time = getIndexByTime((int32)floorf(time_in));
 	int32 final_time = getIndexByTime((int32)ceilf(time_in));
 
+	if (hasPackedView()) {
+		if (!flat_view.hasFrame(base_time)) {
+			return;
+		}
+
+		for (auto i = 0; i < flat_view.keys.Num(); i++) {
+			const float * base_data = flat_view.getEntry(base_time, i);
+			meshRenderRegion * set_region = get_region(i, flat_view.keys[i]);
+			if (set_region == nullptr) {
+				continue;
+			}
+
+			set_region->setOpacity(base_data[0]);
+			set_region->setRed(base_data[1]);
+			set_region->setGreen(base_data[2]);
+			set_region->setBlue(base_data[3]);
+		}
+
+		return;
+	}
+
 	if (opacity_cache_data_ready.Num() == 0) {
 		return;
 	}
@@ -2241,7 +3836,11 @@ meshOpacityCacheManager::retrieveValuesAtTime(float time_in,
 		const meshOpacityCache& base_data = base_cache[i];
 		const FName& cur_key = base_data.getKey();
 
-		meshRenderRegion * set_region = regions_map[cur_key];
+		meshRenderRegion * set_region = get_region(i, cur_key);
+		if (set_region == nullptr) {
+			continue;
+		}
+
 		float final_opacity = base_data.getOpacity();
 		set_region->setOpacity(final_opacity);
 		set_region->setRed(base_data.getRed());
@@ -2255,6 +3854,10 @@ meshOpacityCacheManager::retrieveSingleValueAtTime(float time_in,
 												meshRenderRegion * region,
 												float& out_opacity)
 {
+	if (hasPackedView()) {
+		unpackFlatView();
+	}
+
 	int32 base_time = getIndexByTime((int32)floorf(time_in));
 	int32 final_time = getIndexByTime((int32)ceilf(time_in));
 
@@ -0,0 +1,518 @@
+/******************************************************************************
+ * Creature Runtimes License
+ *
+ * Copyright (c) 2015, Kestrel Moon Studios
+ * All rights reserved.
+ *
+ * Preamble: This Agreement governs the relationship between Licensee and Kestrel Moon Studios(Hereinafter: Licensor).
+ * This Agreement sets the terms, rights, restrictions and obligations on using [Creature Runtimes] (hereinafter: The Software) created and owned by Licensor,
+ * as detailed herein:
+ * License Grant: Licensor hereby grants Licensee a Sublicensable, Non-assignable & non-transferable, Commercial, Royalty free,
+ * Including the rights to create but not distribute derivative works, Non-exclusive license, all with accordance with the terms set forth and
+ * other legal restrictions set forth in 3rd party software used while running Software.
+ * Limited: Licensee may use Software for the purpose of:
+ * Running Software on Licensee’s Website[s] and Server[s];
+ * Allowing 3rd Parties to run Software on Licensee’s Website[s] and Server[s];
+ * Publishing Software’s output to Licensee and 3rd Parties;
+ * Distribute verbatim copies of Software’s output (including compiled binaries);
+ * Modify Software to suit Licensee’s needs and specifications.
+ * Binary Restricted: Licensee may sublicense Software as a part of a larger work containing more than Software,
+ * distributed solely in Object or Binary form under a personal, non-sublicensable, limited license. Such redistribution shall be limited to unlimited codebases.
+ * Non Assignable & Non-Transferable: Licensee may not assign or transfer his rights and duties under this license.
+ * Commercial, Royalty Free: Licensee may use Software for any purpose, including paid-services, without any royalties
+ * Including the Right to Create Derivative Works: Licensee may create derivative works based on Software,
+ * including amending Software’s source code, modifying it, integrating it into a larger work or removing portions of Software,
+ * as long as no distribution of the derivative works is made
+ *
+ * THE RUNTIMES IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE RUNTIMES OR THE USE OR OTHER DEALINGS IN THE
+ * RUNTIMES.
+ *****************************************************************************/
+
+#include "MeshBone.h"
+#include "CreaturePluginPCH.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define MESH_SKINNING_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#define MESH_SKINNING_ARM64 1
+#include <arm_neon.h>
+#endif
+
+#if defined(MESH_SKINNING_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MESH_SKINNING_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MESH_SKINNING_TARGET_AVX2
+#endif
+
+static const int32 skin_block_size = MESH_SKINNING_BLOCK_SIZE;
+static meshSkinningMode active_skinning_mode = getBestMeshSkinningMode();
+
+// Reference path, the same glm maths poseFastFinalPts always used
+static void skinBlockScalar(const meshSkinningData& data_in, int32 block_index)
+{
+    const int32 num_influences = data_in.influences_per_pt;
+    const int32 start_pt = block_index * skin_block_size;
+    const int32 num_block_pts = FMath::Min(skin_block_size, data_in.num_pts - start_pt);
+    const float * block_rest_pts = data_in.rest_pts + (block_index * skin_block_size * 3);
+    const int32 * block_bones = data_in.influence_bones + (block_index * skin_block_size * num_influences);
+    const float * block_weights = data_in.influence_weights + (block_index * skin_block_size * num_influences);
+
+    for(int32 lane = 0; lane < num_block_pts; lane++)
+    {
+        const int32 i = start_pt + lane;
+        glm::vec4 cur_rest_pt(block_rest_pts[lane],
+                              block_rest_pts[skin_block_size + lane],
+                              block_rest_pts[(2 * skin_block_size) + lane],
+                              1);
+
+        if(data_in.local_displacements) {
+            cur_rest_pt.x += data_in.local_displacements[i].x;
+            cur_rest_pt.y += data_in.local_displacements[i].y;
+        }
+
+        dualQuat accum_dq;
+        for(int32 j = 0; j < num_influences; j++)
+        {
+            const float * bone_dq = data_in.bone_dqs + (block_bones[(j * skin_block_size) + lane] * 8);
+            dualQuat world_dq;
+            world_dq.real = glm::quat(bone_dq[3], bone_dq[0], bone_dq[1], bone_dq[2]);
+            world_dq.imaginary = glm::quat(bone_dq[7], bone_dq[4], bone_dq[5], bone_dq[6]);
+
+            float cur_im_weight_val = block_weights[(j * skin_block_size) + lane];
+            accum_dq.add(world_dq, cur_im_weight_val, cur_im_weight_val);
+        }
+
+        accum_dq.normalize();
+        glm::vec3 final_pt = accum_dq.transform(glm::vec3(cur_rest_pt));
+
+        float * write_pt = data_in.output_pts + (i * 3);
+        write_pt[0] = final_pt.x;
+        write_pt[1] = final_pt.y;
+        write_pt[2] = 0;
+
+        if(data_in.post_displacements) {
+            write_pt[0] += data_in.post_displacements[i].x;
+            write_pt[1] += data_in.post_displacements[i].y;
+        }
+    }
+}
+
+// Gathers the local displacements of up to num_lanes points, padding with zero
+static void gatherDisplacements(const glm::vec2 * displacements_in,
+                                int32 start_pt,
+                                int32 num_pts,
+                                float * out_x,
+                                float * out_y)
+{
+    for(int32 lane = 0; lane < num_pts; lane++)
+    {
+        out_x[lane] = displacements_in[start_pt + lane].x;
+        out_y[lane] = displacements_in[start_pt + lane].y;
+    }
+}
+
+// Writes skinned x, y of up to num_pts points, adding post displacements
+static void scatterPts(const meshSkinningData& data_in,
+                       int32 start_pt,
+                       int32 num_pts,
+                       const float * final_x,
+                       const float * final_y)
+{
+    for(int32 lane = 0; lane < num_pts; lane++)
+    {
+        const int32 i = start_pt + lane;
+        float * write_pt = data_in.output_pts + (i * 3);
+        write_pt[0] = final_x[lane];
+        write_pt[1] = final_y[lane];
+        write_pt[2] = 0;
+
+        if(data_in.post_displacements) {
+            write_pt[0] += data_in.post_displacements[i].x;
+            write_pt[1] += data_in.post_displacements[i].y;
+        }
+    }
+}
+
+// The vector kernels below evaluate the scalar path's expressions in the same
+// order and without fused multiply adds, so their results match it bit for bit.
+
+#if MESH_SKINNING_X86
+// Skins 4 lanes of a block starting at lane_offset
+static void skinLanesSse(const meshSkinningData& data_in, int32 block_index, int32 lane_offset)
+{
+    const int32 num_influences = data_in.influences_per_pt;
+    const int32 start_pt = (block_index * skin_block_size) + lane_offset;
+    const int32 num_lane_pts = FMath::Min(4, data_in.num_pts - start_pt);
+    if(num_lane_pts <= 0) {
+        return;
+    }
+
+    const float * block_rest_pts = data_in.rest_pts + (block_index * skin_block_size * 3) + lane_offset;
+    __m128 px = _mm_loadu_ps(block_rest_pts);
+    __m128 py = _mm_loadu_ps(block_rest_pts + skin_block_size);
+    __m128 pz = _mm_loadu_ps(block_rest_pts + (2 * skin_block_size));
+
+    if(data_in.local_displacements) {
+        float disp_x[4] = { 0, 0, 0, 0 }, disp_y[4] = { 0, 0, 0, 0 };
+        gatherDisplacements(data_in.local_displacements, start_pt, num_lane_pts, disp_x, disp_y);
+        px = _mm_add_ps(px, _mm_loadu_ps(disp_x));
+        py = _mm_add_ps(py, _mm_loadu_ps(disp_y));
+    }
+
+    __m128 rx = _mm_setzero_ps(), ry = _mm_setzero_ps(), rz = _mm_setzero_ps(), rw = _mm_setzero_ps();
+    __m128 ix = _mm_setzero_ps(), iy = _mm_setzero_ps(), iz = _mm_setzero_ps(), iw = _mm_setzero_ps();
+    const int32 block_slot_start = block_index * skin_block_size * num_influences;
+
+    for(int32 j = 0; j < num_influences; j++)
+    {
+        const int32 slot_offset = block_slot_start + (j * skin_block_size) + lane_offset;
+        const int32 * slot_bones = data_in.influence_bones + slot_offset;
+        __m128 weight = _mm_loadu_ps(data_in.influence_weights + slot_offset);
+
+        const float * dq_0 = data_in.bone_dqs + (slot_bones[0] * 8);
+        const float * dq_1 = data_in.bone_dqs + (slot_bones[1] * 8);
+        const float * dq_2 = data_in.bone_dqs + (slot_bones[2] * 8);
+        const float * dq_3 = data_in.bone_dqs + (slot_bones[3] * 8);
+
+        __m128 qx = _mm_loadu_ps(dq_0), qy = _mm_loadu_ps(dq_1), qz = _mm_loadu_ps(dq_2), qw = _mm_loadu_ps(dq_3);
+        _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+        rx = _mm_add_ps(rx, _mm_mul_ps(qx, weight));
+        ry = _mm_add_ps(ry, _mm_mul_ps(qy, weight));
+        rz = _mm_add_ps(rz, _mm_mul_ps(qz, weight));
+        rw = _mm_add_ps(rw, _mm_mul_ps(qw, weight));
+
+        qx = _mm_loadu_ps(dq_0 + 4); qy = _mm_loadu_ps(dq_1 + 4); qz = _mm_loadu_ps(dq_2 + 4); qw = _mm_loadu_ps(dq_3 + 4);
+        _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+        ix = _mm_add_ps(ix, _mm_mul_ps(qx, weight));
+        iy = _mm_add_ps(iy, _mm_mul_ps(qy, weight));
+        iz = _mm_add_ps(iz, _mm_mul_ps(qz, weight));
+        iw = _mm_add_ps(iw, _mm_mul_ps(qw, weight));
+    }
+
+    // normalize
+    __m128 norm = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rw, rw), _mm_mul_ps(rx, rx)),
+                                                    _mm_mul_ps(ry, ry)),
+                                         _mm_mul_ps(rz, rz)));
+    rx = _mm_div_ps(rx, norm); ry = _mm_div_ps(ry, norm); rz = _mm_div_ps(rz, norm); rw = _mm_div_ps(rw, norm);
+    ix = _mm_div_ps(ix, norm); iy = _mm_div_ps(iy, norm); iz = _mm_div_ps(iz, norm); iw = _mm_div_ps(iw, norm);
+
+    // translation
+    const __m128 two = _mm_set1_ps(2.0f);
+    __m128 tx = _mm_mul_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(ix, rw), _mm_mul_ps(rx, iw)),
+                                      _mm_sub_ps(_mm_mul_ps(ry, iz), _mm_mul_ps(iy, rz))), two);
+    __m128 ty = _mm_mul_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(iy, rw), _mm_mul_ps(ry, iw)),
+                                      _mm_sub_ps(_mm_mul_ps(rz, ix), _mm_mul_ps(iz, rx))), two);
+
+    // rotation
+    __m128 uvx = _mm_sub_ps(_mm_mul_ps(ry, pz), _mm_mul_ps(py, rz));
+    __m128 uvy = _mm_sub_ps(_mm_mul_ps(rz, px), _mm_mul_ps(pz, rx));
+    __m128 uvz = _mm_sub_ps(_mm_mul_ps(rx, py), _mm_mul_ps(px, ry));
+    __m128 uuvx = _mm_sub_ps(_mm_mul_ps(ry, uvz), _mm_mul_ps(uvy, rz));
+    __m128 uuvy = _mm_sub_ps(_mm_mul_ps(rz, uvx), _mm_mul_ps(uvz, rx));
+
+    __m128 fx = _mm_add_ps(_mm_add_ps(px, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(uvx, rw), uuvx), two)), tx);
+    __m128 fy = _mm_add_ps(_mm_add_ps(py, _mm_mul_ps(_mm_add_ps(_mm_mul_ps(uvy, rw), uuvy), two)), ty);
+
+    float final_x[4], final_y[4];
+    _mm_storeu_ps(final_x, fx);
+    _mm_storeu_ps(final_y, fy);
+    scatterPts(data_in, start_pt, num_lane_pts, final_x, final_y);
+}
+
+static void skinBlockSse(const meshSkinningData& data_in, int32 block_index)
+{
+    skinLanesSse(data_in, block_index, 0);
+    skinLanesSse(data_in, block_index, 4);
+}
+
+MESH_SKINNING_TARGET_AVX2
+static void skinBlockAvx2(const meshSkinningData& data_in, int32 block_index)
+{
+    const int32 num_influences = data_in.influences_per_pt;
+    const int32 start_pt = block_index * skin_block_size;
+    const int32 num_block_pts = FMath::Min(skin_block_size, data_in.num_pts - start_pt);
+
+    const float * block_rest_pts = data_in.rest_pts + (block_index * skin_block_size * 3);
+    __m256 px = _mm256_loadu_ps(block_rest_pts);
+    __m256 py = _mm256_loadu_ps(block_rest_pts + skin_block_size);
+    __m256 pz = _mm256_loadu_ps(block_rest_pts + (2 * skin_block_size));
+
+    if(data_in.local_displacements) {
+        float disp_x[8] = { 0, 0, 0, 0, 0, 0, 0, 0 }, disp_y[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        gatherDisplacements(data_in.local_displacements, start_pt, num_block_pts, disp_x, disp_y);
+        px = _mm256_add_ps(px, _mm256_loadu_ps(disp_x));
+        py = _mm256_add_ps(py, _mm256_loadu_ps(disp_y));
+    }
+
+    __m256 rx = _mm256_setzero_ps(), ry = _mm256_setzero_ps(), rz = _mm256_setzero_ps(), rw = _mm256_setzero_ps();
+    __m256 ix = _mm256_setzero_ps(), iy = _mm256_setzero_ps(), iz = _mm256_setzero_ps(), iw = _mm256_setzero_ps();
+    const int32 block_slot_start = block_index * skin_block_size * num_influences;
+
+    for(int32 j = 0; j < num_influences; j++)
+    {
+        const int32 slot_offset = block_slot_start + (j * skin_block_size);
+        __m256i dq_offsets = _mm256_slli_epi32(_mm256_loadu_si256((const __m256i *)(data_in.influence_bones + slot_offset)), 3);
+        __m256 weight = _mm256_loadu_ps(data_in.influence_weights + slot_offset);
+
+        rx = _mm256_add_ps(rx, _mm256_mul_ps(_mm256_i32gather_ps(data_in.bone_dqs + 0, dq_offsets, 4), weight));
+        ry = _mm256_add_ps(ry, _mm256_mul_ps(_mm256_i32gather_ps(data_in.bone_dqs + 1, dq_offsets, 4), weight));
+        rz = _mm256_add_ps(rz, _mm256_mul_ps(_mm256_i32gather_ps(data_in.bone_dqs + 2, dq_offsets, 4), weight));
+        rw = _mm256_add_ps(rw, _mm256_mul_ps(_mm256_i32gather_ps(data_in.bone_dqs + 3, dq_offsets, 4), weight));
+        ix = _mm256_add_ps(ix, _mm256_mul_ps(_mm256_i32gather_ps(data_in.bone_dqs + 4, dq_offsets, 4), weight));
+        iy = _mm256_add_ps(iy, _mm256_mul_ps(_mm256_i32gather_ps(data_in.bone_dqs + 5, dq_offsets, 4), weight));
+        iz = _mm256_add_ps(iz, _mm256_mul_ps(_mm256_i32gather_ps(data_in.bone_dqs + 6, dq_offsets, 4), weight));
+        iw = _mm256_add_ps(iw, _mm256_mul_ps(_mm256_i32gather_ps(data_in.bone_dqs + 7, dq_offsets, 4), weight));
+    }
+
+    // normalize
+    __m256 norm = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(rw, rw), _mm256_mul_ps(rx, rx)),
+                                                             _mm256_mul_ps(ry, ry)),
+                                               _mm256_mul_ps(rz, rz)));
+    rx = _mm256_div_ps(rx, norm); ry = _mm256_div_ps(ry, norm); rz = _mm256_div_ps(rz, norm); rw = _mm256_div_ps(rw, norm);
+    ix = _mm256_div_ps(ix, norm); iy = _mm256_div_ps(iy, norm); iz = _mm256_div_ps(iz, norm); iw = _mm256_div_ps(iw, norm);
+
+    // translation
+    const __m256 two = _mm256_set1_ps(2.0f);
+    __m256 tx = _mm256_mul_ps(_mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(ix, rw), _mm256_mul_ps(rx, iw)),
+                                            _mm256_sub_ps(_mm256_mul_ps(ry, iz), _mm256_mul_ps(iy, rz))), two);
+    __m256 ty = _mm256_mul_ps(_mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(iy, rw), _mm256_mul_ps(ry, iw)),
+                                            _mm256_sub_ps(_mm256_mul_ps(rz, ix), _mm256_mul_ps(iz, rx))), two);
+
+    // rotation
+    __m256 uvx = _mm256_sub_ps(_mm256_mul_ps(ry, pz), _mm256_mul_ps(py, rz));
+    __m256 uvy = _mm256_sub_ps(_mm256_mul_ps(rz, px), _mm256_mul_ps(pz, rx));
+    __m256 uvz = _mm256_sub_ps(_mm256_mul_ps(rx, py), _mm256_mul_ps(px, ry));
+    __m256 uuvx = _mm256_sub_ps(_mm256_mul_ps(ry, uvz), _mm256_mul_ps(uvy, rz));
+    __m256 uuvy = _mm256_sub_ps(_mm256_mul_ps(rz, uvx), _mm256_mul_ps(uvz, rx));
+
+    __m256 fx = _mm256_add_ps(_mm256_add_ps(px, _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(uvx, rw), uuvx), two)), tx);
+    __m256 fy = _mm256_add_ps(_mm256_add_ps(py, _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(uvy, rw), uuvy), two)), ty);
+
+    float final_x[8], final_y[8];
+    _mm256_storeu_ps(final_x, fx);
+    _mm256_storeu_ps(final_y, fy);
+    scatterPts(data_in, start_pt, num_block_pts, final_x, final_y);
+}
+
+static bool cpuSupportsAvx2()
+{
+#if defined(_MSC_VER)
+    int cpu_info[4];
+    __cpuid(cpu_info, 0);
+    if(cpu_info[0] < 7) {
+        return false;
+    }
+
+    // AVX and OS saved ymm state
+    __cpuid(cpu_info, 1);
+    const bool has_avx = (cpu_info[2] & (1 << 28)) && (cpu_info[2] & (1 << 27));
+    if(!has_avx || ((_xgetbv(0) & 0x6) != 0x6)) {
+        return false;
+    }
+
+    __cpuidex(cpu_info, 7, 0);
+    return (cpu_info[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif
+}
+#endif
+
+#if MESH_SKINNING_ARM64
+// Skins 4 lanes of a block starting at lane_offset
+static void skinLanesNeon(const meshSkinningData& data_in, int32 block_index, int32 lane_offset)
+{
+    const int32 num_influences = data_in.influences_per_pt;
+    const int32 start_pt = (block_index * skin_block_size) + lane_offset;
+    const int32 num_lane_pts = FMath::Min(4, data_in.num_pts - start_pt);
+    if(num_lane_pts <= 0) {
+        return;
+    }
+
+    const float * block_rest_pts = data_in.rest_pts + (block_index * skin_block_size * 3) + lane_offset;
+    float32x4_t px = vld1q_f32(block_rest_pts);
+    float32x4_t py = vld1q_f32(block_rest_pts + skin_block_size);
+    float32x4_t pz = vld1q_f32(block_rest_pts + (2 * skin_block_size));
+
+    if(data_in.local_displacements) {
+        float disp_x[4] = { 0, 0, 0, 0 }, disp_y[4] = { 0, 0, 0, 0 };
+        gatherDisplacements(data_in.local_displacements, start_pt, num_lane_pts, disp_x, disp_y);
+        px = vaddq_f32(px, vld1q_f32(disp_x));
+        py = vaddq_f32(py, vld1q_f32(disp_y));
+    }
+
+    float32x4_t rx = vdupq_n_f32(0), ry = vdupq_n_f32(0), rz = vdupq_n_f32(0), rw = vdupq_n_f32(0);
+    float32x4_t ix = vdupq_n_f32(0), iy = vdupq_n_f32(0), iz = vdupq_n_f32(0), iw = vdupq_n_f32(0);
+    const int32 block_slot_start = block_index * skin_block_size * num_influences;
+
+    for(int32 j = 0; j < num_influences; j++)
+    {
+        const int32 slot_offset = block_slot_start + (j * skin_block_size) + lane_offset;
+        const int32 * slot_bones = data_in.influence_bones + slot_offset;
+        float32x4_t weight = vld1q_f32(data_in.influence_weights + slot_offset);
+
+        for(int32 half = 0; half < 2; half++)
+        {
+            // 4x4 transpose of the lanes' real or imaginary parts
+            float32x4x2_t q_01 = vtrnq_f32(vld1q_f32(data_in.bone_dqs + (slot_bones[0] * 8) + (half * 4)),
+                                           vld1q_f32(data_in.bone_dqs + (slot_bones[1] * 8) + (half * 4)));
+            float32x4x2_t q_23 = vtrnq_f32(vld1q_f32(data_in.bone_dqs + (slot_bones[2] * 8) + (half * 4)),
+                                           vld1q_f32(data_in.bone_dqs + (slot_bones[3] * 8) + (half * 4)));
+            float32x4_t qx = vcombine_f32(vget_low_f32(q_01.val[0]), vget_low_f32(q_23.val[0]));
+            float32x4_t qy = vcombine_f32(vget_low_f32(q_01.val[1]), vget_low_f32(q_23.val[1]));
+            float32x4_t qz = vcombine_f32(vget_high_f32(q_01.val[0]), vget_high_f32(q_23.val[0]));
+            float32x4_t qw = vcombine_f32(vget_high_f32(q_01.val[1]), vget_high_f32(q_23.val[1]));
+
+            if(half == 0) {
+                rx = vaddq_f32(rx, vmulq_f32(qx, weight));
+                ry = vaddq_f32(ry, vmulq_f32(qy, weight));
+                rz = vaddq_f32(rz, vmulq_f32(qz, weight));
+                rw = vaddq_f32(rw, vmulq_f32(qw, weight));
+            }
+            else {
+                ix = vaddq_f32(ix, vmulq_f32(qx, weight));
+                iy = vaddq_f32(iy, vmulq_f32(qy, weight));
+                iz = vaddq_f32(iz, vmulq_f32(qz, weight));
+                iw = vaddq_f32(iw, vmulq_f32(qw, weight));
+            }
+        }
+    }
+
+    // normalize
+    float32x4_t norm = vsqrtq_f32(vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(rw, rw), vmulq_f32(rx, rx)),
+                                                      vmulq_f32(ry, ry)),
+                                            vmulq_f32(rz, rz)));
+    rx = vdivq_f32(rx, norm); ry = vdivq_f32(ry, norm); rz = vdivq_f32(rz, norm); rw = vdivq_f32(rw, norm);
+    ix = vdivq_f32(ix, norm); iy = vdivq_f32(iy, norm); iz = vdivq_f32(iz, norm); iw = vdivq_f32(iw, norm);
+
+    // translation
+    const float32x4_t two = vdupq_n_f32(2.0f);
+    float32x4_t tx = vmulq_f32(vaddq_f32(vsubq_f32(vmulq_f32(ix, rw), vmulq_f32(rx, iw)),
+                                         vsubq_f32(vmulq_f32(ry, iz), vmulq_f32(iy, rz))), two);
+    float32x4_t ty = vmulq_f32(vaddq_f32(vsubq_f32(vmulq_f32(iy, rw), vmulq_f32(ry, iw)),
+                                         vsubq_f32(vmulq_f32(rz, ix), vmulq_f32(iz, rx))), two);
+
+    // rotation
+    float32x4_t uvx = vsubq_f32(vmulq_f32(ry, pz), vmulq_f32(py, rz));
+    float32x4_t uvy = vsubq_f32(vmulq_f32(rz, px), vmulq_f32(pz, rx));
+    float32x4_t uvz = vsubq_f32(vmulq_f32(rx, py), vmulq_f32(px, ry));
+    float32x4_t uuvx = vsubq_f32(vmulq_f32(ry, uvz), vmulq_f32(uvy, rz));
+    float32x4_t uuvy = vsubq_f32(vmulq_f32(rz, uvx), vmulq_f32(uvz, rx));
+
+    float32x4_t fx = vaddq_f32(vaddq_f32(px, vmulq_f32(vaddq_f32(vmulq_f32(uvx, rw), uuvx), two)), tx);
+    float32x4_t fy = vaddq_f32(vaddq_f32(py, vmulq_f32(vaddq_f32(vmulq_f32(uvy, rw), uuvy), two)), ty);
+
+    float final_x[4], final_y[4];
+    vst1q_f32(final_x, fx);
+    vst1q_f32(final_y, fy);
+    scatterPts(data_in, start_pt, num_lane_pts, final_x, final_y);
+}
+
+static void skinBlockNeon(const meshSkinningData& data_in, int32 block_index)
+{
+    skinLanesNeon(data_in, block_index, 0);
+    skinLanesNeon(data_in, block_index, 4);
+}
+#endif
+
+bool isMeshSkinningModeSupported(meshSkinningMode mode_in)
+{
+    switch(mode_in)
+    {
+    case MESH_SKINNING_SCALAR:
+        return true;
+#if MESH_SKINNING_X86
+    case MESH_SKINNING_SSE:
+        return true;
+    case MESH_SKINNING_AVX2:
+    {
+        static const bool has_avx2 = cpuSupportsAvx2();
+        return has_avx2;
+    }
+#endif
+#if MESH_SKINNING_ARM64
+    case MESH_SKINNING_NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+meshSkinningMode getBestMeshSkinningMode()
+{
+    if(isMeshSkinningModeSupported(MESH_SKINNING_AVX2)) {
+        return MESH_SKINNING_AVX2;
+    }
+    else if(isMeshSkinningModeSupported(MESH_SKINNING_SSE)) {
+        return MESH_SKINNING_SSE;
+    }
+    else if(isMeshSkinningModeSupported(MESH_SKINNING_NEON)) {
+        return MESH_SKINNING_NEON;
+    }
+
+    return MESH_SKINNING_SCALAR;
+}
+
+meshSkinningMode setMeshSkinningMode(meshSkinningMode mode_in)
+{
+    active_skinning_mode = isMeshSkinningModeSupported(mode_in) ? mode_in : MESH_SKINNING_SCALAR;
+    return active_skinning_mode;
+}
+
+meshSkinningMode getMeshSkinningMode()
+{
+    return active_skinning_mode;
+}
+
+const char * getMeshSkinningModeName(meshSkinningMode mode_in)
+{
+    switch(mode_in)
+    {
+    case MESH_SKINNING_SSE:
+        return "sse";
+    case MESH_SKINNING_AVX2:
+        return "avx2";
+    case MESH_SKINNING_NEON:
+        return "neon";
+    default:
+        return "scalar";
+    }
+}
+
+void meshSkinBlock(const meshSkinningData& data_in,
+                   int32 block_index,
+                   meshSkinningMode mode_in)
+{
+    switch(mode_in)
+    {
+#if MESH_SKINNING_X86
+    case MESH_SKINNING_SSE:
+        skinBlockSse(data_in, block_index);
+        break;
+    case MESH_SKINNING_AVX2:
+        skinBlockAvx2(data_in, block_index);
+        break;
+#endif
+#if MESH_SKINNING_ARM64
+    case MESH_SKINNING_NEON:
+        skinBlockNeon(data_in, block_index);
+        break;
+#endif
+    default:
+        skinBlockScalar(data_in, block_index);
+        break;
+    }
+}
@@ -42,6 +42,14 @@ void JsonAllocator::deallocate() {
 	}
 }
 
+size_t JsonAllocator::getAllocatedSize() const {
+	size_t size = 0;
+	for (Zone *zone = head; zone; zone = zone->next) {
+		size += (zone->used <= JSON_ZONE_SIZE) ? JSON_ZONE_SIZE : zone->used;
+	}
+	return size;
+}
+
 static inline bool isdelim(char c) {
 	return isspace(c) || c == ',' || c == ':' || c == ']' || c == '}' || c == '\0';
 }
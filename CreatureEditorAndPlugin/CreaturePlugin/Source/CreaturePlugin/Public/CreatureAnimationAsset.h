@@ -8,6 +8,10 @@
 #include "Materials/MaterialInterface.h"
 #include "CreatureAnimationAsset.generated.h"
 
+namespace CreatureModule {
+	class CreaturePointCache;
+}
+
 /** Container used to cache useful data about an animation, including it's point cache */
 USTRUCT(BlueprintType)
 struct FCreatureAnimationDataCache
@@ -48,14 +52,25 @@ public:
 	UPROPERTY()
 	FString CreatureRawJSONString;
 
+	// Cooked binary character data, loaded instead of the json when available
+	UPROPERTY()
+	TArray<uint8> CreatureCookedBinary;
+
 	FString& GetJsonString();
 
+	// Returns the cooked binary data or nullptr if the asset has not been cooked
+	TArray<uint8>* GetCookedBinary();
+
 	void SetNewJsonString(FString& str_in);
 	
 	/** The approximation level to use when generating the point cache (range 0-20; 0=no approximation, -1=no cache generated) */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Creature)
 	int32 m_pointsCacheApproximationLevel;
 
+	/** Stores the loaded point caches at 16 bits within their bounds, a quarter of the float memory */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category=Creature)
+	bool m_pointsCacheQuantize;
+
 	const FCreatureAnimationDataCache *GetDataCacheForClip(const FName & clipName) const;
 
 	float GetClipLength(const FName & clipName) const;
@@ -98,4 +113,7 @@ protected:
 	/** Cache of useful data, including point cache, for the animation clips, to improve runtime performance */
 	UPROPERTY(VisibleAnywhere, Category = Creature)
 	TArray<FCreatureAnimationDataCache> m_dataCache;
+
+	// Point caches built from m_dataCache, shared by every creature loaded from this asset
+	mutable TMap<FName, TSharedPtr<CreatureModule::CreaturePointCache>> m_sharedPointCaches;
 };
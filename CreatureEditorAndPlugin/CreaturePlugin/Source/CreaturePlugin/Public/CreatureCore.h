@@ -62,6 +62,31 @@ struct FCreatureBoneData
 	FName name;
 };
 
+// Resident memory of one loaded creature file, see CreatureCore::GetDataPacketStats()
+struct FCreatureDataPacketStats
+{
+	FCreatureDataPacketStats()
+		: ref_count(0), json_bytes(0), binary_bytes(0), is_mapped(false), template_bytes(0), animation_bytes(0)
+	{}
+
+	// Memory mapped cooked data is paged in by the OS and not counted
+	int64 GetTotalBytes() const
+	{
+		return json_bytes + (is_mapped ? 0 : binary_bytes) + template_bytes + animation_bytes;
+	}
+
+	FName filename;
+	// Creatures using the file
+	int32 ref_count;
+	// Json source and parsed DOM, 0 once released
+	int64 json_bytes;
+	int64 binary_bytes;
+	bool is_mapped;
+	int64 template_bytes;
+	// Decoded animation clips, including those loaded on demand
+	int64 animation_bytes;
+};
+
 class CreatureCore;
 class CreatureMeshDataModifier
 {
@@ -100,6 +125,20 @@ public:
 
 	bool InitCreatureRender();
 
+	// Works out the file this creature loads from, returns false if there is none
+	bool ResolveLoadFilename(FName& load_filename_out);
+
+	// Starts loading the data packet, creature and animations of this creature on a worker thread.
+	// ready_callback runs from UpdateAsyncLoads() once they are in, after which InitCreatureRender()
+	// finds everything loaded. Returns false if there is nothing to load in the background, the
+	// data is already loaded or missing, and InitCreatureRender() can be called right away
+	bool RequestAsyncLoad(std::function<void (bool)> ready_callback);
+
+	// Runs the callbacks of finished background loads, call from the game thread
+	static void UpdateAsyncLoads();
+
+	static bool IsDataPacketLoaded(const FName& filename_in);
+
 	void InitValues();
 
 	void FillBoneData();
@@ -116,6 +155,9 @@ public:
 	// Loads a data packet from a string in memory
 	static bool LoadDataPacket(const FName& filename_in,FString* pSourceData);
 
+	// Loads a data packet from cooked binary data in memory
+	static bool LoadDataPacket(const FName& filename_in, const TArray<uint8>* pCookedData);
+
 	// Frees up memory from loading the data packets, this will force the reparsing of JSON strings if
 	// the asset is requested again
 	static void ClearAllDataPackets();
@@ -128,6 +170,26 @@ public:
 	// Loads an animation from a file
 	static void LoadAnimation(const FName& filename_in, const FName& name_in);
 
+	// Hints that a clip of a file loaded on demand is played soon, it gets decoded in the background
+	static void PrefetchAnimation(const FName& filename_in, const FName& name_in);
+
+	// Memory budget in bytes for the decoded clips of each file loaded on demand, 0 never evicts
+	static void SetOnDemandAnimationBudget(int64 bytes_in);
+
+	// Memory budget in bytes for all loaded creature files. Once over it, files no creature uses
+	// anymore are freed, least recently used first. 0 keeps every file until freed by hand
+	static void SetDataPacketBudget(int64 bytes_in);
+
+	// Frees unused files until back under the budget
+	static void TrimDataPackets();
+
+	// Returns whether any creature still uses the file's creature or animations
+	static bool IsDataPacketInUse(const FName& filename_in);
+
+	static void GetDataPacketStats(TArray<FCreatureDataPacketStats>& out_stats);
+
+	static int64 GetDataPacketResidentBytes();
+
 	// Loads the creature character from a file
 	TArray<FProceduralMeshTriangle>& LoadCreature(const FName& filename_in);
 
@@ -141,12 +203,26 @@ public:
 
 	void SetBluePrintBlendActiveAnimation(FName name_in, float factor);
 
+	bool SetBluePrintBlendSpace(const TArray<FName>& names_in, bool sync_phase);
+
+	void SetBluePrintBlendSpaceWeights(const TArray<float>& weights_in);
+
+	void ClearBluePrintBlendSpace();
+
 	void SetBluePrintAnimationCustomTimeRange(FName name_in, int32 start_time, int32 end_time);
 
 	void SetTimeScale(float timeScale);
 
 	void MakeBluePrintPointCache(FName name_in, int32 approximation_level);
 
+	// Builds the point cache on a worker thread, or lazily as the animation plays. The finished
+	// cache is picked up by CollectPointCaches()
+	void MakeBluePrintPointCacheInBackground(FName name_in, int32 approximation_level);
+
+	void MakeBluePrintPointCacheLazy(FName name_in);
+
+	void CollectPointCaches();
+
 	void ClearBluePrintPointCache(FName name_in, int32 approximation_level);
 
 	FTransform GetBluePrintBoneXform(FName name_in, bool world_transform, float position_slide_factor, const FTransform& base_transform) const;
@@ -186,6 +262,13 @@ public:
 
 	bool RunTick(float delta_time);
 
+	// RunTick() split in two for crowd updates. The manager step is queued into crowd_in
+	// when it can be batched, otherwise the whole tick runs right away. Call
+	// FinishCrowdTick() once crowd_in has run
+	bool QueueCrowdTick(float delta_time, CreatureModule::CreatureCrowd& crowd_in);
+
+	void FinishCrowdTick();
+
 	// Sets the an active animation by name
 	void SetActiveAnimation(const FName& name_in);
 
@@ -226,6 +309,8 @@ public:
 	float bone_data_length_factor;
 	float region_overlap_z_delta;
 	bool smooth_transitions;
+	bool bone_space_blending;
+	bool load_animations_on_demand;
 	FName start_animation_name;
 	float animation_frame;
 	TArray<FProceduralMeshTriangle> draw_triangles;
@@ -244,7 +329,11 @@ public:
 	bool should_process_animation_start, should_process_animation_end;
 	bool do_file_warning;
 	bool should_update_render_indices;
+	// set when uvs or region colours changed since the mesh last picked them up
+	bool should_update_render_uvs, should_update_render_colors;
+	bool had_render_uv_changes;
 	bool run_morph_targets;
+	bool crowd_tick_queued;
 	TSharedPtr<FCriticalSection, ESPMode::ThreadSafe> update_lock;
 	TSharedPtr<CreatureMeshDataModifier> mesh_modifier;
 
@@ -254,6 +343,8 @@ public:
 
 	bool bUsingCreatureAnimatinAsset=false;
 	FString* pJsonData;
+	// Cooked binary data, preferred over pJsonData when set
+	TArray<uint8>* pCookedData;
 	CreatureMetaData * meta_data;
 	glm::uint32 * global_indices_copy;
 	bool skin_swap_active;
@@ -262,6 +262,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureMeshAnimationStartEvent, fl
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureMeshAnimationEndEvent, float, frame);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureFrameCallbackEvent, FName, name);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureRepeatFrameCallbackEvent, FName, name);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCreatureMeshLoadedEvent, bool, success);
 
 /**
 * Tick function that processes the results of the creature core update
@@ -356,6 +357,22 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
 	bool smooth_transitions;
 
+	/** Blends transitions on the bones and skins once, cheaper than skinning both animations */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	bool bone_space_blending;
+
+	/** Keeps one tangent basis for the flat mesh instead of recomputing it per triangle every frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	bool flat_tangents;
+
+	/** Decodes animation clips the first time they are played instead of all of them on load */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	bool load_animations_on_demand;
+
+	/** Loads the creature data on a worker thread, the component stays empty until it is in */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	bool load_in_background;
+
 	/** Starting animation clip */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
 	FName start_animation_name;
@@ -398,6 +415,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
 	bool run_task_multicore;
 
+	// Batches this character with every other component in the world that has this enabled.
+	// They are all stepped together once per frame, bones in parallel per character and
+	// skinning in a single pass, which suits large crowds of the same character.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
+	bool use_crowd_update;
+
 	/** Activates/Deactivates anchor points in the character if it was setup in the Creature Animation Editor */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Components|Creature")
 	bool use_anchor_points;
@@ -419,6 +442,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Components|Creature")
 	FCreatureRepeatFrameCallbackEvent CreatureRepeatFrameCallbackEvent;
 
+	/** Event that is triggered when a background load has finished and the creature is ready */
+	UPROPERTY(BlueprintAssignable, Category = "Components|Creature")
+	FCreatureMeshLoadedEvent CreatureLoadedEvent;
+
 	// Blueprint version of setting the active animation name
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature", meta=(DeprecatedFunction, DeprecationMessage="Please replace with _Name version of this function to improve performance"))
 	void SetBluePrintActiveAnimation(FString name_in);
@@ -435,6 +462,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
 	void SetBluePrintBlendActiveAnimation_Name(FName name_in, float factor);
 
+	// Plays every animation of a blend space at once with its weight, in a single skinning pass. With
+	// sync_phase the animations share a normalized play position. The first animation starts fully weighted
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	bool SetBluePrintBlendSpace(const TArray<FName>& names_in, bool sync_phase = true);
+
+	// Sets the blend space weights, in SetBluePrintBlendSpace() order
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	void SetBluePrintBlendSpaceWeights(const TArray<float>& weights_in);
+
+	// Goes back to playing the active animation
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	void ClearBluePrintBlendSpace();
+
+	// Decodes an animation in the background ahead of playing it, when loading animations on demand
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	void PrefetchBluePrintAnimation(FName name_in);
+
+	// Returns whether the creature is still loading in the background
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	bool IsBluePrintCreatureLoading() const;
+
 	// Blueprint version of returning the curernt active animation name
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
 	FName GetBluePrintActiveAnimationName();
@@ -469,6 +517,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
 	void MakeBluePrintPointCache_Name(FName name_in, int32 approximation_level);
 
+	// Blueprint function to create a point cache on a worker thread. The mesh keeps playing normally
+	// until the cache is done. approximation_level is the same as for MakeBluePrintPointCache_Name
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	void MakeBluePrintPointCacheInBackground_Name(FName name_in, int32 approximation_level);
+
+	// Blueprint function to fill the point cache of an animation frame by frame as it first plays them
+	UFUNCTION(BlueprintCallable, Category = "Components|Creature")
+	void MakeBluePrintPointCacheLazy_Name(FName name_in);
+
 	// Blueprint function to clear the point cache of a given animation
 	UFUNCTION(BlueprintCallable, Category = "Components|Creature", meta=(DeprecatedFunction, DeprecationMessage = "Please replace with _Name version of this function to improve performance"))
 	void ClearBluePrintPointCache(FString name_in, int32 approximation_level);
@@ -672,6 +729,7 @@ public:
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 
 	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 	virtual void RegisterComponentTickFunctions(bool bRegister) override;
 	void RegisterCoreResultsTickFunction(bool bRegister);
 
@@ -709,6 +767,9 @@ protected:
 	TArray<FCreatureRepeatFrameCallback> repeat_frame_callbacks;
 	TSharedPtr<CreaturePhysicsData> physics_data;
 	FString delay_bendphysics_clip;
+	// set while the creature data loads in the background, the id tells stale loads apart
+	bool is_loading_async;
+	int32 async_load_id;
 
 	void InitStandardValues();
 
@@ -724,11 +785,22 @@ protected:
 
 	bool RunTickProcessing(float DeltaTime, bool markDirty);
 
+	void QueueCrowdTick(float DeltaTime);
+
+	void FinishCrowdTick();
+
+	static void RunCrowdTicks(UWorld * world_in);
+
 	/** Update systems */
 	void ProcessCreatureCoreResult(FCreatureCoreResultTickFunction& ThisTickFunction);
 
 	void StandardInit();
 
+	// Rest of StandardInit() once the creature data is loaded
+	void FinishStandardInit();
+
+	void FinishAsyncLoad(bool success_in);
+
 	void CollectionInit();
 
 	void SwitchToCollectionClip(FCreatureMeshCollectionClip * clip_in);
@@ -765,6 +837,9 @@ protected:
 	// future used for async creature processing
 	TFuture<bool> creatureTickResult;
 
+	// result of the last crowd tick
+	bool crowdTickResult;
+
 	FCreatureCoreResultTickFunction EndPhysicsTickFunction;
 	friend struct FCreatureCoreResultTickFunction;
 
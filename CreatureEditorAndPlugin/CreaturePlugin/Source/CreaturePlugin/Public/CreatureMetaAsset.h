@@ -274,9 +274,9 @@ public:
 		TArray<float> weights;
 		FVector2D bounds_min, bounds_max;
 		int morph_res;
-		TArray<TTuple<FName, float>> play_anims_data;
-		TTuple<FName, float> play_center_anim_data;
-		TArray<glm::float32> play_pts;
+		// Center clip first if there is one, then the morph clips, posed as one blend space
+		TArray<FName> play_clip_names;
+		TArray<float> play_weights;
 		FVector2D play_img_pt;
 
 		bool isValid() const {
@@ -41,16 +41,51 @@
 #include <unordered_map>
 #include "gason.h"
 #include "MeshBone.h"
+#include <Runtime/Core/Public/Async/Future.h>
 #include <fstream>
 #include <sstream>
 
+class IMappedFileHandle;
+class IMappedFileRegion;
+
 namespace CreatureModule {
     
+    // Memory holding cooked binary data, either an owned copy or a read only memory mapped file.
+    // Animations loaded from it keep a reference, their caches point straight into the data.
+    class CreatureBinaryStorage {
+    public:
+        CreatureBinaryStorage();
+        
+        virtual ~CreatureBinaryStorage();
+        
+        // Copies a buffer into owned memory
+        void SetFromBuffer(const uint8 * data_in, int64 size_in);
+        
+        // Maps a file read only, falls back to reading it into owned memory
+        // if the platform cannot map it
+        bool LoadFromFile(const FName& filename_in);
+        
+        const uint8 * GetData() const;
+        
+        int64 GetSize() const;
+        
+        // Returns whether the data is a memory mapped file region
+        bool IsMapped() const;
+        
+    protected:
+        void Release();
+        
+        TArray<uint8> owned_data;
+        IMappedFileHandle * mapped_handle;
+        IMappedFileRegion * mapped_region;
+    };
+    
     class CreatureLoadDataPacket {
     public:
         CreatureLoadDataPacket()
         {
             src_chars = NULL;
+            src_size = 0;
         }
         
         ~CreatureLoadDataPacket()
@@ -61,9 +96,47 @@ namespace CreatureModule {
             }
         }
         
+        // Returns whether this packet holds cooked binary data instead of json
+        bool IsBinary() const
+        {
+            return binary_storage.IsValid() && (binary_storage->GetSize() > 0);
+        }
+        
+        // Returns whether the json source and its parsed DOM are still held
+        bool HasJsonData() const
+        {
+            return src_chars != NULL;
+        }
+        
+        // Heap bytes of the json source and its parsed DOM
+        int64 GetJsonBytes() const
+        {
+            return HasJsonData() ? (src_size + (int64)allocator.getAllocatedSize()) : 0;
+        }
+        
+        // Frees the json source and DOM, for once the creature and every animation
+        // that will ever be needed have been built from them
+        void ReleaseJsonData()
+        {
+            if(src_chars)
+            {
+                delete [] src_chars;
+                src_chars = NULL;
+            }
+            
+            src_size = 0;
+            allocator.deallocate();
+            base_node = JsonValue();
+        }
+        
         JsonValue base_node;
         JsonAllocator allocator;
         char * src_chars;
+        int64 src_size;
+        
+        // Cooked binary data and its decoded name table, see LoadCreatureBinaryData()
+        TSharedPtr<CreatureBinaryStorage> binary_storage;
+        TArray<FName> binary_names;
     };
     
     // Opens the json file and returns the entire json structure for a creature
@@ -80,6 +153,29 @@ namespace CreatureModule {
     // Use this to load your creatures and animatons
     void LoadCreatureJSONDataFromString(const FString& string_in,
                                         CreatureLoadDataPacket& load_data);
+    
+    // Opens a cooked binary creature file written by SaveCreatureBinaryData()
+    // The creature and its animations are then loaded without any json parsing.
+    // The file is memory mapped and animation caches read from it in place, so
+    // characters sharing a file only page it in once.
+    bool LoadCreatureBinaryData(const FName& filename_in,
+                                CreatureLoadDataPacket& load_data);
+    
+    // Returns whether a file starts with a cooked binary creature header
+    bool IsCreatureBinaryFile(const FName& filename_in);
+    
+    // Loads cooked binary creature data from a buffer in memory
+    bool LoadCreatureBinaryDataFromBuffer(const uint8 * data_in,
+                                          int64 size_in,
+                                          CreatureLoadDataPacket& load_data);
+    
+    // Returns whether a buffer starts with a cooked binary creature header
+    bool IsCreatureBinaryData(const uint8 * data_in, int64 size_in);
+    
+    // Cooks a json data packet into the binary format: mesh, skeleton, weights and
+    // the fully gap filled per frame animation caches laid out as flat arrays
+    bool SaveCreatureBinaryData(CreatureLoadDataPacket& load_data,
+                                TArray<uint8>& out_data);
 
 	struct CreatureUVSwapPacket {
 		CreatureUVSwapPacket(const glm::vec2& local_offset_in,
@@ -99,13 +195,77 @@ namespace CreatureModule {
 		int32 tag;
 	};
     
+    // Immutable data of a creature character: rest mesh, topology, skeleton, region
+    // metadata and skinning weights. Every Creature made from the same template
+    // shares this instead of holding its own copy.
+    class CreatureTemplate {
+    public:
+        CreatureTemplate(CreatureLoadDataPacket& load_data);
+        
+        virtual ~CreatureTemplate();
+        
+        // Returns the global indices
+        glm::uint32 * GetGlobalIndices() const;
+        
+        // Returns the global rest points
+        glm::float32 * GetGlobalPts() const;
+        
+        // Returns the rest uvs
+        const glm::float32 * GetGlobalUvs() const;
+        
+        // Returns the total number of points
+        int32 GetTotalNumPoints() const;
+        
+        // Returns the total number of indices
+        int32 GetTotalNumIndices() const;
+        
+        // Returns the rest skeleton and regions instances are cloned from
+        meshRenderBoneComposition * GetRestComposition() const;
+        
+        // Get Available Animation names. Note that these animations might not have been loaded yet.
+        const TArray<FName>& GetAnimationNames() const;
+        
+        // Returns the UV Swap Item Packet map
+        const TMap<FName, TArray<CreatureUVSwapPacket> >& GetUvSwapPackets() const;
+        
+        // Returns the Anchor Point map
+        const TMap<FName, glm::vec2>& GetAnchorPoints() const;
+        
+        // Heap bytes of the rest mesh arrays
+        int64 GetAllocatedSize() const;
+        
+    protected:
+        
+        void LoadFromData(CreatureLoadDataPacket& load_data);
+        
+        void LoadFromBinaryData(CreatureLoadDataPacket& load_data);
+        
+        void SetupRestComposition(meshBone * root_bone,
+                                  TArray<meshRenderRegion *>& regions);
+        
+        glm::uint32 * global_indices;
+        glm::float32 * global_pts, * global_uvs;
+        int32 total_num_pts, total_num_indices;
+        meshRenderBoneComposition * rest_composition;
+        TArray<FName> animation_names;
+        TMap<FName, TArray<CreatureUVSwapPacket> > uv_swap_packets;
+        TMap<FName, glm::vec2> anchor_point_map;
+    };
+    
     // Class for the creature character
     class Creature {
     public:
+        // Loads a private template from the data packet
         Creature(CreatureLoadDataPacket& load_data);
         
+        // Creates a new instance sharing the template's rest mesh and weights
+        Creature(TSharedPtr<CreatureTemplate> template_in);
+        
         virtual ~Creature();
         
+        // Returns the shared template this creature was created from
+        TSharedPtr<CreatureTemplate> GetTemplate() const;
+        
         // Fills entire mesh with (r,g,b,a) colours
         void FillRenderColours(glm::uint8 r, glm::uint8 g, glm::uint8 b, glm::uint8 a);
         
@@ -115,7 +275,8 @@ namespace CreatureModule {
         // Returns the global rest points
         glm::float32 * GetGlobalPts();
         
-        // Returns the global uvs
+        // Returns the global uvs, these belong to the instance since uv warps
+        // and item swaps write into them
         glm::float32 * GetGlobalUvs();
         
         // Returns the render points
@@ -159,22 +320,70 @@ namespace CreatureModule {
     
     protected:
         
-        void LoadFromData(CreatureLoadDataPacket& load_data);
+        void InitFromTemplate();
         
-        // mesh and skeleton data
-        glm::uint32 * global_indices;
-        glm::float32 * global_pts, * global_uvs;
+        // shared mesh data and per instance pose state
+        TSharedPtr<CreatureTemplate> creature_template;
+        glm::float32 * global_uvs;
         glm::float32 * render_pts;
         glm::uint8 * render_colours;
-        int32 total_num_pts, total_num_indices;
         meshRenderBoneComposition * render_composition;
-        TArray<FName> animation_names;
-		TMap<FName, TArray<CreatureUVSwapPacket> > uv_swap_packets;
 		TMap<FName, int32> active_uv_swap_actions;
-		TMap<FName, glm::vec2> anchor_point_map;
 		bool anchor_points_active;
     };
     
+    // Posed points of an animation for every frame, shared by every instance playing it. Only x
+    // and y are stored, all frames in one allocation, optionally as 16 bits within the bounds
+    class CreaturePointCache {
+    public:
+        CreaturePointCache(int32 num_pts_in, int32 start_time_in, int32 reserve_frames_in=0);
+        
+        // Appends a frame of x, y, z points
+        void addFrame(const glm::float32 * pts_in);
+        
+        // Makes room for num_frames_in frames that are filled in any order by setFrame()
+        void initFrames(int32 num_frames_in);
+        
+        void setFrame(int32 frame_in, const glm::float32 * pts_in);
+        
+        bool hasFrame(int32 frame_in) const;
+        
+        // Returns whether every frame is filled
+        bool isComplete() const;
+        
+        // Frames interpolated between to pose at time_in
+        void getFramesAtTime(float time_in, int32& floor_frame_out, int32& ceil_frame_out) const;
+        
+        int32 getStartTime() const;
+        
+        // Stores the frames as 16 bits relative to the bounds of all frames
+        void quantize();
+        
+        bool isQuantized() const;
+        
+        int32 getNumFrames() const;
+        
+        int32 getNumPts() const;
+        
+        // Writes x, y, z points interpolated between the frames around time_in, z is 0
+        void poseAtTime(float time_in, glm::float32 * target_pts) const;
+        
+        // Writes the x, y, z points of one frame
+        void getFramePts(int32 frame_in, glm::float32 * target_pts) const;
+        
+        int64 getAllocatedSize() const;
+        
+    protected:
+        int32 getIndexByTime(int32 time_in) const;
+        
+        int32 num_pts, start_time, num_frames;
+        TArray<glm::float32> frame_pts;
+        TArray<uint8> frames_ready;
+        int32 num_missing_frames;
+        TArray<uint16> quantized_pts;
+        glm::vec2 bounds_min, bounds_step;
+    };
+    
     // Class for animating the creature character
     class CreatureAnimation {
     public:
@@ -207,26 +416,156 @@ namespace CreatureModule {
         
         bool hasCachePts() const;
         
-        TArray<glm::float32 *>& getCachePts();
+        const TSharedPtr<CreaturePointCache>& getPointCache() const;
+        
+        // Point caches can be shared with other animations of the same character
+        void setPointCache(TSharedPtr<CreaturePointCache> cache_in);
 
 		void clearCachePts();
         
         void poseFromCachePts(float time_in, glm::float32 * target_pts, int32 num_pts);
         
+        // Heap bytes held by the animation caches, point caches are not counted
+        int64 getAllocatedSize() const;
+        
     protected:
         
         void LoadFromData(const FName& name_in,
                           CreatureLoadDataPacket& load_data);
         
-        int32 getIndexByTime(int32 time_in) const;
-
+        void LoadFromBinaryData(const FName& name_in,
+                                CreatureLoadDataPacket& load_data);
+        
         FName name;
         float start_time, end_time;
         meshBoneCacheManager bones_cache;
         meshDisplacementCacheManager displacement_cache;
         meshUVWarpCacheManager uv_warp_cache;
 		meshOpacityCacheManager opacity_cache;
-		TArray<glm::float32 *> cache_pts;
+		TSharedPtr<CreaturePointCache> point_cache;
+        // Keeps cooked data alive while the caches point into it
+        TSharedPtr<CreatureBinaryStorage> binary_storage;
+    };
+    
+    // Decodes the animation clips of a data packet the first time they are asked for
+    // instead of all of them up front. Clips are shared by every CreatureManager using
+    // the library, Prefetch() decodes them ahead of time on a worker thread and once the
+    // resident clips go over the memory budget the least recently used ones nobody else
+    // holds on to are evicted. Meant to be used from the game thread only.
+    class CreatureAnimationLibrary {
+    public:
+        CreatureAnimationLibrary(TSharedPtr<CreatureLoadDataPacket> load_data_in,
+                                 const TArray<FName>& animation_names_in);
+        
+        virtual ~CreatureAnimationLibrary();
+        
+        // Names of every clip in the data packet
+        const TArray<FName>& GetAnimationNames() const;
+        
+        bool HasAnimation(const FName& name_in) const;
+        
+        bool IsAnimationResident(const FName& name_in) const;
+        
+        // Returns the clip, decoding it or waiting for its prefetch if it is not resident
+        TSharedPtr<CreatureAnimation> GetAnimation(const FName& name_in);
+        
+        // Hint that a clip is needed soon, it is decoded on a worker thread
+        void Prefetch(const FName& name_in);
+        
+        // Waits for every prefetch in flight
+        void FlushPrefetches();
+        
+        // Budget for the resident clips in bytes, 0 never evicts
+        void SetMemoryBudget(int64 bytes_in);
+        
+        int64 GetMemoryBudget() const;
+        
+        int64 GetResidentBytes() const;
+        
+        int32 GetNumResidentAnimations() const;
+        
+        bool IsOverBudget() const;
+        
+        // Evicts unused clips, least recently used first, until back under the budget
+        void Trim();
+        
+    protected:
+        struct residentClip {
+            residentClip() : resident_bytes(0), last_used(0) {}
+            
+            TSharedPtr<CreatureAnimation> animation;
+            int64 resident_bytes;
+            uint64 last_used;
+        };
+        
+        residentClip& AddResidentClip(const FName& name_in, CreatureAnimation * animation_in);
+        
+        // Moves finished prefetches into the resident clips
+        void CollectPrefetches();
+        
+        TSharedPtr<CreatureLoadDataPacket> load_data;
+        TArray<FName> animation_names;
+        TMap<FName, residentClip> resident_clips;
+        TMap<FName, TFuture<CreatureAnimation *> > pending_clips;
+        int64 memory_budget, resident_bytes;
+        uint64 use_counter;
+    };
+    
+    // What a CreatureAsyncLoader builds for one file
+    struct CreatureAsyncLoadResult {
+        CreatureAsyncLoadResult() : success(false) {}
+        
+        FName filename;
+        bool success;
+        TSharedPtr<CreatureLoadDataPacket> load_data;
+        TSharedPtr<CreatureTemplate> creature_template;
+        // Empty unless the animations were asked for
+        TArray<TSharedPtr<CreatureAnimation> > animations;
+    };
+    
+    // Loads data packets on worker threads. The file is read and parsed, then the creature
+    // template and optionally every animation are built, all off the calling thread.
+    // Requesting a file that is already loading joins that load. Update() runs the ready
+    // callbacks of finished loads and must be called from the thread making the requests.
+    class CreatureAsyncLoader {
+    public:
+        typedef std::function<void (const CreatureAsyncLoadResult&)> readyCallback;
+        typedef std::function<bool (CreatureLoadDataPacket&)> loadFunction;
+        
+        CreatureAsyncLoader();
+        
+        // Waits for the loads still running, their callbacks are not called
+        virtual ~CreatureAsyncLoader();
+        
+        // Loads a json or cooked binary file
+        void RequestFile(const FName& filename_in, bool build_animations, readyCallback callback_in);
+        
+        // Fills the packet with load_func, e.g. to parse data already in memory. filename_in
+        // names the load for joining requests
+        void Request(const FName& filename_in,
+                     loadFunction load_func,
+                     bool build_animations,
+                     readyCallback callback_in);
+        
+        bool IsLoading(const FName& filename_in) const;
+        
+        int32 GetNumLoading() const;
+        
+        // Runs the callbacks of finished loads, returns the number of loads finished
+        int32 Update();
+        
+        // Waits for every load and runs their callbacks
+        void Flush();
+        
+    protected:
+        struct pendingLoad {
+            TFuture<CreatureAsyncLoadResult *> result;
+            TArray<readyCallback> callbacks;
+        };
+        
+        void FinishLoad(const FName& filename_in);
+        
+        TMap<FName, pendingLoad> pending_loads;
     };
     
     // Class for managing a collection of animations and a creature character
@@ -247,6 +586,15 @@ namespace CreatureModule {
         CreatureModule::CreatureAnimation *
         GetAnimation(const FName name_in);
         
+        // Clips missing from the manager are added from the library when they are
+        // made active or blended to
+        void SetAnimationLibrary(TSharedPtr<CreatureAnimationLibrary> library_in);
+        
+        CreatureAnimationLibrary * GetAnimationLibrary();
+        
+        // Removes the library clips that are not playing or blending so the library can evict them
+        void ReleaseInactiveAnimations();
+        
         // Return the creature
         CreatureModule::Creature *
         GetCreature();
@@ -284,6 +632,17 @@ namespace CreatureModule {
         
         // Runs a single step of the animation for a given delta timestep
         void Update(float delta);
+
+        // Update() split in two for batched crowd updates. BeginUpdate() advances the
+        // animation and queues the skinning into GetPoseScheduler() instead of running it.
+        // Once that scheduler has run, EndUpdate() finishes the step. Returns false if
+        // the animation is not playing, in which case EndUpdate() is not needed
+        bool BeginUpdate(float delta);
+
+        void EndUpdate();
+
+        // Scheduler holding the skinning queued by BeginUpdate()
+        meshPoseScheduler& GetPoseScheduler();
         
         // Sets scaling for time
         void SetTimeScale(float scale_in);
@@ -299,6 +658,27 @@ namespace CreatureModule {
         
         // Sets the blending factor
         void SetBlendingFactor(float value_in);
+
+        // Blends bone positions and displacements of the blended clips and skins the result
+        // once, instead of skinning every clip and blending the points
+        void SetBoneBlending(bool flag_in);
+
+        bool GetBoneBlending() const;
+
+        // Plays a blend space: every clip is evaluated with its weight in one update and skinned
+        // once. With sync_phase_in the clips share a normalized play position, for cycles of
+        // different lengths. The first clip starts fully weighted. Overrides blending until cleared
+        bool SetBlendSpace(const TArray<FName>& names_in, bool sync_phase_in=true);
+
+        // Weights in SetBlendSpace() order, normalized when posing. Zero weight clips are skipped.
+        // Negative weights extrapolate away from their clip, a synced phase only follows positive ones
+        void SetBlendSpaceWeights(const TArray<float>& weights_in);
+
+        void SetBlendSpaceWeight(const FName& name_in, float weight_in);
+
+        void ClearBlendSpace();
+
+        bool IsBlendSpaceActive() const;
         
         // Given a set of coordinates in local creature space,
         // see if any bone is in contact
@@ -308,6 +688,8 @@ namespace CreatureModule {
         
         // Mirrors the model along the Y-Axis
         void SetMirrorY(bool flag_in);
+
+        bool GetMirrorY() const;
         
         // Decides whether to use a custom time range or the default
         // animation clip's time range
@@ -322,8 +704,25 @@ namespace CreatureModule {
         // Sets the callback to modify/override bone positions
         void SetBonesOverrideCallback(std::function<void (TMap<FName, meshBone *>&) >& callback_in);
         
-        // Creates point cache for animation
-        void MakePointCache(const FName& animation_name_in, int32 gap_step);
+        // Creates point cache for animation, quantize_in stores it at 16 bits
+        void MakePointCache(const FName& animation_name_in, int32 gap_step, bool quantize_in=false);
+        
+        // Creates the point cache on a worker thread, posing a private instance of the creature so
+        // this one keeps animating. The bones override callback is not run for it
+        bool MakePointCacheAsync(const FName& animation_name_in, int32 gap_step, bool quantize_in=false);
+        
+        // Fills the point cache a frame at a time as playback first reaches each frame, the missing
+        // frames are posed into it. Needs point caching enabled
+        bool MakePointCacheLazy(const FName& animation_name_in, bool quantize_in=false);
+        
+        // Hands finished background and lazy point caches to their animations, which share them
+        // with other managers. Call from the thread updating the managers, returns how many were added
+        int32 CollectPointCaches();
+        
+        // Waits for the background point caches, then collects them
+        void FlushPointCaches();
+        
+        bool IsPointCachePending(const FName& animation_name_in) const;
 
 		// Clears point cache for animation
 		void ClearPointCache(const FName& animation_name_in);
@@ -344,8 +743,52 @@ namespace CreatureModule {
 		void PoseJustBones(const FName& animation_name_in, float input_run_time);
     protected:
 
+        // Cache entries of one animation resolved to indices into the bones list and
+        // regions of target_creature, so posing needs no name lookups
+        struct animationBinding {
+            animationBinding() : animation(nullptr) {}
+
+            CreatureAnimation * animation;
+            TArray<int32> bone_indices;
+            TArray<int32> displacement_indices, uv_warp_indices, opacity_indices;
+        };
+
+        // Point cache built on a worker, see MakePointCacheAsync(). The worker only gets a raw
+        // pointer to pose_manager, which holds the only references to its creature, template and
+        // clip so they are released here on the updating thread
+        struct pendingPointCache {
+            TFuture<CreaturePointCache *> result;
+            TSharedPtr<CreatureManager> pose_manager;
+        };
+
+        // Point cache filled during playback, see MakePointCacheLazy()
+        struct lazyPointCache {
+            TSharedPtr<CreaturePointCache> cache;
+            bool quantize;
+        };
+
+        // One clip of a bone space blend
+        struct blendInput {
+            blendInput() : run_time(0), weight(0) {}
+
+            blendInput(const FName& animation_name_in, float run_time_in, float weight_in)
+                : animation_name(animation_name_in), run_time(run_time_in), weight(weight_in)
+            {}
+
+            FName animation_name;
+            float run_time;
+            float weight;
+        };
+
 		bool checkAnimationBlendValid() const;
 
+        // Adds the clip from the animation library if it is missing, returns whether the clip is there
+        bool RequestAnimation(const FName& name_in);
+
+        animationBinding& GetAnimationBinding(const FName& animation_name_in);
+
+        void BindAnimation(CreatureAnimation * animation_in, animationBinding& binding_out);
+
 		float correctRunTime(float time_in, const FName& animation_name);
         
         FName ProcessContactBone(const glm::vec2& pt_in,
@@ -355,13 +798,30 @@ namespace CreatureModule {
         
         void PoseCreature(const FName& animation_name_in,
                           glm::float32 * target_pts,
-						  float input_run_time);
+						  float input_run_time,
+						  bool defer_skinning=false);
+
+		// Poses the weighted sum of the bones, displacements and colors of any number of
+		// clips with a single skinning pass. Uv warps come from the heaviest clip. Weights are
+		// signed and skipped when zero or when they sum to zero
+		void PoseCreatureBlend(const TArray<blendInput>& inputs_in,
+							   glm::float32 * target_pts,
+							   bool defer_skinning=false);
+
+		void UpdatePose(float delta, bool defer_skinning);
+
+		// Poses every frame of the animation into a new point cache
+		CreaturePointCache * BuildPointCache(const FName& animation_name_in, int32 gap_step, bool quantize_in);
+
+		void PoseFromLazyPointCache(const FName& animation_name_in, lazyPointCache& lazy_cache);
         
         void ProcessAutoBlending();
 
 		void increAutoBlendRuntimes(float delta_in);
 
-		glm::float32 * interpFloatArray(glm::float32 * first_list, glm::float32 * second_list, float factor, int32 array_size);
+		void increBlendSpaceRunTimes(float delta_in);
+
+		bool IsBlendSpaceAnimation(const FName& name_in) const;
 
 		void ResetBlendTime(const FName& name_in);
 
@@ -374,6 +834,8 @@ namespace CreatureModule {
 		void AlterBonesByAnchor(TMap<FName, meshBone *>& bones_map, const FName& animation_name_in);
         
         TMap<FName, TSharedPtr<CreatureModule::CreatureAnimation> > animations;
+        TMap<FName, animationBinding> animation_bindings;
+        TSharedPtr<CreatureAnimationLibrary> animation_library;
         TSharedPtr<CreatureModule::Creature> target_creature;
         FName active_animation_name;
         bool is_playing;
@@ -381,6 +843,7 @@ namespace CreatureModule {
         float time_scale;
         glm::float32 * blend_render_pts[2];
         bool do_blending;
+        bool do_bone_blending;
         float blending_factor;
         FName active_blend_animation_names[2];
 		TMap<FName, float> active_blend_run_times;
@@ -392,10 +855,64 @@ namespace CreatureModule {
         FName auto_blend_names[2];
         float auto_blend_delta;
 		bool do_point_caching;
+        meshPoseScheduler pose_scheduler;
+        TArray<blendInput> blend_inputs;
+        TMap<FName, pendingPointCache> pending_point_caches;
+        TMap<FName, lazyPointCache> lazy_point_caches;
+        TArray<glm::float32> lazy_pose_pts;
+        TArray<blendInput> blend_space_inputs;
+        bool blend_space_sync_phase;
+        float blend_space_phase;
+        // Weighted sums of PoseCreatureBlend(), bone start and end points and per point displacements
+        TArray<glm::vec4> blend_bone_pts;
+        TArray<glm::vec2> blend_local_displacements, blend_post_displacements;
+        TArray<glm::vec4> blend_region_colors;
+        TArray<uint8> blend_region_flags;
         
         std::function<void (TMap<FName, meshBone *>&) > bones_override_callback;
         
     };
+
+    // Steps many CreatureManagers as one batch, for crowds of characters. Managers are
+    // grouped by creature template and active animation so characters reading the same
+    // caches run back to back. Bones are evaluated in parallel, one character per task,
+    // then the regions of every character are skinned by a single pose scheduler run
+    class CreatureCrowd {
+    public:
+        CreatureCrowd();
+
+        // Queues a manager to be stepped by delta_in on the next Run()
+        void AddManager(CreatureManager * manager_in, float delta_in);
+
+        // Drops a queued manager, for managers going away before Run()
+        void RemoveManager(CreatureManager * manager_in);
+
+        // Updates every queued manager, then clears the queue
+        void Run();
+
+        int32 GetNumQueuedManagers() const;
+
+        // Number of template and animation groups in the last Run()
+        int32 GetNumGroups() const;
+
+    protected:
+        struct crowdEntry {
+            CreatureManager * manager;
+            float delta;
+        };
+
+        struct crowdGroup {
+            CreatureTemplate * creature_template;
+            FName animation_name;
+            TArray<crowdEntry> entries;
+        };
+
+        TArray<crowdGroup> groups;
+        TArray<crowdEntry> run_entries;
+        TArray<uint8> run_queued;
+        int32 num_queued_managers, last_num_groups;
+        meshPoseScheduler crowd_scheduler;
+    };
 };
 
 #endif /* defined(__CocosEngineTest__CreatureModule__) */
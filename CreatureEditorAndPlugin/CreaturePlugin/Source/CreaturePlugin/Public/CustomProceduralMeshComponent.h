@@ -12,6 +12,19 @@
 class UCustomProceduralMeshComponent;
 class FProceduralMeshRenderPacket;
 
+// Vertex streams of a render packet, flagged so only the ones that changed get rewritten
+namespace EProceduralMeshStream
+{
+	enum Type : uint8
+	{
+		Position = 1 << 0,
+		Tangent = 1 << 1,
+		TexCoord = 1 << 2,
+		Color = 1 << 3,
+		All = Position | Tangent | TexCoord | Color
+	};
+}
+
 class FProceduralMeshTriData
 {
 public:
@@ -72,6 +85,14 @@ public:
 
 	void SetNeedsIndexUpdate(bool flag_in, int32 index_new_num=-1);
 
+	// Streams the next UpdateDynamicComponentData() has to refresh, EProceduralMeshStream flags.
+	// Everything is refreshed if this is not set before an update
+	void SetNeedsVertexStreamUpdate(uint8 streams_in);
+
+	// Planar meshes keep one tangent basis instead of rebuilding it per triangle every frame,
+	// it only gets flipped when the mesh is mirrored
+	void SetFlatTangents(bool flag_in, bool mirror_in);
+
 	void UpdateMaterial();
 	
 	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views,
@@ -103,7 +124,11 @@ private:
 	bool needs_index_updating;
 	int32 needs_index_update_num;
 	bool needs_material_updating;
+	uint8 needs_vertex_streams;
+	bool use_flat_tangents, flat_tangents_mirrored;
+	bool use_compact_format;
 
+	// Guards renderPackets and the active index, the vertex streams are handed over lock-free
 	mutable FCriticalSection renderPacketsCS;
 };
 
@@ -154,6 +179,12 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category="Collision")
 	class UBodySetup* ModelBodySetup;
 
+	/** Uploads half precision positions and 16 bit uvs and keeps the tangents flat, for bandwidth bound scenes.
+	    Positions are in the local space of the mesh, so keep large offsets on the component transform.
+	    Platforms with manual vertex fetch keep full precision positions */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering")
+	bool compact_vertex_format;
+
 	// Begin Interface_CollisionDataProvider Interface
 	/*
 	virtual bool GetPhysicsTriMeshData(struct FTriMeshCollisionData* CollisionData, bool InUseAllTriData) override;
@@ -37,6 +37,7 @@
 #define __EngineApp__MeshBone__
 
 #include <iostream>
+#include <atomic>
 //#include "glm.hpp"
 #include <glm/gtx/transform.hpp>
 #include  <glm/gtc/quaternion.hpp>
@@ -47,6 +48,7 @@
 #include <glm/mat4x4.hpp> // glm::mat4
 #include <glm/gtc/matrix_transform.hpp> // glm::translate, glm::rotate, glm::scale, glm::perspective
 #include <glm/gtc/type_ptr.hpp>
+#include "MeshBoneSkinning.h"
 //#include "ext.hpp"
 
 class dualQuat {
@@ -170,6 +172,9 @@ public:
 
 	meshBone * getParent();
     
+    // Deep copies this bone and all its children, rest data included
+    meshBone * cloneHierarchy() const;
+    
 protected:
     std::pair<glm::vec4, glm::vec4> computeDirs(const glm::vec4& start_pt, const glm::vec4& end_pt);
     
@@ -196,6 +201,29 @@ protected:
 	meshBone * parent;
 };
 
+// Skinning weights of a render region. They never change once the region is
+// set up, so regions of characters created from the same template share them
+struct meshRenderRegionSkinData {
+    TMap<FName, TArray<float> > normal_weight_map;
+    // Bone keys in the order of the fast weight tables below
+    TArray<FName> fast_bone_keys;
+    // Rest points and packed influences in blocks of MESH_SKINNING_BLOCK_SIZE points,
+    // see meshSkinningData. Each point has influences_per_pt slots holding indices
+    // into fast_bone_keys and their weights. Unused slots have bone 0 and zero weight.
+    int32 num_pts;
+    int32 influences_per_pt;
+    TArray<float> rest_pts;
+    TArray<int32> influence_bones;
+    TArray<float> influence_weights;
+    
+    static const int32 max_influences = 8;
+    
+    meshRenderRegionSkinData()
+    : num_pts(0), influences_per_pt(0)
+    {
+    }
+};
+
 class meshRenderRegion {
 public:
     meshRenderRegion(glm::uint32 * indices_in,
@@ -207,6 +235,10 @@ public:
                      int32 end_index_in);
     
     virtual ~meshRenderRegion();
+    
+    // Creates a region for a new character instance. Indices, rest points and
+    // skinning weights are shared with this region, uvs are the instance's own
+    meshRenderRegion * cloneForInstance(glm::float32 * uvs_in) const;
 
     glm::uint32 * getIndices() const;
     
@@ -216,6 +248,8 @@ public:
     
     TMap<FName, TArray<float> >& getWeights();
     
+    const TSharedPtr<meshRenderRegionSkinData>& getSkinData() const;
+    
     void renameWeightValuesByKey(const FName& old_key,
                                  const FName& new_key);
     
@@ -291,6 +325,15 @@ public:
     
     void runUvWarp();
     
+    // Runs the uv warp on points [start_pt, end_pt) of the region
+    void runUvWarpRange(int32 start_pt, int32 end_pt);
+    
+    // Captures the current bone dual quaternions and returns the skinning inputs
+    // poseFastFinalPts works from, so the region can be skinned in pieces
+    meshSkinningData preparePose(glm::float32 * output_pts,
+                                 bool try_local_displacements=true,
+                                 bool try_post_displacements=true);
+    
     void restoreRefUv();
 
     int32 getTagId() const;
@@ -338,13 +381,11 @@ protected:
 	int32 uv_level;
 	float opacity;
 	float red, green, blue;
-    TMap<FName, TArray<float> > normal_weight_map;
+    TSharedPtr<meshRenderRegionSkinData> skin_data;
 //    TMap<int32, TArray<float> > fast_normal_weight_map;
     TArray<TArray<float> > fast_normal_weight_map;
-    TArray<TArray<float> > reverse_fast_normal_weight_map;
     TArray<meshBone *> fast_bones_map;
-    TArray<TArray<int32> > relevant_bones_indices;
-    TArray<dualQuat> fill_dq_array;
+    TArray<float> fill_dq_array;
     FName main_bone_key;
     meshBone * main_bone;
     bool use_dq;
@@ -372,6 +413,9 @@ public:
     
     TMap<FName, meshBone *>& getBonesMap();
     
+    // Bones in getBonesMap() order, for lookups by index
+    TArray<meshBone *>& getBonesList();
+    
     TMap<FName, meshRenderRegion *>& getRegionsMap();
     
     TArray<meshRenderRegion *>& getRegions();
@@ -386,43 +430,108 @@ protected:
     
     meshBone * root_bone;
     TMap<FName, meshBone *> bones_map;
+    TArray<meshBone *> bones_list;
     TArray<meshRenderRegion *> regions;
     TMap<FName, meshRenderRegion *> regions_map;
 };
 
-class meshBoneCache {
+// Batches the skinning of many regions, from one or many characters, into
+// balanced chunks of points that are dispatched with a single ParallelFor.
+// Batches smaller than the minimum parallel work run on the calling thread.
+class meshPoseScheduler {
 public:
-    meshBoneCache(const FName& key_in);
-    virtual ~meshBoneCache();
+    meshPoseScheduler();
     
-    void setWorldStartPt(const glm::vec4& pt_in) {
-        world_start_pt = pt_in;
-    }
-
-    void setWorldEndPt(const glm::vec4& pt_in) {
-        world_end_pt = pt_in;
-    }
-
-    const glm::vec4& getWorldStartPt() const {
-        return world_start_pt;
-    }
+    // Queues a region to be posed into output_pts by the next run(). The bone
+    // transforms are copied into the region's own dq array now, so bones can be
+    // moved again before run(). Displacements are read from the region during run().
+    // A region may be queued only once per run(), and its displacements must be
+    // left untouched until run() returns
+    void addRegion(meshRenderRegion * region_in,
+                   glm::float32 * output_pts,
+                   bool try_local_displacements=true,
+                   bool try_post_displacements=true,
+                   bool try_uv_swap=true);
     
-    const glm::vec4& getWorldEndPt() const {
-        return world_end_pt;
-    }
+    // Queues all regions of a composition, output_pts holds every point of the character
+    void addComposition(meshRenderBoneComposition * composition_in,
+                        glm::float32 * output_pts);
     
-    const FName& getKey() const {
-        return key;
-    }
+    // Moves everything queued in scheduler_in to the end of this queue
+    void takeJobs(meshPoseScheduler& scheduler_in);
     
-    void setKey(const FName& key_in)
-    {
-        key = key_in;
-    }
+    // Poses everything queued, then clears the queue
+    void run();
+    
+    int32 getNumQueuedPts() const;
+    
+    // Below this many points run() does not go parallel
+    static void setMinParallelPts(int32 value_in);
+    
+    static int32 getMinParallelPts();
+    
+    // Points handed to each parallel task
+    static void setChunkPts(int32 value_in);
+    
+    static int32 getChunkPts();
+    
+protected:
+    struct meshPoseJob {
+        meshRenderRegion * region;
+        meshSkinningData skin_data;
+        int32 first_block, num_blocks;
+        bool run_uv_warp;
+    };
+    
+    void runBlocks(int32 start_block, int32 end_block, meshSkinningMode skin_mode);
+    
+    TArray<meshPoseJob> jobs;
+    int32 total_blocks;
+};
 
+// Hands one of three slots from a writer to a reader without locks, the slots themselves
+// belong to the caller. The writer fills its own slot and publishes it, the reader swaps in
+// the newest published slot. Neither side ever waits or sees a half written slot
+class meshTripleBufferIndex {
+public:
+    meshTripleBufferIndex();
+    
+    // Slot the writer fills before publish()
+    int32 getWriteIdx() const;
+    
+    // Slot of the last publish(), -1 before the first one. The reader may hold it too,
+    // so the writer only reads from it
+    int32 getPublishedIdx() const;
+    
+    // changed_flags marks which parts of the slot differ from the last published one,
+    // only the low max_flags bits are kept
+    void publish(uint32 changed_flags = 0);
+    
+    // Newest published slot, the same slot again if nothing new was published
+    int32 acquireLatest();
+    
+    bool hasPublished() const;
+    
+    // Publish count of a slot the reader holds, starting at 1
+    uint32 getSerial(int32 slot_idx) const;
+    
+    // Flags changed after the publish numbered since_serial, up to the slot the reader holds.
+    // Copies of slot data the reader keeps record getSerial() and only refresh these flags
+    uint32 getChangedFlags(int32 slot_idx, uint32 since_serial) const;
+    
+    enum { max_flags = 8 };
+    
 protected:
-    FName key;
-    glm::vec4 world_start_pt, world_end_pt;
+    enum { ready_index_mask = 0x3, ready_fresh_bit = 0x4 };
+    
+    int32 write_idx, read_idx, published_idx;
+    // serial of the last publish and of the last publish that changed each flag, writer only.
+    // Every slot carries a copy of them that travels with it
+    uint32 cur_serial, flag_serials[max_flags];
+    uint32 slot_serials[3], slot_flag_serials[3][max_flags];
+    // index of the published slot, plus ready_fresh_bit until the reader takes it
+    std::atomic<int32> ready_state;
+    std::atomic<bool> has_published;
 };
 
 class meshDisplacementCache {
@@ -453,6 +562,10 @@ public:
 
     const TArray<glm::vec2>& getPostDisplacements() const;
     
+    int64 getAllocatedSize() const {
+        return (int64)(local_displacements.GetAllocatedSize() + post_displacements.GetAllocatedSize());
+    }
+    
 protected:
     FName key;
     TArray<glm::vec2> local_displacements;
@@ -577,24 +690,104 @@ protected:
 	float red, green, blue;
 };
 
+// Read only view of a cache laid out as one flat float array, [frame][key][values].
+// The data lives outside the cache manager (e.g. in a memory mapped cooked file) and
+// must outlive it. Each frame holds either every key or none of them.
+struct meshCacheFlatView {
+    meshCacheFlatView()
+    : data(nullptr), frame_counts(nullptr), num_frames(0), frame_stride(0)
+    {}
+    
+    bool isValid() const {
+        return data != nullptr;
+    }
+    
+    bool hasFrame(int32 frame_in) const {
+        return frame_counts[frame_in] != 0;
+    }
+    
+    const float * getEntry(int32 frame_in, int32 key_index) const {
+        return data + (int64)frame_in * frame_stride + key_offsets[key_index];
+    }
+    
+    // Only the key tables, the data is not owned by the view
+    int64 getAllocatedSize() const {
+        return (int64)(keys.GetAllocatedSize() + key_offsets.GetAllocatedSize());
+    }
+    
+    TArray<FName> keys;
+    // float offset of each key inside a frame
+    TArray<int32> key_offsets;
+    const float * data;
+    const int32 * frame_counts;
+    int32 num_frames, frame_stride;
+};
+
+// Frames kept by a cache that only stores the authored keyframes of a clip. Every
+// frame maps to the keyframe at or before it and times between two keyframes blend
+// them on retrieval. Clips keyed on every frame keep no index.
+class meshCacheKeyframes {
+public:
+    meshCacheKeyframes();
+    
+    // Key times must be strictly increasing and inside the clip, returns false otherwise
+    bool init(int32 start_time_in, int32 end_time_in, const TArray<int32>& key_times_in);
+    
+    bool isSparse() const;
+    
+    // Frames a cache stores, the keyframes of a sparse clip or else every frame
+    int32 getNumFrames() const;
+    
+    // Empty unless sparse
+    const TArray<int32>& getKeyTimes() const;
+    
+    // Keyframe at or before time_in
+    int32 getKeyAtTime(int32 time_in) const;
+    
+    // Keyframes around time_in and the blend between them
+    void getKeysAtTime(float time_in, int32& base_key, int32& end_key, float& ratio) const;
+    
+    int64 getAllocatedSize() const;
+    
+protected:
+    TArray<int32> key_times;
+    // keyframe at or before each frame of the clip
+    TArray<int32> frame_keys;
+    int32 start_time, num_frames;
+};
+
+// Bone animation is one contiguous float array of [frame][bone][start.xy, end.xy]
+// with a single key table for every frame, so interpolating two frames is a blend
+// of two rows. The array is either owned or a view into cooked binary data.
 class meshBoneCacheManager {
 public:
     meshBoneCacheManager();
     
     meshBoneCacheManager( const meshBoneCacheManager& other )
-    : bone_cache_table( other.bone_cache_table),
-    bone_cache_data_ready( other.bone_cache_data_ready),
+    : bone_data( other.bone_data),
+    bone_frame_counts( other.bone_frame_counts),
     start_time( other.start_time),
     end_time( other.end_time),
-    is_ready( other.is_ready)
-    {}
+    is_ready( other.is_ready),
+    flat_view( other.flat_view),
+    keyframes( other.keyframes)
+    {
+        if(other.ownsData()) {
+            pointViewAtData();
+        }
+    }
     
     meshBoneCacheManager& operator=( const meshBoneCacheManager& other ) {
-        bone_cache_table = other.bone_cache_table;
-        bone_cache_data_ready = other.bone_cache_data_ready;
+        bone_data = other.bone_data;
+        bone_frame_counts = other.bone_frame_counts;
         start_time = other.start_time;
         end_time = other.end_time;
         is_ready = other.is_ready;
+        flat_view = other.flat_view;
+        keyframes = other.keyframes;
+        if(other.ownsData()) {
+            pointViewAtData();
+        }
         
         return *this;
     }
@@ -603,18 +796,57 @@ public:
     
     void init(int32 start_time_in, int32 end_time_in);
     
+    // Only stores the given keyframes, call after init() and before initKeys()
+    bool initKeyframes(const TArray<int32>& key_times_in);
+    
+    const meshCacheKeyframes& getKeyframes() const;
+    
+    // Sets the bone layout shared by every frame and allocates the frames, call after init()
+    void initKeys(const TArray<FName>& keys_in);
+    
     int32 getStartTime() const;
     
     int32 getEndime() const;
 
+    // Stored frame at or before time_in
     int32 getIndexByTime(int32 time_in) const;
     
     void setValuesAtTime(int32 time_in,
                          TMap<FName, meshBone *>& bone_map);
     
+    // Writes one bone of a frame, the frame counts as ready once setFrameReady() is called
+    void setFrameValue(int32 frame_index, int32 key_index,
+                       const glm::vec4& start_pt, const glm::vec4& end_pt);
+    
+    void setFrameReady(int32 frame_index);
+    
+    bool isFrameReady(int32 frame_index) const;
+    
+    // Row of 4 floats per key for a frame
+    const float * getFrameData(int32 frame_index) const;
+    
+    // Stored frames, only the keyframes of a sparse clip
+    int32 getNumFrames() const;
+    
+    int32 getNumKeys() const;
+    
+    int32 getKeyIndex(const FName& key_in) const;
+    
     void retrieveValuesAtTime(float time_in,
                               TMap<FName, meshBone *>& bone_map);
     
+    // Same as above with every cache entry already resolved to bones_list[bone_indices[i]],
+    // see getKeys(). Entries with an index of -1 are skipped
+    void retrieveValuesAtTime(float time_in,
+                              const TArray<meshBone *>& bones_list,
+                              const TArray<int32>& bone_indices);
+    
+    // Keys of the cache entries, in entry order
+    void getKeys(TArray<FName>& out_keys);
+    
+    // Heap bytes held by the cache, cooked data it only views is not counted
+    int64 getAllocatedSize() const;
+    
     std::pair<glm::vec4, glm::vec4> retrieveSingleBoneValueAtTime(const FName& key_in,
                                                                   float time_in);
     
@@ -622,15 +854,65 @@ public:
     
     void makeAllReady();
     
-    TArray<TArray<meshBoneCache> >& getCacheTable();
+    // Reads from a flat view of 4 floats per bone, the xy of the world start and end
+    // points, kept outside of the manager
+    void initFlatView(int32 start_time_in, int32 end_time_in, const meshCacheFlatView& view_in);
+    
+    bool hasFlatView() const;
 
 protected:
-    TArray<TArray<meshBoneCache> > bone_cache_table;
-    TArray<bool> bone_cache_data_ready;
+    bool ownsData() const;
+    
+    void pointViewAtData();
+    
+    // Stores every frame of a sparse clip so single frames can be written
+    void makeDense();
+    
+    void getFramesAtTime(float time_in, int32& base_frame, int32& end_frame, float& ratio) const;
+    
+    template <typename GetBoneFunc>
+    void retrieveBoundValuesAtTime(float time_in, GetBoneFunc get_bone);
+    
+    TArray<float> bone_data;
+    TArray<int32> bone_frame_counts;
     int32 start_time, end_time;
     bool is_ready;
+    meshCacheFlatView flat_view;
+    meshCacheKeyframes keyframes;
+};
+
+// Displacements quantized to 16 or 8 bits per component, decoded as min + value * step.
+// For every frame and key the ranges view holds the min.xy and step.xy of the local then
+// the post displacements, 8 floats. The values are laid out [frame][key][local, post] with
+// every frame padded to 4 bytes. Like the flat view the data can live outside the manager.
+struct meshQuantizedDisplacementView {
+    meshQuantizedDisplacementView()
+    : values(nullptr), value_bits(0), frame_bytes(0)
+    {}
+    
+    bool isValid() const {
+        return ranges.isValid() && (values != nullptr);
+    }
+    
+    const uint8 * getValues(int32 frame_in, int32 key_index) const {
+        return values + (int64)frame_in * frame_bytes + value_offsets[key_index];
+    }
     
-    FCriticalSection data_lock;
+    // Sets up the range and value offsets from the keys, counts and value_bits
+    void initLayout();
+    
+    // Only the layout tables, the values are not owned by the view
+    int64 getAllocatedSize() const {
+        return ranges.getAllocatedSize()
+            + (int64)(local_counts.GetAllocatedSize() + post_counts.GetAllocatedSize() + value_offsets.GetAllocatedSize());
+    }
+    
+    meshCacheFlatView ranges;
+    TArray<int32> local_counts, post_counts;
+    // byte offset of each key inside a frame
+    TArray<int32> value_offsets;
+    const uint8 * values;
+    int32 value_bits, frame_bytes;
 };
 
 class meshDisplacementCacheManager {
@@ -642,8 +924,21 @@ public:
     displacement_cache_data_ready( other.displacement_cache_data_ready),
     start_time( other.start_time),
     end_time( other.end_time),
-    is_ready( other.is_ready)
-    {}
+    is_ready( other.is_ready),
+    flat_view( other.flat_view),
+    flat_local_counts( other.flat_local_counts),
+    flat_post_counts( other.flat_post_counts),
+    keyframes( other.keyframes),
+    quantized_view( other.quantized_view),
+    quantized_ranges( other.quantized_ranges),
+    quantized_frame_counts( other.quantized_frame_counts),
+    quantized_values( other.quantized_values),
+    table_unpacked( other.table_unpacked.load())
+    {
+        if(other.ownsQuantizedData()) {
+            pointQuantizedViewAtData();
+        }
+    }
     
     meshDisplacementCacheManager& operator=( const meshDisplacementCacheManager& other ) {
         displacement_cache_table = other.displacement_cache_table;
@@ -651,6 +946,18 @@ public:
         start_time = other.start_time;
         end_time = other.end_time;
         is_ready = other.is_ready;
+        flat_view = other.flat_view;
+        flat_local_counts = other.flat_local_counts;
+        flat_post_counts = other.flat_post_counts;
+        keyframes = other.keyframes;
+        quantized_view = other.quantized_view;
+        quantized_ranges = other.quantized_ranges;
+        quantized_frame_counts = other.quantized_frame_counts;
+        quantized_values = other.quantized_values;
+        table_unpacked.store(other.table_unpacked.load());
+        if(other.ownsQuantizedData()) {
+            pointQuantizedViewAtData();
+        }
         
         return *this;
     }
@@ -659,10 +966,16 @@ public:
     
     void init(int32 start_time_in, int32 end_time_in);
     
+    // Only stores the given keyframes, call after init() or after setting up a view
+    bool initKeyframes(const TArray<int32>& key_times_in);
+    
+    const meshCacheKeyframes& getKeyframes() const;
+    
     int32 getStartTime() const;
     
     int32 getEndime() const;
     
+    // Stored frame at or before time_in
     int32 getIndexByTime(int32 time_in) const;
     
     void setValuesAtTime(int32 time_in,
@@ -671,6 +984,18 @@ public:
     void retrieveValuesAtTime(float time_in,
                               TMap<FName, meshRenderRegion *>& regions_map);
     
+    // Same as above with every cache entry already resolved to regions_list[region_indices[i]],
+    // see getKeys(). Entries with an index of -1 are skipped
+    void retrieveValuesAtTime(float time_in,
+                              const TArray<meshRenderRegion *>& regions_list,
+                              const TArray<int32>& region_indices);
+    
+    // Keys of the cache entries, in entry order
+    void getKeys(TArray<FName>& out_keys);
+    
+    // Heap bytes held by the cache, cooked data it only views is not counted
+    int64 getAllocatedSize() const;
+    
     void retrieveSingleDisplacementValueAtTime(const FName& key_in,
                                                float time_in,
                                                meshRenderRegion * region);
@@ -689,13 +1014,79 @@ public:
     
     void makeAllReady();
 
+    // Returns the per frame table, unpacking the flat or quantized view into it first if there is one.
+    // The view is left untouched, readers move over to the table once it is complete
     TArray<TArray<meshDisplacementCache> >& getCacheTable();
     
+    // Reads from a flat view holding the local then post displacements of each region,
+    // the per region point counts are the same for every frame
+    void initFlatView(int32 start_time_in, int32 end_time_in, const meshCacheFlatView& view_in,
+                      const TArray<int32>& local_counts_in, const TArray<int32>& post_counts_in);
+    
+    bool hasFlatView() const;
+    
+    // Returns whether an entry of the first frame has local and post displacements
+    void getFirstFrameDisplacementUse(int32 entry_index, bool& out_use_local, bool& out_use_post);
+    
+    // Re-encodes a ready cache with value_bits (16 or 8) per displacement component. Returns
+    // false and keeps the cache as it is if its frames do not all share one layout
+    bool quantize(int32 value_bits);
+    
+    // Reads from a quantized view kept outside of the manager
+    void initQuantizedView(int32 start_time_in, int32 end_time_in, const meshQuantizedDisplacementView& view_in);
+    
+    bool hasQuantizedView() const;
+    
+    const meshQuantizedDisplacementView& getQuantizedView() const;
+    
+    // Bits that caches filled from json are quantized to, 0 keeps full floats
+    static void setDefaultQuantizeBits(int32 value_in);
+    
+    static int32 getDefaultQuantizeBits();
+    
 protected:
+    // Whether values are read from a view, false once getCacheTable() has unpacked it
+    bool hasPackedView() const;
+    
+    void unpackFlatView();
+    
+    // Stores every frame of a sparse clip so single frames can be written
+    void makeDense();
+    
+    void getFramesAtTime(float time_in, int32& base_frame, int32& end_frame, float& ratio) const;
+    
+    bool ownsQuantizedData() const;
+    
+    void pointQuantizedViewAtData();
+    
+    template <typename GetRegionFunc>
+    void retrieveBoundValuesAtTime(float time_in, GetRegionFunc get_region);
+    
+    template <typename GetRegionFunc>
+    void retrieveFlatValuesAtTime(int32 base_time,
+                                  int32 final_time,
+                                  float ratio,
+                                  GetRegionFunc get_region);
+    
+    template <typename T, typename GetRegionFunc>
+    void retrieveQuantizedValuesAtTime(int32 base_time,
+                                       int32 final_time,
+                                       float ratio,
+                                       GetRegionFunc get_region);
+    
     TArray<TArray<meshDisplacementCache> > displacement_cache_table;
     TArray<bool> displacement_cache_data_ready;
     int32 start_time, end_time;
     bool is_ready;
+    meshCacheFlatView flat_view;
+    TArray<int32> flat_local_counts, flat_post_counts;
+    meshCacheKeyframes keyframes;
+    meshQuantizedDisplacementView quantized_view;
+    TArray<float> quantized_ranges;
+    TArray<int32> quantized_frame_counts;
+    TArray<uint8> quantized_values;
+    // Set once the table holds everything in the view, views are never changed after loading
+    std::atomic<bool> table_unpacked;
     
 	FCriticalSection data_lock;
 };
@@ -709,7 +1100,9 @@ public:
     uv_cache_data_ready( other.uv_cache_data_ready),
     start_time( other.start_time),
     end_time( other.end_time),
-    is_ready( other.is_ready)
+    is_ready( other.is_ready),
+    flat_view( other.flat_view),
+    table_unpacked( other.table_unpacked.load())
     {}
     
     meshUVWarpCacheManager& operator=( const meshUVWarpCacheManager& other ) {
@@ -718,6 +1111,8 @@ public:
         start_time = other.start_time;
         end_time = other.end_time;
         is_ready = other.is_ready;
+        flat_view = other.flat_view;
+        table_unpacked.store(other.table_unpacked.load());
         
         return *this;
     }
@@ -738,6 +1133,18 @@ public:
     void retrieveValuesAtTime(float time_in,
                               TMap<FName, meshRenderRegion *>& regions_map);
     
+    // Same as above with every cache entry already resolved to regions_list[region_indices[i]],
+    // see getKeys(). Entries with an index of -1 are skipped
+    void retrieveValuesAtTime(float time_in,
+                              const TArray<meshRenderRegion *>& regions_list,
+                              const TArray<int32>& region_indices);
+    
+    // Keys of the cache entries, in entry order
+    void getKeys(TArray<FName>& out_keys);
+    
+    // Heap bytes held by the cache, cooked data it only views is not counted
+    int64 getAllocatedSize() const;
+    
     void retrieveSingleValueAtTime(float time_in,
                                    meshRenderRegion * region,
                                    glm::vec2& local_offset,
@@ -748,13 +1155,34 @@ public:
     
     void makeAllReady();
 
+    // Returns the per frame table, unpacking the flat view into it first if there is one.
+    // The view is left untouched, readers move over to the table once it is complete
     TArray<TArray<meshUVWarpCache> >& getCacheTable();
+    
+    // Reads from a flat view of 8 floats per region: enabled, level, local offset,
+    // global offset and scale
+    void initFlatView(int32 start_time_in, int32 end_time_in, const meshCacheFlatView& view_in);
+    
+    bool hasFlatView() const;
+    
+    // Returns whether an entry of the first frame has its uv warp enabled
+    bool getFirstFrameEnabled(int32 entry_index);
 
 protected:
+    // Whether values are read from the flat view, false once getCacheTable() has unpacked it
+    bool hasPackedView() const;
+    
+    void unpackFlatView();
+    
+    template <typename GetRegionFunc>
+    void retrieveBoundValuesAtTime(float time_in, GetRegionFunc get_region);
+    
     TArray<TArray<meshUVWarpCache> > uv_cache_table;
     TArray<bool> uv_cache_data_ready;
     int32 start_time, end_time;
     bool is_ready;
+    meshCacheFlatView flat_view;
+    std::atomic<bool> table_unpacked;
     
 	FCriticalSection data_lock;
 };
@@ -768,7 +1196,9 @@ public:
 		opacity_cache_data_ready(other.opacity_cache_data_ready),
 		start_time(other.start_time),
 		end_time(other.end_time),
-		is_ready(other.is_ready)
+		is_ready(other.is_ready),
+		flat_view(other.flat_view),
+		table_unpacked(other.table_unpacked.load())
 	{}
 
 	meshOpacityCacheManager& operator=(const meshOpacityCacheManager& other) {
@@ -777,6 +1207,8 @@ public:
 		start_time = other.start_time;
 		end_time = other.end_time;
 		is_ready = other.is_ready;
+		flat_view = other.flat_view;
+		table_unpacked.store(other.table_unpacked.load());
 
 		return *this;
 	}
@@ -797,6 +1229,18 @@ public:
 	void retrieveValuesAtTime(float time_in,
 		TMap<FName, meshRenderRegion *>& regions_map);
 
+	// Same as above with every cache entry already resolved to regions_list[region_indices[i]],
+	// see getKeys(). Entries with an index of -1 are skipped
+	void retrieveValuesAtTime(float time_in,
+		const TArray<meshRenderRegion *>& regions_list,
+		const TArray<int32>& region_indices);
+
+	// Keys of the cache entries, in entry order
+	void getKeys(TArray<FName>& out_keys);
+
+	// Heap bytes held by the cache, cooked data it only views is not counted
+	int64 getAllocatedSize() const;
+
 	void retrieveSingleValueAtTime(float time_in,
 		meshRenderRegion * region,
 		float& out_opacity);
@@ -805,13 +1249,30 @@ public:
 
 	void makeAllReady();
 
+	// Returns the per frame table, unpacking the flat view into it first if there is one.
+	// The view is left untouched, readers move over to the table once it is complete
 	TArray<TArray<meshOpacityCache> >& getCacheTable();
 
+	// Reads from a flat view of 4 floats per region: opacity, red, green and blue
+	void initFlatView(int32 start_time_in, int32 end_time_in, const meshCacheFlatView& view_in);
+
+	bool hasFlatView() const;
+
 protected:
+	// Whether values are read from the flat view, false once getCacheTable() has unpacked it
+	bool hasPackedView() const;
+
+	void unpackFlatView();
+
+	template <typename GetRegionFunc>
+	void retrieveBoundValuesAtTime(float time_in, GetRegionFunc get_region);
+
 	TArray<TArray<meshOpacityCache> > opacity_cache_table;
 	TArray<bool> opacity_cache_data_ready;
 	int32 start_time, end_time;
 	bool is_ready;
+	meshCacheFlatView flat_view;
+	std::atomic<bool> table_unpacked;
 
 	FCriticalSection data_lock;
 };
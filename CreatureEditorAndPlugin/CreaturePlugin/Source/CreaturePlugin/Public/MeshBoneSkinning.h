@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Creature Runtimes License
+ *
+ * Copyright (c) 2015, Kestrel Moon Studios
+ * All rights reserved.
+ *
+ * Preamble: This Agreement governs the relationship between Licensee and Kestrel Moon Studios(Hereinafter: Licensor).
+ * This Agreement sets the terms, rights, restrictions and obligations on using [Creature Runtimes] (hereinafter: The Software) created and owned by Licensor,
+ * as detailed herein:
+ * License Grant: Licensor hereby grants Licensee a Sublicensable, Non-assignable & non-transferable, Commercial, Royalty free,
+ * Including the rights to create but not distribute derivative works, Non-exclusive license, all with accordance with the terms set forth and
+ * other legal restrictions set forth in 3rd party software used while running Software.
+ * Limited: Licensee may use Software for the purpose of:
+ * Running Software on Licensee’s Website[s] and Server[s];
+ * Allowing 3rd Parties to run Software on Licensee’s Website[s] and Server[s];
+ * Publishing Software’s output to Licensee and 3rd Parties;
+ * Distribute verbatim copies of Software’s output (including compiled binaries);
+ * Modify Software to suit Licensee’s needs and specifications.
+ * Binary Restricted: Licensee may sublicense Software as a part of a larger work containing more than Software,
+ * distributed solely in Object or Binary form under a personal, non-sublicensable, limited license. Such redistribution shall be limited to unlimited codebases.
+ * Non Assignable & Non-Transferable: Licensee may not assign or transfer his rights and duties under this license.
+ * Commercial, Royalty Free: Licensee may use Software for any purpose, including paid-services, without any royalties
+ * Including the Right to Create Derivative Works: Licensee may create derivative works based on Software,
+ * including amending Software’s source code, modifying it, integrating it into a larger work or removing portions of Software,
+ * as long as no distribution of the derivative works is made
+ *
+ * THE RUNTIMES IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE RUNTIMES OR THE USE OR OTHER DEALINGS IN THE
+ * RUNTIMES.
+ *****************************************************************************/
+
+#ifndef __EngineApp__MeshBoneSkinning__
+#define __EngineApp__MeshBoneSkinning__
+
+#include <glm/vec2.hpp>
+
+// Dual quaternion skinning kernels used by meshRenderRegion::poseFastFinalPts.
+// Points are skinned in blocks of MESH_SKINNING_BLOCK_SIZE. The rest points and
+// bone influences of a block are stored as structure of arrays, so the vector
+// kernels load each component of several points with a single instruction.
+#define MESH_SKINNING_BLOCK_SIZE 8
+
+enum meshSkinningMode {
+    MESH_SKINNING_SCALAR = 0,
+    MESH_SKINNING_SSE,
+    MESH_SKINNING_AVX2,
+    MESH_SKINNING_NEON
+};
+
+// Inputs for skinning the points of a region
+struct meshSkinningData {
+    // [block][x, y, z][lane]
+    const float * rest_pts;
+    // [block][influence slot][lane]
+    const int32 * influence_bones;
+    const float * influence_weights;
+    int32 influences_per_pt;
+    // 8 floats per bone: real x, y, z, w then imaginary x, y, z, w
+    const float * bone_dqs;
+    // Optional per point displacements, NULL when unused
+    const glm::vec2 * local_displacements;
+    const glm::vec2 * post_displacements;
+    // 3 floats per point, z is written as 0
+    float * output_pts;
+    int32 num_pts;
+};
+
+// Returns whether this build and cpu can run a skinning mode
+bool isMeshSkinningModeSupported(meshSkinningMode mode_in);
+
+// Returns the fastest supported skinning mode
+meshSkinningMode getBestMeshSkinningMode();
+
+// Selects the skinning kernel used by all regions, unsupported modes fall back
+// to scalar. Returns the mode now in use.
+meshSkinningMode setMeshSkinningMode(meshSkinningMode mode_in);
+
+meshSkinningMode getMeshSkinningMode();
+
+const char * getMeshSkinningModeName(meshSkinningMode mode_in);
+
+// Skins one block of points
+void meshSkinBlock(const meshSkinningData& data_in,
+                   int32 block_index,
+                   meshSkinningMode mode_in);
+
+#endif /* defined(__EngineApp__MeshBoneSkinning__) */
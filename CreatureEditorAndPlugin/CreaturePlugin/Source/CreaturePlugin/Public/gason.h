@@ -142,6 +142,7 @@ public:
 	~JsonAllocator();
 	void *allocate(size_t size);
 	void deallocate();
+	size_t getAllocatedSize() const;
 };
 
 JsonParseStatus jsonParse(char *str, char **endptr, JsonValue *value, JsonAllocator &allocator);
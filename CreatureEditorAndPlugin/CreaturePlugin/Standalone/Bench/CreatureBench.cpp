@@ -0,0 +1,1432 @@
+/******************************************************************************
+ * Creature Runtimes - Standalone Benchmark
+ *
+ * Loads Creature JSON characters headless and reports load time, per frame
+ * CreatureManager::Update() time, memory use and a pose checksum that can be
+ * compared between builds to catch posing regressions. Each character is also
+ * cooked to the binary format, reloaded both from memory and memory mapped from
+ * a file, and must pose identically, also while its cooked caches are unpacked
+ * to tables by another thread.
+ *
+ * --skinning picks the skinning kernel (scalar, sse, avx2, neon). With
+ * --check-skinning every supported vector kernel is also compared against the
+ * scalar path and must stay within a small tolerance. --min-parallel-pts and
+ * --chunk-pts tune the posing scheduler. --crowd sets how many instances are
+ * stepped one by one and then batched through a CreatureCrowd, both must pose
+ * the same. Auto blends through every clip are timed blending skinned points
+ * and blending in bone space, and must settle on the same pose. A blend space of
+ * every clip weighted to one clip at a time must pose like playing it alone, doubling
+ * all weights must not change its pose and two clips must mix like a hand blend.
+ * Point caches are built at full and 16 bit precision, on a worker thread and
+ * lazily during playback, and compared to skinning. Poses handed from a worker
+ * thread through a lock free triple buffer must always be read whole and in order.
+ * --quantize-displacements stores mesh deformation at 16 or 8 bits,
+ * the poses are compared against full floats and must stay within tolerance.
+ * Clips are also loaded on demand through a CreatureAnimationLibrary, prefetched
+ * in the background and then evicted under a memory budget, posing like the
+ * eager load. The file is then loaded again on a worker thread by two requests
+ * sharing one CreatureAsyncLoader load, its json DOM released once everything
+ * is built.
+ *
+ * Usage: CreatureBench [--frames N] [--threads N] [--skinning MODE] [--check-skinning]
+ *                      [--min-parallel-pts N] [--chunk-pts N] [--crowd N]
+ *                      [--quantize-displacements BITS] [file.json ...]
+ * With no files the horseman, bat and swapGirl samples are used.
+ *****************************************************************************/
+
+#include "CoreMinimal.h"
+#include "Runtime/Core/Public/Async/ParallelFor.h"
+#include "CreatureModule.h"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <new>
+#include <thread>
+
+// Allocation tracking
+namespace {
+    std::atomic<int64> live_bytes{ 0 };
+    std::atomic<int64> total_allocs{ 0 };
+
+    const size_t alloc_header_size = 16;
+
+    void * TrackedAlloc(size_t size)
+    {
+        void * raw_ptr = std::malloc(size + alloc_header_size);
+        if (raw_ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        *(size_t *)raw_ptr = size;
+        live_bytes.fetch_add((int64)size, std::memory_order_relaxed);
+        total_allocs.fetch_add(1, std::memory_order_relaxed);
+        return (char *)raw_ptr + alloc_header_size;
+    }
+
+    void TrackedFree(void * ptr)
+    {
+        if (ptr == nullptr) {
+            return;
+        }
+
+        void * raw_ptr = (char *)ptr - alloc_header_size;
+        live_bytes.fetch_sub((int64)*(size_t *)raw_ptr, std::memory_order_relaxed);
+        std::free(raw_ptr);
+    }
+}
+
+void * operator new(size_t size) { return TrackedAlloc(size); }
+void * operator new[](size_t size) { return TrackedAlloc(size); }
+void * operator new(size_t size, const std::nothrow_t&) noexcept { try { return TrackedAlloc(size); } catch (...) { return nullptr; } }
+void * operator new[](size_t size, const std::nothrow_t&) noexcept { try { return TrackedAlloc(size); } catch (...) { return nullptr; } }
+void operator delete(void * ptr) noexcept { TrackedFree(ptr); }
+void operator delete[](void * ptr) noexcept { TrackedFree(ptr); }
+void operator delete(void * ptr, size_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void * ptr, size_t) noexcept { TrackedFree(ptr); }
+
+namespace {
+    typedef std::chrono::steady_clock FClock;
+
+    double ElapsedMs(FClock::time_point start_time)
+    {
+        return std::chrono::duration<double, std::milli>(FClock::now() - start_time).count();
+    }
+
+    double ToMb(int64 bytes_in)
+    {
+        return (double)bytes_in / (1024.0 * 1024.0);
+    }
+
+    bool ReadFile(const std::string& filename_in, std::string& out_data)
+    {
+        std::ifstream read_file(filename_in, std::ios::in | std::ios::binary);
+        if (!read_file) {
+            return false;
+        }
+
+        std::stringstream str_stream;
+        str_stream << read_file.rdbuf();
+        out_data = str_stream.str();
+        return true;
+    }
+
+    bool WriteFile(const std::string& filename_in, const TArray<uint8>& data_in)
+    {
+        std::ofstream write_file(filename_in, std::ios::out | std::ios::binary | std::ios::trunc);
+        write_file.write((const char *)data_in.GetData(), data_in.Num());
+        return write_file.good();
+    }
+
+    double PoseChecksum(CreatureModule::Creature * creature_in)
+    {
+        double ret_sum = 0;
+        glm::float32 * cur_pts = creature_in->GetRenderPts();
+        for (int32 i = 0; i < creature_in->GetTotalNumPoints() * 3; i++) {
+            ret_sum += std::fabs((double)cur_pts[i]);
+        }
+
+        return ret_sum;
+    }
+
+    struct FBenchCharacter {
+        TSharedPtr<CreatureModule::Creature> creature;
+        TSharedPtr<CreatureModule::CreatureManager> manager;
+        double creature_ms = 0, animations_ms = 0;
+        int64 creature_bytes = 0;
+    };
+
+    FBenchCharacter BuildCharacter(CreatureModule::CreatureLoadDataPacket& load_data)
+    {
+        FBenchCharacter ret_character;
+        int64 build_base_bytes = live_bytes.load();
+        auto build_start = FClock::now();
+        ret_character.creature = TSharedPtr<CreatureModule::Creature>(new CreatureModule::Creature(load_data));
+        ret_character.creature_ms = ElapsedMs(build_start);
+        ret_character.creature_bytes = live_bytes.load() - build_base_bytes;
+
+        auto anim_start = FClock::now();
+        ret_character.manager = TSharedPtr<CreatureModule::CreatureManager>(
+            new CreatureModule::CreatureManager(ret_character.creature));
+        for (auto& cur_name : ret_character.creature->GetAnimationNames()) {
+            ret_character.manager->CreateAnimation(load_data, cur_name);
+        }
+        ret_character.animations_ms = ElapsedMs(anim_start);
+
+        return ret_character;
+    }
+
+    // New instance posed from the template of source_in, sharing its animations
+    FBenchCharacter MakeInstance(FBenchCharacter& source_in)
+    {
+        FBenchCharacter ret_instance;
+        ret_instance.creature = TSharedPtr<CreatureModule::Creature>(
+            new CreatureModule::Creature(source_in.creature->GetTemplate()));
+        ret_instance.manager = TSharedPtr<CreatureModule::CreatureManager>(
+            new CreatureModule::CreatureManager(ret_instance.creature));
+        for (auto& cur_animation : source_in.manager->GetAllAnimations()) {
+            ret_instance.manager->AddAnimation(cur_animation.Value);
+        }
+
+        return ret_instance;
+    }
+
+    // Plays every animation for num_frames, returns the summed pose checksum
+    double PlayAnimations(FBenchCharacter& character, int32 num_frames, TArray<double> * frame_times)
+    {
+        const float delta_time = 1.0f / 60.0f;
+        character.manager->SetIsPlaying(true);
+        character.manager->SetShouldLoop(true);
+
+        double checksum = 0;
+        for (auto& cur_name : character.creature->GetAnimationNames()) {
+            character.manager->SetActiveAnimationName(cur_name);
+            for (int32 i = 0; i < num_frames; i++) {
+                auto frame_start = FClock::now();
+                character.manager->Update(delta_time);
+                if (frame_times) {
+                    frame_times->Add(ElapsedMs(frame_start));
+                }
+            }
+
+            checksum += PoseChecksum(character.creature.Get());
+        }
+
+        return checksum;
+    }
+
+    // Poses every animation with the scalar kernel and the given one, returns the
+    // largest difference relative to the point magnitude
+    float CompareSkinningMode(FBenchCharacter& character, int32 num_frames, meshSkinningMode mode_in)
+    {
+        const float delta_time = 1.0f / 60.0f;
+        const int32 num_values = character.creature->GetTotalNumPoints() * 3;
+        TArray<float> reference_pts;
+        reference_pts.SetNumUninitialized(num_values);
+
+        character.manager->SetIsPlaying(true);
+        character.manager->SetShouldLoop(true);
+
+        float max_error = 0;
+        for (auto& cur_name : character.creature->GetAnimationNames()) {
+            character.manager->SetActiveAnimationName(cur_name);
+            for (int32 i = 0; i < num_frames; i++) {
+                float start_run_time = character.manager->getRunTime();
+                setMeshSkinningMode(MESH_SKINNING_SCALAR);
+                character.manager->Update(delta_time);
+                FMemory::Memcpy(reference_pts.GetData(), character.creature->GetRenderPts(), sizeof(float) * num_values);
+
+                character.manager->setRunTime(start_run_time);
+                setMeshSkinningMode(mode_in);
+                character.manager->Update(delta_time);
+
+                const float * cur_pts = character.creature->GetRenderPts();
+                for (int32 j = 0; j < num_values; j++) {
+                    float cur_error = std::fabs(cur_pts[j] - reference_pts[j]) / FMath::Max(1.0f, std::fabs(reference_pts[j]));
+                    max_error = (cur_error == cur_error) ? FMath::Max(max_error, cur_error) : 1.0e30f;
+                }
+            }
+        }
+
+        return max_error;
+    }
+
+    // Every supported vector kernel must match the scalar path within tolerance
+    bool CheckSkinningModes(const std::string& filename_in, FBenchCharacter& character, int32 num_frames)
+    {
+        const float tolerance = 1.0e-4f;
+        const meshSkinningMode all_modes[] = { MESH_SKINNING_SSE, MESH_SKINNING_AVX2, MESH_SKINNING_NEON };
+        const meshSkinningMode prev_mode = getMeshSkinningMode();
+
+        bool all_ok = true;
+        for (auto cur_mode : all_modes) {
+            if (!isMeshSkinningModeSupported(cur_mode)) {
+                continue;
+            }
+
+            float max_error = CompareSkinningMode(character, num_frames, cur_mode);
+            std::printf("  skinning %s vs scalar: max relative error %g%s\n",
+                getMeshSkinningModeName(cur_mode), max_error, (max_error == 0) ? " (bit exact)" : "");
+            if (max_error > tolerance) {
+                std::fprintf(stderr, "CreatureBench - %s %s skinning exceeds tolerance %g\n",
+                    filename_in.c_str(), getMeshSkinningModeName(cur_mode), tolerance);
+                all_ok = false;
+            }
+        }
+
+        setMeshSkinningMode(prev_mode);
+        return all_ok;
+    }
+
+    // Plays every animation of both characters side by side, returns the largest difference
+    // relative to the point magnitude
+    float ComparePoses(FBenchCharacter& character, FBenchCharacter& reference, int32 num_frames)
+    {
+        const float delta_time = 1.0f / 60.0f;
+        const int32 num_values = character.creature->GetTotalNumPoints() * 3;
+        character.manager->SetIsPlaying(true);
+        character.manager->SetShouldLoop(true);
+        reference.manager->SetIsPlaying(true);
+        reference.manager->SetShouldLoop(true);
+
+        float max_error = 0;
+        for (auto& cur_name : character.creature->GetAnimationNames()) {
+            character.manager->SetActiveAnimationName(cur_name);
+            reference.manager->SetActiveAnimationName(cur_name);
+            character.manager->setRunTime(reference.manager->getRunTime());
+            for (int32 i = 0; i < num_frames; i++) {
+                character.manager->Update(delta_time);
+                reference.manager->Update(delta_time);
+
+                const float * cur_pts = character.creature->GetRenderPts();
+                const float * reference_pts = reference.creature->GetRenderPts();
+                for (int32 j = 0; j < num_values; j++) {
+                    float cur_error = std::fabs(cur_pts[j] - reference_pts[j]) / FMath::Max(1.0f, std::fabs(reference_pts[j]));
+                    max_error = (cur_error == cur_error) ? FMath::Max(max_error, cur_error) : 1.0e30f;
+                }
+            }
+        }
+
+        return max_error;
+    }
+
+    // Quantized displacements must pose close to the full float ones
+    bool CheckQuantizedDisplacements(const std::string& filename_in, FBenchCharacter& character,
+        FBenchCharacter& reference, int32 num_frames, int32 quantize_bits)
+    {
+        const float tolerance = (quantize_bits == 16) ? 1.0e-3f : 5.0e-2f;
+        float max_error = ComparePoses(character, reference, num_frames);
+        std::printf("  displacements %d bit vs float: max relative error %g\n", quantize_bits, max_error);
+        if (max_error > tolerance) {
+            std::fprintf(stderr, "CreatureBench - %s %d bit displacements exceed tolerance %g\n",
+                filename_in.c_str(), quantize_bits, tolerance);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Sets up a crowd playing the first animation at staggered times, odd members mirrored
+    TArray<FBenchCharacter> MakeCrowd(FBenchCharacter& source_in, int32 crowd_size)
+    {
+        const FName& animation_name = source_in.creature->GetAnimationNames()[0];
+        TArray<FBenchCharacter> ret_crowd;
+        for (int32 i = 0; i < crowd_size; i++) {
+            FBenchCharacter new_member = MakeInstance(source_in);
+            new_member.manager->SetIsPlaying(true);
+            new_member.manager->SetShouldLoop(true);
+            new_member.manager->SetActiveAnimationName(animation_name);
+            new_member.manager->setRunTime(new_member.manager->GetAnimation(animation_name)->getStartTime() + (float)(i % 7));
+            new_member.manager->SetMirrorY((i % 2) == 1);
+            ret_crowd.Add(new_member);
+        }
+
+        return ret_crowd;
+    }
+
+    double CrowdChecksum(TArray<FBenchCharacter>& crowd_in)
+    {
+        double ret_sum = 0;
+        for (auto& cur_member : crowd_in) {
+            ret_sum += PoseChecksum(cur_member.creature.Get());
+        }
+
+        return ret_sum;
+    }
+
+    // Steps a crowd one manager at a time, then an identical crowd as one batch
+    bool RunCrowd(const std::string& filename_in, FBenchCharacter& source_in, int32 num_frames, int32 crowd_size)
+    {
+        const float delta_time = 1.0f / 60.0f;
+        TArray<FBenchCharacter> single_crowd = MakeCrowd(source_in, crowd_size);
+        TArray<FBenchCharacter> batched_crowd = MakeCrowd(source_in, crowd_size);
+
+        auto single_start = FClock::now();
+        for (int32 i = 0; i < num_frames; i++) {
+            for (auto& cur_member : single_crowd) {
+                cur_member.manager->Update(delta_time);
+            }
+        }
+        double single_ms = ElapsedMs(single_start);
+
+        CreatureModule::CreatureCrowd crowd;
+        auto batched_start = FClock::now();
+        for (int32 i = 0; i < num_frames; i++) {
+            for (auto& cur_member : batched_crowd) {
+                crowd.AddManager(cur_member.manager.Get(), delta_time);
+            }
+
+            crowd.Run();
+        }
+        double batched_ms = ElapsedMs(batched_start);
+
+        std::printf("  crowd: %d instances, one by one %.3f ms/frame, batched %.3f ms/frame in %d group(s)\n",
+            crowd_size, single_ms / num_frames, batched_ms / num_frames, crowd.GetNumGroups());
+
+        double single_checksum = CrowdChecksum(single_crowd);
+        double batched_checksum = CrowdChecksum(batched_crowd);
+        if (batched_checksum != single_checksum) {
+            std::fprintf(stderr, "CreatureBench - %s batched crowd checksum %.6f does not match %.6f\n",
+                filename_in.c_str(), batched_checksum, single_checksum);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Builds point caches for every clip of source_in, shared by all of its instances. Returns
+    // their bytes and, in old_bytes_out, what one float array per frame used to take
+    int64 MakePointCaches(FBenchCharacter& source_in, bool quantize_in, int64 * old_bytes_out)
+    {
+        int64 ret_bytes = 0;
+        if (old_bytes_out) {
+            *old_bytes_out = 0;
+        }
+
+        for (auto& cur_animation : source_in.manager->GetAllAnimations()) {
+            cur_animation.Value->clearCachePts();
+            source_in.manager->MakePointCache(cur_animation.Key, 1, quantize_in);
+            auto& cur_cache = cur_animation.Value->getPointCache();
+            ret_bytes += cur_cache->getAllocatedSize();
+            if (old_bytes_out) {
+                *old_bytes_out += (int64)cur_cache->getNumFrames()
+                    * ((int64)cur_cache->getNumPts() * 3 * sizeof(glm::float32) + (int64)sizeof(glm::float32 *));
+            }
+        }
+
+        return ret_bytes;
+    }
+
+    // Plays from float and 16 bit point caches. On whole frames the float cache must pose like skinning,
+    // the 16 bit one must stay within tolerance of the float one
+    bool RunPointCache(const std::string& filename_in, FBenchCharacter& source_in, int32 num_frames)
+    {
+        const float tolerance = 1.0e-3f;
+        FBenchCharacter skinned_character = MakeInstance(source_in);
+        FBenchCharacter float_character = MakeInstance(source_in);
+        FBenchCharacter quantized_character = MakeInstance(source_in);
+
+        int64 old_bytes = 0;
+        int64 float_bytes = MakePointCaches(source_in, false, &old_bytes);
+        float_character.manager->SetDoPointCache(true);
+        // stepping whole frames lands on the cached poses, which must match skinning exactly
+        const float prev_time_scale = float_character.manager->GetTimeScale();
+        float_character.manager->SetTimeScale(60.0f);
+        skinned_character.manager->SetTimeScale(60.0f);
+        float skinned_error = ComparePoses(float_character, skinned_character, num_frames);
+        float_character.manager->SetTimeScale(prev_time_scale);
+
+        TArray<double> frame_times;
+        PlayAnimations(float_character, num_frames, &frame_times);
+        double cache_ms = 0;
+        for (auto cur_time : frame_times) {
+            cache_ms += cur_time;
+        }
+
+        // the caches live on the shared animations, so capture the float poses before replacing them
+        const int32 num_values = source_in.creature->GetTotalNumPoints() * 3;
+        const float delta_time = 1.0f / 60.0f;
+        const TArray<FName>& all_animation_names = source_in.creature->GetAnimationNames();
+        TArray<TArray<float>> reference_frames;
+        for (auto& cur_name : all_animation_names) {
+            float_character.manager->SetActiveAnimationName(cur_name);
+            for (int32 i = 0; i < num_frames; i++) {
+                float_character.manager->Update(delta_time);
+                reference_frames.Add(TArray<float>());
+                reference_frames.Last().SetNumUninitialized(num_values);
+                FMemory::Memcpy(reference_frames.Last().GetData(), float_character.creature->GetRenderPts(), sizeof(float) * num_values);
+            }
+        }
+
+        int64 quantized_bytes = MakePointCaches(source_in, true, nullptr);
+        quantized_character.manager->SetDoPointCache(true);
+        quantized_character.manager->SetIsPlaying(true);
+        quantized_character.manager->SetShouldLoop(true);
+        float quantized_error = 0;
+        int32 frame_index = 0;
+        for (auto& cur_name : all_animation_names) {
+            quantized_character.manager->SetActiveAnimationName(cur_name);
+            for (int32 i = 0; i < num_frames; i++) {
+                quantized_character.manager->Update(delta_time);
+                const float * cur_pts = quantized_character.creature->GetRenderPts();
+                const float * reference_pts = reference_frames[frame_index++].GetData();
+                for (int32 j = 0; j < num_values; j++) {
+                    float cur_error = std::fabs(cur_pts[j] - reference_pts[j]) / FMath::Max(1.0f, std::fabs(reference_pts[j]));
+                    quantized_error = (cur_error == cur_error) ? FMath::Max(quantized_error, cur_error) : 1.0e30f;
+                }
+            }
+        }
+
+        for (auto& cur_animation : source_in.manager->GetAllAnimations()) {
+            cur_animation.Value->clearCachePts();
+        }
+
+        std::printf("  point cache: %.4f ms/frame, per frame arrays %.3f MB, xy %.3f MB, 16 bit %.3f MB, 16 bit vs float max relative error %g\n",
+            cache_ms / frame_times.Num(), ToMb(old_bytes), ToMb(float_bytes), ToMb(quantized_bytes), quantized_error);
+        if (skinned_error != 0) {
+            std::fprintf(stderr, "CreatureBench - %s point cache poses differ from skinning by %g\n",
+                filename_in.c_str(), skinned_error);
+            return false;
+        }
+
+        if (quantized_error > tolerance) {
+            std::fprintf(stderr, "CreatureBench - %s 16 bit point cache exceeds tolerance %g\n",
+                filename_in.c_str(), tolerance);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Point caches built on a worker thread and filled lazily during playback must pose like
+    // skinning on whole frames, the character keeps skinning until they are in
+    bool CheckPointCacheBuilds(const std::string& filename_in, FBenchCharacter& source_in, int32 num_frames)
+    {
+        const float delta_time = 1.0f / 60.0f;
+        const TArray<FName>& all_animation_names = source_in.creature->GetAnimationNames();
+        auto clearCaches = [&source_in]() {
+            for (auto& cur_animation : source_in.manager->GetAllAnimations()) {
+                cur_animation.Value->clearCachePts();
+            }
+        };
+
+        FBenchCharacter skinned_character = MakeInstance(source_in);
+        FBenchCharacter async_character = MakeInstance(source_in);
+        FBenchCharacter lazy_character = MakeInstance(source_in);
+        FBenchCharacter * all_characters[3] = { &skinned_character, &async_character, &lazy_character };
+        for (auto cur_character : all_characters) {
+            cur_character->manager->SetTimeScale(60.0f);
+        }
+
+        // background, skinning until the caches arrive
+        clearCaches();
+        async_character.manager->SetDoPointCache(true);
+        auto async_start = FClock::now();
+        for (auto& cur_name : all_animation_names) {
+            async_character.manager->MakePointCacheAsync(cur_name, 1);
+        }
+
+        async_character.manager->SetIsPlaying(true);
+        async_character.manager->SetActiveAnimationName(all_animation_names[0]);
+        int32 skinned_frames = 0, num_collected = 0;
+        while (num_collected < all_animation_names.Num()) {
+            async_character.manager->Update(delta_time);
+            num_collected += async_character.manager->CollectPointCaches();
+            skinned_frames++;
+        }
+
+        double async_ms = ElapsedMs(async_start);
+        float async_error = ComparePoses(async_character, skinned_character, num_frames);
+
+        // lazy, a frame at a time
+        clearCaches();
+        lazy_character.manager->SetDoPointCache(true);
+        for (auto& cur_name : all_animation_names) {
+            lazy_character.manager->MakePointCacheLazy(cur_name);
+        }
+
+        float lazy_error = ComparePoses(lazy_character, skinned_character, num_frames);
+        int32 lazy_collected = lazy_character.manager->CollectPointCaches();
+
+        // then through the whole of every clip
+        int32 lazy_frames = 0;
+        for (auto& cur_name : all_animation_names) {
+            lazy_character.manager->SetActiveAnimationName(cur_name);
+            auto cur_animation = lazy_character.manager->GetAnimation(cur_name);
+            int32 clip_frames = (int32)(cur_animation->getEndTime() - cur_animation->getStartTime()) + 1;
+            for (int32 i = 0; (i < clip_frames) && !cur_animation->hasCachePts(); i++) {
+                lazy_character.manager->Update(delta_time);
+                lazy_collected += lazy_character.manager->CollectPointCaches();
+                lazy_frames++;
+            }
+        }
+
+        clearCaches();
+
+        std::printf("  point cache builds: background ready after %.2f ms and %d skinned frames, lazy %d of %d clips complete after %d frames\n",
+            async_ms, skinned_frames, lazy_collected, all_animation_names.Num(), num_frames * all_animation_names.Num() + lazy_frames);
+        if ((async_error != 0) || (lazy_error != 0) || (lazy_collected != all_animation_names.Num())) {
+            std::fprintf(stderr, "CreatureBench - %s background and lazy point caches differ from skinning by %g, %g\n",
+                filename_in.c_str(), async_error, lazy_error);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Poses on a worker thread publishing through a meshTripleBufferIndex while this thread reads
+    // without locks. Every pose read must be a whole published frame, never older than the last one.
+    // A tint that changes now and then is flagged separately, and a ring of three copies refreshed
+    // from the change flags like the mesh buffer sets are must always match the slot it last read
+    bool CheckPoseHandoff(const std::string& filename_in, FBenchCharacter& source_in, int32 num_frames)
+    {
+        const float delta_time = 1.0f / 60.0f;
+        FBenchCharacter writer_character = MakeInstance(source_in);
+        const TArray<FName>& all_animation_names = writer_character.creature->GetAnimationNames();
+        const int32 num_values = writer_character.creature->GetTotalNumPoints() * 3;
+        const int32 total_frames = num_frames * all_animation_names.Num();
+
+        // the frame number and the tint ride along after the points
+        const uint32 pose_flag = 1 << 0, tint_flag = 1 << 1;
+        const int32 tint_frames = 7;
+        TArray<glm::float32> pose_slots[3];
+        for (auto& cur_slot : pose_slots) {
+            cur_slot.SetNumZeroed(num_values + 2);
+        }
+
+        meshTripleBufferIndex pose_handoff;
+        std::vector<double> frame_sums(total_frames, 0.0);
+        std::atomic<bool> writer_done(false);
+
+        std::thread writer_thread([&]() {
+            writer_character.manager->SetIsPlaying(true);
+            writer_character.manager->SetShouldLoop(true);
+            int32 frame_idx = 0;
+            for (auto& cur_name : all_animation_names) {
+                writer_character.manager->SetActiveAnimationName(cur_name);
+                for (int32 i = 0; i < num_frames; i++, frame_idx++) {
+                    writer_character.manager->Update(delta_time);
+                    glm::float32 * write_pts = pose_slots[pose_handoff.getWriteIdx()].GetData();
+                    FMemory::Memcpy(write_pts, writer_character.creature->GetRenderPts(), sizeof(glm::float32) * num_values);
+                    write_pts[num_values] = (glm::float32)frame_idx;
+                    write_pts[num_values + 1] = (glm::float32)(frame_idx / tint_frames);
+                    frame_sums[frame_idx] = PoseChecksum(writer_character.creature.Get());
+                    const bool tint_changed = (frame_idx % tint_frames) == 0;
+                    pose_handoff.publish(pose_flag | (tint_changed ? tint_flag : 0));
+                }
+            }
+
+            writer_done.store(true);
+        });
+
+        struct FRingCopy {
+            glm::float32 frame_idx = -1, tint = -1;
+            uint32 synced_serial = 0;
+        };
+
+        FRingCopy ring_copies[3];
+        int32 ring_idx = 0, stale_copies = 0;
+        int32 frames_seen = 0, torn_frames = 0, last_frame = -1;
+        auto readLatest = [&]() {
+            const int32 read_idx = pose_handoff.acquireLatest();
+            const glm::float32 * read_pts = pose_slots[read_idx].GetData();
+            if (!pose_handoff.hasPublished()) {
+                return;
+            }
+
+            // refresh the next copy with whatever changed since it was last written
+            ring_idx = (ring_idx + 1) % 3;
+            FRingCopy& cur_copy = ring_copies[ring_idx];
+            const uint32 changed_flags = pose_handoff.getChangedFlags(read_idx, cur_copy.synced_serial);
+            if (changed_flags & pose_flag) {
+                cur_copy.frame_idx = read_pts[num_values];
+            }
+
+            if (changed_flags & tint_flag) {
+                cur_copy.tint = read_pts[num_values + 1];
+            }
+
+            cur_copy.synced_serial = pose_handoff.getSerial(read_idx);
+            if ((cur_copy.frame_idx != read_pts[num_values]) || (cur_copy.tint != read_pts[num_values + 1])) {
+                stale_copies++;
+            }
+
+            int32 frame_idx = (int32)read_pts[num_values];
+            if (frame_idx == last_frame) {
+                return;
+            }
+
+            double read_sum = 0;
+            for (int32 i = 0; i < num_values; i++) {
+                read_sum += std::fabs((double)read_pts[i]);
+            }
+
+            if ((frame_idx < last_frame) || (read_sum != frame_sums[frame_idx])) {
+                torn_frames++;
+            }
+
+            last_frame = frame_idx;
+            frames_seen++;
+        };
+
+        while (!writer_done.load()) {
+            readLatest();
+            std::this_thread::yield();
+        }
+
+        writer_thread.join();
+        // every copy in the ring catches up on the last frame
+        for (int32 i = 0; i < 3; i++) {
+            readLatest();
+        }
+
+        std::printf("  pose handoff: reader took %d of %d published frames, %d torn, %d stale copies\n",
+            frames_seen, total_frames, torn_frames, stale_copies);
+        if ((torn_frames > 0) || (stale_copies > 0) || (last_frame != total_frames - 1)) {
+            std::fprintf(stderr, "CreatureBench - %s pose handoff read %d torn frames and %d stale copies, last frame %d of %d\n",
+                filename_in.c_str(), torn_frames, stale_copies, last_frame, total_frames - 1);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Plays name_1 and name_2 alone for one frame, mixes their bones and displacements by hand at
+    // blend_factor and skins that. Returns the largest relative difference from blended_pts
+    float HandBlendError(FBenchCharacter& source_in, const FName& name_1, const FName& name_2,
+        float blend_factor, float delta_time, const float * blended_pts)
+    {
+        FBenchCharacter clip_characters[2] = { MakeInstance(source_in), MakeInstance(source_in) };
+        const FName clip_names[2] = { name_1, name_2 };
+        const float clip_weights[2] = { 1.0f - blend_factor, blend_factor };
+        meshRenderBoneComposition * compositions[2];
+        for (int32 i = 0; i < 2; i++) {
+            clip_characters[i].manager->SetIsPlaying(true);
+            clip_characters[i].manager->SetShouldLoop(true);
+            clip_characters[i].manager->SetActiveAnimationName(clip_names[i]);
+            clip_characters[i].manager->Update(delta_time);
+            compositions[i] = clip_characters[i].creature->GetRenderComposition();
+        }
+
+        // the mix is written over the first character
+        TArray<meshBone *>& bones_list = compositions[0]->getBonesList();
+        for (int32 j = 0; j < bones_list.Num(); j++) {
+            meshBone * other_bone = compositions[1]->getBonesList()[j];
+            bones_list[j]->setWorldStartPt(clip_weights[0] * bones_list[j]->getWorldStartPt() + clip_weights[1] * other_bone->getWorldStartPt());
+            bones_list[j]->setWorldEndPt(clip_weights[0] * bones_list[j]->getWorldEndPt() + clip_weights[1] * other_bone->getWorldEndPt());
+        }
+
+        // a clip not displacing a region adds zero to it
+        TArray<meshRenderRegion *>& regions_list = compositions[0]->getRegions();
+        for (int32 j = 0; j < regions_list.Num(); j++) {
+            meshRenderRegion * cur_regions[2] = { regions_list[j], compositions[1]->getRegions()[j] };
+            const bool use_local[2] = { cur_regions[0]->getUseLocalDisplacements(), cur_regions[1]->getUseLocalDisplacements() };
+            const bool use_post[2] = { cur_regions[0]->getUsePostDisplacements(), cur_regions[1]->getUsePostDisplacements() };
+            TArray<glm::vec2> mix_local, mix_post;
+            mix_local.SetNumZeroed(cur_regions[0]->getNumPts());
+            mix_post.SetNumZeroed(cur_regions[0]->getNumPts());
+            for (int32 i = 0; i < 2; i++) {
+                for (int32 k = 0; k < cur_regions[0]->getNumPts(); k++) {
+                    if (use_local[i]) {
+                        mix_local[k] += clip_weights[i] * cur_regions[i]->getLocalDisplacements()[k];
+                    }
+
+                    if (use_post[i]) {
+                        mix_post[k] += clip_weights[i] * cur_regions[i]->getPostDisplacements()[k];
+                    }
+                }
+            }
+
+            cur_regions[0]->setUseLocalDisplacements(use_local[0] || use_local[1]);
+            cur_regions[0]->setUsePostDisplacements(use_post[0] || use_post[1]);
+            if (cur_regions[0]->getUseLocalDisplacements()) {
+                cur_regions[0]->getLocalDisplacements() = mix_local;
+            }
+
+            if (cur_regions[0]->getUsePostDisplacements()) {
+                cur_regions[0]->getPostDisplacements() = mix_post;
+            }
+        }
+
+        compositions[0]->updateAllTransforms(false);
+        const int32 num_values = clip_characters[0].creature->GetTotalNumPoints() * 3;
+        TArray<float> reference_pts;
+        reference_pts.SetNumZeroed(num_values);
+        meshPoseScheduler reference_scheduler;
+        reference_scheduler.addComposition(compositions[0], reference_pts.GetData());
+        reference_scheduler.run();
+
+        float max_error = 0;
+        for (int32 j = 0; j < num_values; j++) {
+            float cur_error = std::fabs(blended_pts[j] - reference_pts[j]) / FMath::Max(1.0f, std::fabs(reference_pts[j]));
+            max_error = (cur_error == cur_error) ? FMath::Max(max_error, cur_error) : 1.0e30f;
+        }
+
+        return max_error;
+    }
+
+    // Unpacks the cooked caches of every clip into tables while a worker thread poses an instance
+    // sharing them. The worker must pose like the reference throughout, as must playing from the tables
+    bool CheckUnpackWhilePosing(const std::string& filename_in, FBenchCharacter& source_in, int32 num_frames,
+        double reference_checksum)
+    {
+        FBenchCharacter worker_character = MakeInstance(source_in);
+        std::atomic<bool> worker_started(false);
+        double worker_checksum = 0;
+        std::thread worker_thread([&]() {
+            worker_started.store(true);
+            worker_checksum = PlayAnimations(worker_character, num_frames, nullptr);
+        });
+
+        while (!worker_started.load()) {
+            std::this_thread::yield();
+        }
+
+        for (auto& cur_animation : source_in.manager->GetAllAnimations()) {
+            cur_animation.Value->getDisplacementCache().getCacheTable();
+            cur_animation.Value->getUVWarpCache().getCacheTable();
+            cur_animation.Value->getOpacityCache().getCacheTable();
+        }
+
+        worker_thread.join();
+        FBenchCharacter table_character = MakeInstance(source_in);
+        double table_checksum = PlayAnimations(table_character, num_frames, nullptr);
+        if ((worker_checksum != reference_checksum) || (table_checksum != reference_checksum)) {
+            std::fprintf(stderr, "CreatureBench - %s pose checksums %.6f while unpacking, %.6f unpacked do not match %.6f\n",
+                filename_in.c_str(), worker_checksum, table_checksum, reference_checksum);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Auto blends through every clip, skinning both clips and blending the points against blending
+    // bones and displacements with one skinning pass. Once a blend settles both must pose the same.
+    // Halfway into a bone space blend between each pair of clips the pose must match mixing the
+    // bones and displacements of the two clips by hand
+    bool RunBlending(const std::string& filename_in, FBenchCharacter& source_in, int32 num_frames)
+    {
+        const TArray<FName>& all_animation_names = source_in.creature->GetAnimationNames();
+        if (all_animation_names.Num() < 2) {
+            return true;
+        }
+
+        const float tolerance = 1.0e-4f;
+        const float delta_time = 1.0f / 60.0f;
+        const float blend_delta = 2.0f / (float)num_frames;
+        const int32 num_values = source_in.creature->GetTotalNumPoints() * 3;
+
+        FBenchCharacter mesh_character = MakeInstance(source_in);
+        FBenchCharacter bone_character = MakeInstance(source_in);
+        bone_character.manager->SetBoneBlending(true);
+        FBenchCharacter * all_characters[2] = { &mesh_character, &bone_character };
+        for (auto cur_character : all_characters) {
+            cur_character->manager->SetIsPlaying(true);
+            cur_character->manager->SetShouldLoop(true);
+            cur_character->manager->SetActiveAnimationName(all_animation_names[0]);
+            cur_character->manager->SetAutoBlending(true);
+        }
+
+        double blend_ms[2] = { 0, 0 };
+        float max_error = 0;
+        for (int32 i = 1; i <= all_animation_names.Num(); i++) {
+            const FName& next_name = all_animation_names[i % all_animation_names.Num()];
+            for (int32 j = 0; j < 2; j++) {
+                all_characters[j]->manager->AutoBlendTo(next_name, blend_delta);
+            }
+
+            for (int32 k = 0; k < num_frames; k++) {
+                for (int32 j = 0; j < 2; j++) {
+                    auto frame_start = FClock::now();
+                    all_characters[j]->manager->Update(delta_time);
+                    blend_ms[j] += ElapsedMs(frame_start);
+                }
+            }
+
+            const float * cur_pts = bone_character.creature->GetRenderPts();
+            const float * reference_pts = mesh_character.creature->GetRenderPts();
+            for (int32 j = 0; j < num_values; j++) {
+                float cur_error = std::fabs(cur_pts[j] - reference_pts[j]) / FMath::Max(1.0f, std::fabs(reference_pts[j]));
+                max_error = (cur_error == cur_error) ? FMath::Max(max_error, cur_error) : 1.0e30f;
+            }
+        }
+
+        // one frame after blending in at a delta of 0.5 both clips are a frame in and evenly mixed
+        float mid_error = 0;
+        for (int32 i = 0; i < all_animation_names.Num(); i++) {
+            const FName& from_name = all_animation_names[i];
+            const FName& to_name = all_animation_names[(i + 1) % all_animation_names.Num()];
+            FBenchCharacter mid_character = MakeInstance(source_in);
+            mid_character.manager->SetIsPlaying(true);
+            mid_character.manager->SetShouldLoop(true);
+            mid_character.manager->SetBoneBlending(true);
+            mid_character.manager->SetActiveAnimationName(from_name);
+            mid_character.manager->SetAutoBlending(true);
+            mid_character.manager->AutoBlendTo(to_name, 0.5f);
+            mid_character.manager->Update(delta_time);
+
+            mid_error = FMath::Max(mid_error, HandBlendError(source_in, from_name, to_name, 0.5f, delta_time,
+                mid_character.creature->GetRenderPts()));
+        }
+
+        const int32 total_frames = all_animation_names.Num() * num_frames;
+        std::printf("  blending: %d transitions, skinned clips %.4f ms/frame, bone space %.4f ms/frame, settled max relative error %g, mid blend %g\n",
+            all_animation_names.Num(), blend_ms[0] / total_frames, blend_ms[1] / total_frames, max_error, mid_error);
+        if ((max_error > tolerance) || (mid_error > tolerance)) {
+            std::fprintf(stderr, "CreatureBench - %s bone space blending exceeds tolerance %g\n",
+                filename_in.c_str(), tolerance);
+            return false;
+        }
+
+        return true;
+    }
+
+    // A blend space of every clip with all the weight on one clip must pose like playing that clip,
+    // then all clips are blended at once in phase, posing the same with every weight doubled.
+    // Two clips weighted unevenly, or with a negative weight, must match their bones and
+    // displacements mixed by hand
+    bool RunBlendSpace(const std::string& filename_in, FBenchCharacter& source_in, int32 num_frames,
+        double reference_checksum)
+    {
+        const float delta_time = 1.0f / 60.0f;
+        const TArray<FName>& all_animation_names = source_in.creature->GetAnimationNames();
+        FBenchCharacter character = MakeInstance(source_in);
+        character.manager->SetIsPlaying(true);
+        character.manager->SetShouldLoop(true);
+
+        double checksum = 0;
+        for (int32 i = 0; i < all_animation_names.Num(); i++) {
+            TArray<float> weights;
+            weights.SetNumZeroed(all_animation_names.Num());
+            weights[i] = 1.0f;
+            character.manager->SetBlendSpace(all_animation_names, false);
+            character.manager->SetBlendSpaceWeights(weights);
+            for (int32 j = 0; j < num_frames; j++) {
+                character.manager->Update(delta_time);
+            }
+
+            checksum += PoseChecksum(character.creature.Get());
+        }
+
+        TArray<float> weights;
+        weights.Init(1.0f, all_animation_names.Num());
+        character.manager->SetBlendSpace(all_animation_names, true);
+        character.manager->SetBlendSpaceWeights(weights);
+        auto blend_start = FClock::now();
+        for (int32 j = 0; j < num_frames; j++) {
+            character.manager->Update(delta_time);
+        }
+
+        double blend_ms = ElapsedMs(blend_start);
+
+        // doubling every weight must not change the pose
+        FBenchCharacter scaled_character = MakeInstance(source_in);
+        scaled_character.manager->SetIsPlaying(true);
+        scaled_character.manager->SetShouldLoop(true);
+        scaled_character.manager->SetBlendSpace(all_animation_names, true);
+        TArray<float> scaled_weights;
+        scaled_weights.Init(2.0f, all_animation_names.Num());
+        scaled_character.manager->SetBlendSpaceWeights(scaled_weights);
+        for (int32 j = 0; j < num_frames; j++) {
+            scaled_character.manager->Update(delta_time);
+        }
+
+        const int32 num_values = character.creature->GetTotalNumPoints() * 3;
+        const bool scaled_match = (FMemory::Memcmp(scaled_character.creature->GetRenderPts(),
+            character.creature->GetRenderPts(), sizeof(glm::float32) * num_values) == 0);
+
+        // two clips weighted 1 to 3 without phase sync must mix like bones blended by hand at 0.75
+        float mix_error = 0;
+        if (all_animation_names.Num() >= 2) {
+            TArray<FName> mix_names;
+            mix_names.Add(all_animation_names[0]);
+            mix_names.Add(all_animation_names[1]);
+            TArray<float> mix_weights;
+            mix_weights.Add(1.0f);
+            mix_weights.Add(3.0f);
+            FBenchCharacter mix_character = MakeInstance(source_in);
+            mix_character.manager->SetIsPlaying(true);
+            mix_character.manager->SetShouldLoop(true);
+            mix_character.manager->SetBlendSpace(mix_names, false);
+            mix_character.manager->SetBlendSpaceWeights(mix_weights);
+            mix_character.manager->Update(delta_time);
+            mix_error = HandBlendError(source_in, mix_names[0], mix_names[1], 0.75f, delta_time,
+                mix_character.creature->GetRenderPts());
+
+            // a negative weight extrapolates past the second clip, as morph pad corners do
+            mix_weights[0] = -0.5f;
+            mix_weights[1] = 1.5f;
+            FBenchCharacter signed_character = MakeInstance(source_in);
+            signed_character.manager->SetIsPlaying(true);
+            signed_character.manager->SetShouldLoop(true);
+            signed_character.manager->SetBlendSpace(mix_names, false);
+            signed_character.manager->SetBlendSpaceWeights(mix_weights);
+            signed_character.manager->Update(delta_time);
+            mix_error = FMath::Max(mix_error, HandBlendError(source_in, mix_names[0], mix_names[1], 1.5f,
+                delta_time, signed_character.creature->GetRenderPts()));
+        }
+
+        std::printf("  blend space: %d clips in one update %.4f ms/frame, two clip mix max relative error %g\n",
+            all_animation_names.Num(), blend_ms / num_frames, mix_error);
+
+        if (checksum != reference_checksum) {
+            std::fprintf(stderr, "CreatureBench - %s single clip blend space pose checksum %.6f does not match %.6f\n",
+                filename_in.c_str(), checksum, reference_checksum);
+            return false;
+        }
+
+        if (!scaled_match) {
+            std::fprintf(stderr, "CreatureBench - %s blend space pose changes when every weight is doubled\n",
+                filename_in.c_str());
+            return false;
+        }
+
+        if (mix_error > 1.0e-4f) {
+            std::fprintf(stderr, "CreatureBench - %s two clip blend space differs from a hand mix by %g\n",
+                filename_in.c_str(), mix_error);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Loads clips on demand from a library, first with every clip prefetched in the background
+    // then under a budget of half their memory. Both must pose like the eager load
+    bool RunOnDemand(const std::string& filename_in, const FString& json_string, int32 num_frames,
+        double eager_ms, double reference_checksum)
+    {
+        auto load_data = TSharedPtr<CreatureModule::CreatureLoadDataPacket>(new CreatureModule::CreatureLoadDataPacket());
+        CreatureModule::LoadCreatureJSONDataFromString(json_string, *load_data);
+
+        FBenchCharacter character;
+        character.creature = TSharedPtr<CreatureModule::Creature>(new CreatureModule::Creature(*load_data));
+        character.manager = TSharedPtr<CreatureModule::CreatureManager>(
+            new CreatureModule::CreatureManager(character.creature));
+        const TArray<FName>& all_animation_names = character.creature->GetAnimationNames();
+        auto library = TSharedPtr<CreatureModule::CreatureAnimationLibrary>(
+            new CreatureModule::CreatureAnimationLibrary(load_data, all_animation_names));
+        character.manager->SetAnimationLibrary(library);
+
+        auto first_start = FClock::now();
+        character.manager->SetActiveAnimationName(all_animation_names[0]);
+        double first_ms = ElapsedMs(first_start);
+
+        for (auto& cur_name : all_animation_names) {
+            library->Prefetch(cur_name);
+        }
+
+        double prefetch_checksum = PlayAnimations(character, num_frames, nullptr);
+        library->FlushPrefetches();
+        int64 all_bytes = library->GetResidentBytes();
+        int32 all_clips = library->GetNumResidentAnimations();
+
+        character.manager->ReleaseInactiveAnimations();
+        library->SetMemoryBudget(FMath::Max((int64)1, all_bytes / 2));
+        double budget_checksum = PlayAnimations(character, num_frames, nullptr);
+
+        std::printf("  on demand: first clip %.2f ms (all clips %.2f ms), %d clips %.3f MB, budget %.3f MB keeps %d clips %.3f MB\n",
+            first_ms, eager_ms, all_clips, ToMb(all_bytes), ToMb(library->GetMemoryBudget()),
+            library->GetNumResidentAnimations(), ToMb(library->GetResidentBytes()));
+
+        if ((prefetch_checksum != reference_checksum) || (budget_checksum != reference_checksum)) {
+            std::fprintf(stderr, "CreatureBench - %s on demand pose checksums %.6f, %.6f do not match %.6f\n",
+                filename_in.c_str(), prefetch_checksum, budget_checksum, reference_checksum);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Two requests for the file must share one background load and pose like the reference
+    bool CheckAsyncLoad(const std::string& filename_in, int32 num_frames, double reference_checksum)
+    {
+        CreatureModule::CreatureAsyncLoader loader;
+        TArray<CreatureModule::CreatureAsyncLoadResult> results;
+        auto ready_callback = [&results](const CreatureModule::CreatureAsyncLoadResult& result_in) {
+            results.Add(result_in);
+        };
+
+        const FName load_filename(filename_in.c_str());
+        auto load_start = FClock::now();
+        loader.RequestFile(load_filename, true, ready_callback);
+        loader.RequestFile(load_filename, true, ready_callback);
+        const int32 num_loading = loader.GetNumLoading();
+        double request_ms = ElapsedMs(load_start);
+
+        // the game thread keeps running frames until the load is ready
+        int32 num_polls = 0;
+        while (loader.Update() == 0) {
+            num_polls++;
+            std::this_thread::yield();
+        }
+
+        double ready_ms = ElapsedMs(load_start);
+        if ((num_loading != 1) || (results.Num() != 2) || !results[0].success
+            || (results[0].creature_template != results[1].creature_template)) {
+            std::fprintf(stderr, "CreatureBench - %s async load did not share one load between requests\n",
+                filename_in.c_str());
+            return false;
+        }
+
+        FBenchCharacter character;
+        character.creature = TSharedPtr<CreatureModule::Creature>(
+            new CreatureModule::Creature(results[0].creature_template));
+        character.manager = TSharedPtr<CreatureModule::CreatureManager>(
+            new CreatureModule::CreatureManager(character.creature));
+        for (auto& cur_animation : results[0].animations) {
+            character.manager->AddAnimation(cur_animation);
+        }
+
+        // every animation is built, so the json is no longer needed
+        int64 json_bytes = results[0].load_data->GetJsonBytes();
+        results[0].load_data->ReleaseJsonData();
+
+        std::printf("  async load: 2 requests sharing %d load, requests took %.3f ms, ready after %.2f ms and %d polls, released %.2f MB of json\n",
+            num_loading, request_ms, ready_ms, num_polls, ToMb(json_bytes));
+
+        double async_checksum = PlayAnimations(character, num_frames, nullptr);
+        if (async_checksum != reference_checksum) {
+            std::fprintf(stderr, "CreatureBench - %s async pose checksum %.6f does not match %.6f\n",
+                filename_in.c_str(), async_checksum, reference_checksum);
+            return false;
+        }
+
+        return true;
+    }
+
+    // Cooked data with an index past the points or a region range past the mesh must be rejected,
+    // so callers fall back to json. The creature section is walked by hand to find the fields
+    bool CheckCorruptBinary(const std::string& filename_in, const TArray<uint8>& cooked_data)
+    {
+        auto read_int = [&cooked_data](int64 pos_in) {
+            int32 ret_val = 0;
+            FMemory::Memcpy(&ret_val, cooked_data.GetData() + pos_in, sizeof(int32));
+            return ret_val;
+        };
+
+        // header: magic, version, creature offset, clips offset, names offset
+        int64 pos = read_int(2 * sizeof(int32));
+        const int32 num_pts = read_int(pos);
+        pos += sizeof(int32) + (int64)num_pts * 5 * sizeof(float);
+        const int32 num_indices = read_int(pos);
+        const int64 indices_pos = pos + sizeof(int32);
+        pos = indices_pos + (int64)num_indices * sizeof(int32);
+        const int32 num_bones = read_int(pos);
+        pos += sizeof(int32);
+        for (int32 i = 0; i < num_bones; i++) {
+            pos += 2 * sizeof(int32) + 20 * sizeof(float);
+            pos += sizeof(int32) + (int64)read_int(pos) * sizeof(int32);
+        }
+
+        // first region: name, id, start and end point, start and end index
+        const int64 region_pos = pos + 3 * sizeof(int32);
+        if ((read_int(pos) == 0) || (num_indices == 0)) {
+            return true;
+        }
+
+        struct FCorruption {
+            int64 pos;
+            int32 value;
+        };
+        const FCorruption corruptions[] = {
+            { indices_pos, num_pts },
+            { region_pos, -1 },
+            { region_pos + (int64)sizeof(int32), num_pts },
+            { region_pos + 2 * (int64)sizeof(int32), -1 },
+            { region_pos + 3 * (int64)sizeof(int32), num_indices },
+        };
+
+        int32 num_accepted = 0;
+        for (const FCorruption& cur_corruption : corruptions) {
+            TArray<uint8> corrupt_data = cooked_data;
+            FMemory::Memcpy(corrupt_data.GetData() + cur_corruption.pos, &cur_corruption.value, sizeof(int32));
+            CreatureModule::CreatureLoadDataPacket corrupt_load_data;
+            if (CreatureModule::LoadCreatureBinaryDataFromBuffer(corrupt_data.GetData(), corrupt_data.Num(), corrupt_load_data)) {
+                num_accepted++;
+            }
+        }
+
+        if (num_accepted > 0) {
+            std::fprintf(stderr, "CreatureBench - %s accepted %d cooked files with out of range indices or regions\n",
+                filename_in.c_str(), num_accepted);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool RunFile(const std::string& filename_in, int32 num_frames, bool check_skinning, int32 crowd_size)
+    {
+        std::string file_data;
+        if (!ReadFile(filename_in, file_data)) {
+            std::fprintf(stderr, "CreatureBench - Could not read %s\n", filename_in.c_str());
+            return false;
+        }
+
+        std::printf("== %s (%.2f MB)\n", filename_in.c_str(), ToMb((int64)file_data.size()));
+
+        FString json_string(file_data);
+        file_data.clear();
+        file_data.shrink_to_fit();
+
+        // Parse
+        int64 base_bytes = live_bytes.load();
+        auto load_data = TSharedPtr<CreatureModule::CreatureLoadDataPacket>(new CreatureModule::CreatureLoadDataPacket());
+        auto parse_start = FClock::now();
+        CreatureModule::LoadCreatureJSONDataFromString(json_string, *load_data);
+        double parse_ms = ElapsedMs(parse_start);
+        int64 dom_bytes = live_bytes.load() - base_bytes;
+
+        // Build character and animations
+        FBenchCharacter json_character = BuildCharacter(*load_data);
+        int64 loaded_bytes = live_bytes.load() - base_bytes;
+
+        // Full float reference for quantized displacements, left out of the memory figures
+        const int32 quantize_bits = meshDisplacementCacheManager::getDefaultQuantizeBits();
+        FBenchCharacter float_character;
+        int64 reference_bytes = 0;
+        if (quantize_bits > 0) {
+            int64 reference_base_bytes = live_bytes.load();
+            meshDisplacementCacheManager::setDefaultQuantizeBits(0);
+            float_character = BuildCharacter(*load_data);
+            meshDisplacementCacheManager::setDefaultQuantizeBits(quantize_bits);
+            reference_bytes = live_bytes.load() - reference_base_bytes;
+        }
+
+        // Cook to the binary format, then drop the json
+        TArray<uint8> cooked_data;
+        bool cook_ok = CreatureModule::SaveCreatureBinaryData(*load_data, cooked_data);
+        load_data.Reset();
+        int64 runtime_bytes = live_bytes.load() - base_bytes - reference_bytes - (int64)cooked_data.GetAllocatedSize();
+
+        const TArray<FName>& all_animation_names = json_character.creature->GetAnimationNames();
+        if ((all_animation_names.Num() == 0) || (json_character.creature->GetTotalNumPoints() == 0)) {
+            std::fprintf(stderr, "CreatureBench - %s has no mesh or animations\n", filename_in.c_str());
+            return false;
+        }
+
+        std::printf("  points %d, indices %d, regions %d, bones %d, animations %d\n",
+            json_character.creature->GetTotalNumPoints(),
+            json_character.creature->GetTotalNumIndices(),
+            json_character.creature->GetRenderComposition()->getRegions().Num(),
+            json_character.creature->GetRenderComposition()->getBonesMap().Num(),
+            all_animation_names.Num());
+        std::printf("  json load: parse %.2f ms, creature %.2f ms, animations %.2f ms, total %.2f ms\n",
+            parse_ms, json_character.creature_ms, json_character.animations_ms,
+            parse_ms + json_character.creature_ms + json_character.animations_ms);
+        std::printf("  memory: json dom %.2f MB, after load %.2f MB, resident runtime %.2f MB\n",
+            ToMb(dom_bytes), ToMb(loaded_bytes), ToMb(runtime_bytes));
+
+        // Binary load
+        int64 binary_base_bytes = live_bytes.load();
+        CreatureModule::CreatureLoadDataPacket binary_load_data;
+        auto binary_start = FClock::now();
+        bool binary_ok = cook_ok
+            && CreatureModule::LoadCreatureBinaryDataFromBuffer(cooked_data.GetData(), cooked_data.Num(), binary_load_data);
+        double binary_read_ms = ElapsedMs(binary_start);
+        if (!binary_ok) {
+            std::fprintf(stderr, "CreatureBench - %s failed to cook to binary\n", filename_in.c_str());
+            return false;
+        }
+
+        if (!CheckCorruptBinary(filename_in, cooked_data)) {
+            return false;
+        }
+
+        FBenchCharacter binary_character = BuildCharacter(binary_load_data);
+        int64 binary_bytes = live_bytes.load() - binary_base_bytes;
+        std::printf("  binary load (%.2f MB): read %.2f ms, creature %.2f ms, animations %.2f ms, total %.2f ms, heap %.2f MB\n",
+            ToMb(cooked_data.Num()), binary_read_ms, binary_character.creature_ms, binary_character.animations_ms,
+            binary_read_ms + binary_character.creature_ms + binary_character.animations_ms, ToMb(binary_bytes));
+
+        // Memory mapped load, the animation caches are read in place from the file
+        std::string mapped_filename = "CreatureBench_" + filename_in.substr(filename_in.find_last_of("/\\") + 1) + ".bin";
+        if (!WriteFile(mapped_filename, cooked_data)) {
+            std::fprintf(stderr, "CreatureBench - Could not write %s\n", mapped_filename.c_str());
+            return false;
+        }
+
+        int64 mapped_base_bytes = live_bytes.load();
+        CreatureModule::CreatureLoadDataPacket mapped_load_data;
+        auto mapped_start = FClock::now();
+        bool mapped_ok = CreatureModule::LoadCreatureBinaryData(FName(mapped_filename.c_str()), mapped_load_data);
+        double mapped_read_ms = ElapsedMs(mapped_start);
+        if (!mapped_ok) {
+            std::fprintf(stderr, "CreatureBench - %s failed to load mapped\n", mapped_filename.c_str());
+            std::remove(mapped_filename.c_str());
+            return false;
+        }
+
+        FBenchCharacter mapped_character = BuildCharacter(mapped_load_data);
+        int64 mapped_bytes = live_bytes.load() - mapped_base_bytes;
+        std::printf("  mapped load (%s): read %.2f ms, creature %.2f ms, animations %.2f ms, total %.2f ms, heap %.2f MB\n",
+            mapped_load_data.binary_storage->IsMapped() ? "mmap" : "read",
+            mapped_read_ms, mapped_character.creature_ms, mapped_character.animations_ms,
+            mapped_read_ms + mapped_character.creature_ms + mapped_character.animations_ms, ToMb(mapped_bytes));
+
+        // Instances created from one shared template only own their pose state
+        const int32 num_instances = 16;
+        TArray<FBenchCharacter> instances;
+        int64 instance_base_bytes = live_bytes.load();
+        auto instance_start = FClock::now();
+        for (int32 i = 0; i < num_instances; i++) {
+            instances.Add(MakeInstance(mapped_character));
+        }
+
+        double instance_ms = ElapsedMs(instance_start);
+        int64 instance_bytes = live_bytes.load() - instance_base_bytes;
+        std::printf("  instances: %d from one template, %.3f ms and %.3f MB each, standalone creature %.3f MB\n",
+            num_instances, instance_ms / num_instances, ToMb(instance_bytes / num_instances),
+            ToMb(mapped_character.creature_bytes));
+
+        // Update
+        TArray<double> frame_times;
+        FCreatureStandaloneStat::ClearAllStats();
+        int64 update_allocs_start = total_allocs.load();
+        double checksum = PlayAnimations(json_character, num_frames, &frame_times);
+        int64 update_allocs = total_allocs.load() - update_allocs_start;
+
+        frame_times.Sort([](double a, double b) { return a < b; });
+        double frame_sum = 0;
+        for (auto cur_time : frame_times) {
+            frame_sum += cur_time;
+        }
+
+        int32 total_frames = frame_times.Num();
+        std::printf("  update: %d frames, avg %.4f ms, min %.4f ms, p95 %.4f ms, max %.4f ms, %.1f allocs/frame\n",
+            total_frames,
+            frame_sum / total_frames,
+            frame_times[0],
+            frame_times[FMath::Min(total_frames - 1, (int32)(total_frames * 0.95))],
+            frame_times.Last(),
+            (double)update_allocs / total_frames);
+
+        for (auto cur_stat : FCreatureStandaloneStat::GetAllStats()) {
+            if (cur_stat->GetCallCount() > 0) {
+                std::printf("    %-48s %8llu calls %10.4f ms/frame\n",
+                    cur_stat->GetName(),
+                    (unsigned long long)cur_stat->GetCallCount(),
+                    (double)cur_stat->GetTotalNs() / 1.0e6 / total_frames);
+            }
+        }
+
+        std::printf("  pose checksum: %.6f\n", checksum);
+
+        // The binary path must pose exactly like the json path
+        double binary_checksum = PlayAnimations(binary_character, num_frames, nullptr);
+        double mapped_checksum = PlayAnimations(mapped_character, num_frames, nullptr);
+        double instance_checksum = PlayAnimations(instances[0], num_frames, nullptr);
+        std::remove(mapped_filename.c_str());
+        if (binary_checksum != checksum) {
+            std::fprintf(stderr, "CreatureBench - %s binary pose checksum %.6f does not match json\n",
+                filename_in.c_str(), binary_checksum);
+            return false;
+        }
+
+        if (mapped_checksum != checksum) {
+            std::fprintf(stderr, "CreatureBench - %s mapped pose checksum %.6f does not match json\n",
+                filename_in.c_str(), mapped_checksum);
+            return false;
+        }
+
+        if (instance_checksum != checksum) {
+            std::fprintf(stderr, "CreatureBench - %s template instance pose checksum %.6f does not match json\n",
+                filename_in.c_str(), instance_checksum);
+            return false;
+        }
+
+        if (!CheckUnpackWhilePosing(filename_in, binary_character, num_frames, checksum)) {
+            return false;
+        }
+
+        if (check_skinning && !CheckSkinningModes(filename_in, json_character, num_frames)) {
+            return false;
+        }
+
+        if ((quantize_bits > 0)
+            && !CheckQuantizedDisplacements(filename_in, json_character, float_character, num_frames, quantize_bits)) {
+            return false;
+        }
+
+        if ((crowd_size > 0) && !RunCrowd(filename_in, mapped_character, num_frames, crowd_size)) {
+            return false;
+        }
+
+        if (!RunPointCache(filename_in, mapped_character, num_frames)) {
+            return false;
+        }
+
+        if (!CheckPointCacheBuilds(filename_in, mapped_character, num_frames)) {
+            return false;
+        }
+
+        if (!RunBlending(filename_in, mapped_character, num_frames)) {
+            return false;
+        }
+
+        if (!CheckPoseHandoff(filename_in, mapped_character, num_frames)) {
+            return false;
+        }
+
+        if (!RunBlendSpace(filename_in, mapped_character, num_frames, checksum)) {
+            return false;
+        }
+
+        if (!RunOnDemand(filename_in, json_string, num_frames, json_character.animations_ms, checksum)) {
+            return false;
+        }
+
+        if (!CheckAsyncLoad(filename_in, num_frames, checksum)) {
+            return false;
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    int32 num_frames = 300;
+    bool check_skinning = false;
+    int32 crowd_size = 64;
+    std::vector<std::string> filenames;
+
+    for (int i = 1; i < argc; i++) {
+        std::string cur_arg(argv[i]);
+        if ((cur_arg == "--frames") && (i + 1 < argc)) {
+            num_frames = FMath::Max(1, std::atoi(argv[++i]));
+        }
+        else if ((cur_arg == "--threads") && (i + 1 < argc)) {
+            CreatureStandaloneSetNumWorkerThreads(std::atoi(argv[++i]));
+        }
+        else if ((cur_arg == "--skinning") && (i + 1 < argc)) {
+            std::string mode_name(argv[++i]);
+            const meshSkinningMode all_modes[] = { MESH_SKINNING_SCALAR, MESH_SKINNING_SSE, MESH_SKINNING_AVX2, MESH_SKINNING_NEON };
+            for (auto cur_mode : all_modes) {
+                if (mode_name == getMeshSkinningModeName(cur_mode)) {
+                    setMeshSkinningMode(cur_mode);
+                }
+            }
+        }
+        else if (cur_arg == "--check-skinning") {
+            check_skinning = true;
+        }
+        else if ((cur_arg == "--min-parallel-pts") && (i + 1 < argc)) {
+            meshPoseScheduler::setMinParallelPts(std::atoi(argv[++i]));
+        }
+        else if ((cur_arg == "--chunk-pts") && (i + 1 < argc)) {
+            meshPoseScheduler::setChunkPts(std::atoi(argv[++i]));
+        }
+        else if ((cur_arg == "--crowd") && (i + 1 < argc)) {
+            crowd_size = FMath::Max(0, std::atoi(argv[++i]));
+        }
+        else if ((cur_arg == "--quantize-displacements") && (i + 1 < argc)) {
+            meshDisplacementCacheManager::setDefaultQuantizeBits(std::atoi(argv[++i]));
+        }
+        else if ((cur_arg == "--help") || (cur_arg == "-h")) {
+            std::printf("Usage: CreatureBench [--frames N] [--threads N] [--skinning MODE] [--check-skinning] "
+                "[--min-parallel-pts N] [--chunk-pts N] [--crowd N] [--quantize-displacements BITS] [file.json ...]\n");
+            return 0;
+        }
+        else {
+            filenames.push_back(cur_arg);
+        }
+    }
+
+    if (filenames.empty()) {
+        const std::string samples_dir = CREATURE_SAMPLES_DIR;
+        filenames.push_back(samples_dir + "/horseman.json");
+        filenames.push_back(samples_dir + "/bat.json");
+        filenames.push_back(samples_dir + "/swapGirl.json");
+    }
+
+    std::printf("CreatureBench - %d frames per animation, %d thread(s), %s skinning, parallel posing from %d points in chunks of %d\n",
+        num_frames, CreatureStandaloneGetNumWorkerThreads(), getMeshSkinningModeName(getMeshSkinningMode()),
+        meshPoseScheduler::getMinParallelPts(), meshPoseScheduler::getChunkPts());
+
+    bool all_ok = true;
+    for (auto& cur_filename : filenames) {
+        all_ok = RunFile(cur_filename, num_frames, check_skinning, crowd_size) && all_ok;
+    }
+
+    return all_ok ? 0 : 1;
+}
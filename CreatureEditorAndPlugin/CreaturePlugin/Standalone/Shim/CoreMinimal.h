@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Creature Runtimes - Standalone Shim
+ *
+ * Thin replacement for the handful of Unreal Engine Core types the Creature
+ * runtime (CreatureModule, MeshBone, gason) depends on. This lets the core
+ * runtime compile and run headless outside of UE4, for benchmarking and
+ * regression testing. Only the API surface actually used by the runtime is
+ * provided; semantics follow the engine where it matters (insertion ordered
+ * TMap iteration, case-insensitive FName comparison, recursive locks).
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef CREATURE_STANDALONE
+#define CREATURE_STANDALONE 1
+#endif
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <type_traits>
+#include <initializer_list>
+
+// Basic types
+typedef int8_t int8;
+typedef int16_t int16;
+typedef int32_t int32;
+typedef int64_t int64;
+typedef uint8_t uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef uint64_t uint64;
+typedef char TCHAR;
+typedef char ANSICHAR;
+
+#define TEXT(x) x
+#define TCHAR_TO_UTF8(x) (x)
+#define UTF8_TO_TCHAR(x) (x)
+#define FORCEINLINE inline
+#define CREATUREPLUGIN_API
+
+#undef PI
+#define PI (3.1415926535897932f)
+
+enum { INDEX_NONE = -1 };
+
+#define check(expr) assert(expr)
+#define checkf(expr, ...) assert(expr)
+
+// Logging
+#define UE_LOG(Category, Verbosity, Format, ...) \
+    do { std::fprintf(stderr, "[" #Category "][" #Verbosity "] " Format "\n", ##__VA_ARGS__); } while(0)
+
+// Memory, routed through operator new so allocation tracking sees it
+struct FMemory
+{
+    static void * Malloc(size_t count) { return ::operator new(count); }
+    static void Free(void * ptr) { ::operator delete(ptr); }
+    static void * Memcpy(void * dest, const void * src, size_t count) { return std::memcpy(dest, src, count); }
+    static void * Memzero(void * dest, size_t count) { return std::memset(dest, 0, count); }
+    static int32 Memcmp(const void * buf_1, const void * buf_2, size_t count) { return std::memcmp(buf_1, buf_2, count); }
+};
+
+// Math
+struct FMath
+{
+    template <typename T>
+    static T Clamp(const T x, const T lower, const T upper)
+    {
+        return x < lower ? lower : (x < upper ? x : upper);
+    }
+
+    template <typename T>
+    static T Max(const T a, const T b) { return (a >= b) ? a : b; }
+
+    template <typename T>
+    static T Min(const T a, const T b) { return (a <= b) ? a : b; }
+
+    template <typename T>
+    static T Abs(const T a) { return (a >= (T)0) ? a : -a; }
+
+    template <typename T, typename U>
+    static T Lerp(const T& a, const T& b, const U& alpha) { return (T)(a + alpha * (b - a)); }
+
+    static int32 DivideAndRoundUp(int32 dividend, int32 divisor) { return (dividend + divisor - 1) / divisor; }
+};
+
+inline uint32 HashCombine(uint32 a, uint32 c)
+{
+    return a ^ (c + 0x9e3779b9u + (a << 6) + (a >> 2));
+}
+
+inline uint32 GetTypeHash(int32 value) { return (uint32)value; }
+inline uint32 GetTypeHash(uint32 value) { return value; }
+inline uint32 GetTypeHash(int64 value) { return (uint32)value + ((uint32)(value >> 32) * 23); }
+inline uint32 GetTypeHash(const void * value) { return GetTypeHash((int64)(intptr_t)value); }
+
+#include "CreatureStandaloneContainers.h"
+#include "CreatureStandaloneStats.h"
@@ -0,0 +1,331 @@
+/******************************************************************************
+ * Creature Runtimes - Standalone Shim
+ *
+ * Out of line parts of the shim: the FName table, the stats registry, the
+ * ParallelFor worker pool and memory mapped files.
+ *****************************************************************************/
+
+#include "CoreMinimal.h"
+#include "Runtime/Core/Public/Async/ParallelFor.h"
+#include "Runtime/Core/Public/HAL/PlatformFilemanager.h"
+#include <cctype>
+#include <thread>
+#include <condition_variable>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// FName
+namespace {
+    struct FNameTable {
+        std::mutex lock;
+        std::unordered_map<std::string, int32> lookup;
+        std::vector<std::string> display_names;
+
+        FNameTable()
+        {
+            display_names.push_back("None");
+            lookup["none"] = 0;
+        }
+    };
+
+    FNameTable& GetNameTable()
+    {
+        static FNameTable table;
+        return table;
+    }
+}
+
+FName::FName(const char * str_in)
+{
+    index = 0;
+    if ((str_in == nullptr) || (str_in[0] == 0)) {
+        return;
+    }
+
+    std::string lower_str(str_in);
+    for (auto& cur_char : lower_str) {
+        cur_char = (char)std::tolower((unsigned char)cur_char);
+    }
+
+    FNameTable& table = GetNameTable();
+    std::lock_guard<std::mutex> scope_lock(table.lock);
+    auto found = table.lookup.find(lower_str);
+    if (found != table.lookup.end()) {
+        index = found->second;
+        return;
+    }
+
+    index = (int32)table.display_names.size();
+    table.display_names.push_back(str_in);
+    table.lookup[lower_str] = index;
+}
+
+FString FName::ToString() const
+{
+    FNameTable& table = GetNameTable();
+    std::lock_guard<std::mutex> scope_lock(table.lock);
+    return FString(table.display_names[index]);
+}
+
+// Stats
+FCreatureStandaloneStat::FCreatureStandaloneStat(const char * name_in)
+    : name(name_in), total_ns(0), call_count(0)
+{
+    GetAllStats().Add(this);
+}
+
+TArray<FCreatureStandaloneStat *>& FCreatureStandaloneStat::GetAllStats()
+{
+    static TArray<FCreatureStandaloneStat *> all_stats;
+    return all_stats;
+}
+
+void FCreatureStandaloneStat::ClearAllStats()
+{
+    for (auto cur_stat : GetAllStats()) {
+        cur_stat->Clear();
+    }
+}
+
+// ParallelFor
+namespace {
+    thread_local bool is_pool_worker = false;
+
+    class FParallelForPool {
+    public:
+        FParallelForPool()
+        {
+            unsigned int hw_threads = std::thread::hardware_concurrency();
+            num_threads = (hw_threads > 0) ? (int32)hw_threads : 1;
+            job_generation = 0;
+            shutting_down = false;
+        }
+
+        ~FParallelForPool()
+        {
+            {
+                std::lock_guard<std::mutex> scope_lock(job_lock);
+                shutting_down = true;
+            }
+            job_signal.notify_all();
+            for (auto& cur_worker : workers) {
+                cur_worker.join();
+            }
+        }
+
+        int32 GetNumThreads() const { return num_threads; }
+
+        void SetNumThreads(int32 value_in)
+        {
+            std::lock_guard<std::mutex> dispatch_scope(dispatch_lock);
+            num_threads = (value_in < 1) ? 1 : value_in;
+        }
+
+        void Run(int32 num, const std::function<void(int32)>& body)
+        {
+            std::unique_lock<std::mutex> dispatch_scope(dispatch_lock, std::try_to_lock);
+            if (!dispatch_scope.owns_lock() || (num_threads <= 1)) {
+                // pool busy with another caller, or threading disabled
+                for (int32 i = 0; i < num; i++) {
+                    body(i);
+                }
+                return;
+            }
+
+            SpawnWorkers();
+
+            int32 num_chunks = FMath::Min(num, num_threads * 4);
+            cur_body = &body;
+            cur_num = num;
+            cur_num_chunks = num_chunks;
+            chunks_done.store(0);
+            next_chunk.store(0);
+
+            {
+                std::lock_guard<std::mutex> scope_lock(job_lock);
+                job_generation++;
+            }
+            job_signal.notify_all();
+
+            RunChunks();
+
+            std::unique_lock<std::mutex> scope_lock(job_lock);
+            done_signal.wait(scope_lock, [&]() { return chunks_done.load() == cur_num_chunks; });
+
+            // keep late waking workers from grabbing chunks while the next job is set up
+            next_chunk.store(idle_chunk_index);
+            cur_body = nullptr;
+        }
+
+    protected:
+        void SpawnWorkers()
+        {
+            while ((int32)workers.size() < (num_threads - 1)) {
+                workers.emplace_back([this]() { WorkerLoop(); });
+            }
+        }
+
+        void RunChunks()
+        {
+            while (true) {
+                int32 chunk_idx = next_chunk.fetch_add(1);
+                if (chunk_idx >= cur_num_chunks) {
+                    break;
+                }
+
+                int32 start_idx = (int32)(((int64)cur_num * chunk_idx) / cur_num_chunks);
+                int32 end_idx = (int32)(((int64)cur_num * (chunk_idx + 1)) / cur_num_chunks);
+                for (int32 i = start_idx; i < end_idx; i++) {
+                    (*cur_body)(i);
+                }
+
+                if (chunks_done.fetch_add(1) + 1 == cur_num_chunks) {
+                    std::lock_guard<std::mutex> scope_lock(job_lock);
+                    done_signal.notify_all();
+                }
+            }
+        }
+
+        void WorkerLoop()
+        {
+            is_pool_worker = true;
+            uint64 seen_generation = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> scope_lock(job_lock);
+                    job_signal.wait(scope_lock, [&]() { return shutting_down || (job_generation != seen_generation); });
+                    if (shutting_down) {
+                        return;
+                    }
+
+                    seen_generation = job_generation;
+                }
+
+                RunChunks();
+            }
+        }
+
+        int32 num_threads;
+        std::vector<std::thread> workers;
+        std::mutex dispatch_lock, job_lock;
+        std::condition_variable job_signal, done_signal;
+        uint64 job_generation;
+        bool shutting_down;
+
+        const std::function<void(int32)> * cur_body = nullptr;
+        int32 cur_num = 0, cur_num_chunks = 0;
+        static const int32 idle_chunk_index = 0x3fffffff;
+        std::atomic<int32> next_chunk{ idle_chunk_index }, chunks_done{ 0 };
+    };
+
+    FParallelForPool& GetParallelForPool()
+    {
+        static FParallelForPool pool;
+        return pool;
+    }
+}
+
+int32 CreatureStandaloneGetNumWorkerThreads()
+{
+    return GetParallelForPool().GetNumThreads();
+}
+
+void CreatureStandaloneSetNumWorkerThreads(int32 num_threads_in)
+{
+    GetParallelForPool().SetNumThreads(num_threads_in);
+}
+
+void ParallelFor(int32 num, std::function<void(int32)> body, bool force_single_thread)
+{
+    if (force_single_thread || is_pool_worker || (num <= 1)) {
+        for (int32 i = 0; i < num; i++) {
+            body(i);
+        }
+        return;
+    }
+
+    GetParallelForPool().Run(num, body);
+}
+
+// Memory mapped files
+namespace {
+    class FPosixMappedFileRegion : public IMappedFileRegion {
+    public:
+        FPosixMappedFileRegion(void * map_base_in, size_t map_size_in, const uint8 * mapped_ptr_in, int64 mapped_size_in)
+            : IMappedFileRegion(mapped_ptr_in, mapped_size_in), map_base(map_base_in), map_size(map_size_in)
+        {}
+
+        virtual ~FPosixMappedFileRegion()
+        {
+            munmap(map_base, map_size);
+        }
+
+    protected:
+        void * map_base;
+        size_t map_size;
+    };
+
+    class FPosixMappedFileHandle : public IMappedFileHandle {
+    public:
+        FPosixMappedFileHandle(int file_in, int64 file_size_in)
+            : IMappedFileHandle(file_size_in), file_handle(file_in)
+        {}
+
+        virtual ~FPosixMappedFileHandle()
+        {
+            close(file_handle);
+        }
+
+        virtual IMappedFileRegion * MapRegion(int64 offset, int64 bytes_to_map, bool preload_hint) override
+        {
+            if ((offset < 0) || (offset >= file_size)) {
+                return nullptr;
+            }
+
+            // mmap offsets must be page aligned
+            int64 page_size = (int64)sysconf(_SC_PAGESIZE);
+            int64 map_offset = offset - (offset % page_size);
+            int64 mapped_size = FMath::Min(bytes_to_map, file_size - offset);
+            size_t map_size = (size_t)(mapped_size + (offset - map_offset));
+
+            void * map_base = mmap(nullptr, map_size, PROT_READ, MAP_PRIVATE, file_handle, (off_t)map_offset);
+            if (map_base == MAP_FAILED) {
+                return nullptr;
+            }
+
+            if (preload_hint) {
+                madvise(map_base, map_size, MADV_WILLNEED);
+            }
+
+            return new FPosixMappedFileRegion(map_base, map_size,
+                (const uint8 *)map_base + (offset - map_offset), mapped_size);
+        }
+
+    protected:
+        int file_handle;
+    };
+}
+
+IMappedFileHandle * IPlatformFile::OpenMapped(const TCHAR * filename)
+{
+    int file_handle = open(filename, O_RDONLY);
+    if (file_handle < 0) {
+        return nullptr;
+    }
+
+    struct stat file_stat;
+    if ((fstat(file_handle, &file_stat) != 0) || (file_stat.st_size <= 0)) {
+        close(file_handle);
+        return nullptr;
+    }
+
+    return new FPosixMappedFileHandle(file_handle, (int64)file_stat.st_size);
+}
+
+FPlatformFileManager& FPlatformFileManager::Get()
+{
+    static FPlatformFileManager manager;
+    return manager;
+}
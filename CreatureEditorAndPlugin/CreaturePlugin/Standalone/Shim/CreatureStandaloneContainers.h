@@ -0,0 +1,549 @@
+/******************************************************************************
+ * Creature Runtimes - Standalone Shim
+ *
+ * Minimal FString, FName, TArray, TMap, TSet, TSharedPtr and locking types.
+ *****************************************************************************/
+
+#pragma once
+
+// FString
+class FString {
+public:
+    FString() {}
+    FString(const char * str_in) : data(str_in ? str_in : "") {}
+    FString(const std::string& str_in) : data(str_in) {}
+
+    const TCHAR * operator*() const { return data.c_str(); }
+
+    int32 Len() const { return (int32)data.size(); }
+
+    bool IsEmpty() const { return data.empty(); }
+
+    bool StartsWith(const FString& prefix) const
+    {
+        return data.compare(0, prefix.data.size(), prefix.data) == 0;
+    }
+
+    bool operator==(const FString& other) const { return data == other.data; }
+    bool operator!=(const FString& other) const { return data != other.data; }
+
+    FString operator+(const FString& other) const { return FString(data + other.data); }
+    FString& operator+=(const FString& other) { data += other.data; return *this; }
+
+    const std::string& ToStdString() const { return data; }
+
+    template <typename... Args>
+    static FString Printf(const TCHAR * fmt, Args... args)
+    {
+        int32 needed = std::snprintf(nullptr, 0, fmt, args...);
+        std::string ret_str((size_t)(needed > 0 ? needed : 0), '\0');
+        std::snprintf(&ret_str[0], ret_str.size() + 1, fmt, args...);
+        return FString(ret_str);
+    }
+
+protected:
+    std::string data;
+};
+
+inline uint32 GetTypeHash(const FString& value)
+{
+    return (uint32)std::hash<std::string>()(value.ToStdString());
+}
+
+// FName, names are interned and compared case insensitively like the engine
+class FName {
+public:
+    FName() : index(0) {}
+    FName(const char * str_in);
+    FName(const FString& str_in) : FName(*str_in) {}
+
+    FString ToString() const;
+
+    bool IsNone() const { return index == 0; }
+
+    bool operator==(const FName& other) const { return index == other.index; }
+    bool operator!=(const FName& other) const { return index != other.index; }
+
+    int32 GetComparisonIndex() const { return index; }
+
+protected:
+    int32 index;
+};
+
+#define NAME_None FName()
+
+inline uint32 GetTypeHash(const FName& value)
+{
+    return (uint32)value.GetComparisonIndex();
+}
+
+struct FCreatureStandaloneHasher
+{
+    template <typename T>
+    size_t operator()(const T& value) const { return (size_t)GetTypeHash(value); }
+};
+
+// TArray
+template <typename T>
+class TArray {
+    // std::vector<bool> does not hand out references, so store bools as bytes
+    struct FBoolElement { bool value; };
+    typedef typename std::conditional<std::is_same<T, bool>::value, FBoolElement, T>::type StorageType;
+
+public:
+    typedef T ElementType;
+
+    TArray() {}
+    TArray(std::initializer_list<T> list_in)
+    {
+        for (const T& cur_item : list_in) {
+            Add(cur_item);
+        }
+    }
+
+    int32 Num() const { return (int32)store.size(); }
+
+    T * GetData() { return reinterpret_cast<T *>(store.data()); }
+    const T * GetData() const { return reinterpret_cast<const T *>(store.data()); }
+
+    T& operator[](int32 index) { check(IsValidIndex(index)); return GetData()[index]; }
+    const T& operator[](int32 index) const { check(IsValidIndex(index)); return GetData()[index]; }
+
+    bool IsValidIndex(int32 index) const { return (index >= 0) && (index < Num()); }
+
+    T& Last() { return GetData()[Num() - 1]; }
+    const T& Last() const { return GetData()[Num() - 1]; }
+
+    int32 Add(const T& item)
+    {
+        store.push_back(ToStorage(item));
+        return Num() - 1;
+    }
+
+    int32 Add(T&& item)
+    {
+        store.push_back(ToStorage(std::move(item)));
+        return Num() - 1;
+    }
+
+    template <typename... Args>
+    int32 Emplace(Args&&... args)
+    {
+        store.emplace_back(std::forward<Args>(args)...);
+        return Num() - 1;
+    }
+
+    int32 AddUnique(const T& item)
+    {
+        int32 found = Find(item);
+        return (found >= 0) ? found : Add(item);
+    }
+
+    int32 AddZeroed(int32 count = 1)
+    {
+        int32 old_num = Num();
+        store.resize(store.size() + count);
+        return old_num;
+    }
+
+    int32 AddUninitialized(int32 count = 1)
+    {
+        return AddZeroed(count);
+    }
+
+    int32 AddDefaulted(int32 count = 1)
+    {
+        return AddZeroed(count);
+    }
+
+    void Append(const TArray<T>& other)
+    {
+        store.insert(store.end(), other.store.begin(), other.store.end());
+    }
+
+    void Append(const T * ptr, int32 count)
+    {
+        for (int32 i = 0; i < count; i++) {
+            Add(ptr[i]);
+        }
+    }
+
+    void Insert(const T& item, int32 index)
+    {
+        store.insert(store.begin() + index, ToStorage(item));
+    }
+
+    void Empty(int32 slack = 0)
+    {
+        std::vector<StorageType>().swap(store);
+        if (slack > 0) {
+            store.reserve(slack);
+        }
+    }
+
+    void Reset(int32 new_size = 0)
+    {
+        store.clear();
+        if (new_size > 0) {
+            store.reserve(new_size);
+        }
+    }
+
+    void Reserve(int32 count) { store.reserve(count); }
+
+    void Shrink() { store.shrink_to_fit(); }
+
+    int32 Max() const { return (int32)store.capacity(); }
+
+    void SetNum(int32 count, bool allow_shrinking = true)
+    {
+        store.resize(count);
+        if (allow_shrinking) {
+            store.shrink_to_fit();
+        }
+    }
+
+    void SetNumZeroed(int32 count, bool allow_shrinking = true)
+    {
+        SetNum(count, allow_shrinking);
+    }
+
+    void SetNumUninitialized(int32 count, bool allow_shrinking = true)
+    {
+        SetNum(count, allow_shrinking);
+    }
+
+    void Init(const T& value, int32 count)
+    {
+        store.assign(count, ToStorage(value));
+    }
+
+    int32 Find(const T& item) const
+    {
+        for (int32 i = 0; i < Num(); i++) {
+            if (GetData()[i] == item) {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    bool Contains(const T& item) const { return Find(item) >= 0; }
+
+    int32 Remove(const T& item)
+    {
+        int32 old_num = Num();
+        auto new_end = std::remove_if(store.begin(), store.end(),
+            [&](const StorageType& cur_item) { return *reinterpret_cast<const T *>(&cur_item) == item; });
+        store.erase(new_end, store.end());
+        return old_num - Num();
+    }
+
+    template <typename Predicate>
+    int32 RemoveAll(Predicate pred)
+    {
+        int32 old_num = Num();
+        auto new_end = std::remove_if(store.begin(), store.end(),
+            [&](const StorageType& cur_item) { return pred(*reinterpret_cast<const T *>(&cur_item)); });
+        store.erase(new_end, store.end());
+        return old_num - Num();
+    }
+
+    void RemoveAt(int32 index, int32 count = 1)
+    {
+        store.erase(store.begin() + index, store.begin() + index + count);
+    }
+
+    T Pop()
+    {
+        T ret_val = Last();
+        store.pop_back();
+        return ret_val;
+    }
+
+    template <typename Predicate>
+    void Sort(Predicate pred)
+    {
+        std::sort(GetData(), GetData() + Num(), pred);
+    }
+
+    void Sort()
+    {
+        std::sort(GetData(), GetData() + Num());
+    }
+
+    bool operator==(const TArray<T>& other) const
+    {
+        if (Num() != other.Num()) {
+            return false;
+        }
+
+        for (int32 i = 0; i < Num(); i++) {
+            if (!(GetData()[i] == other.GetData()[i])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    size_t GetAllocatedSize() const { return store.capacity() * sizeof(StorageType); }
+
+    T * begin() { return GetData(); }
+    T * end() { return GetData() + Num(); }
+    const T * begin() const { return GetData(); }
+    const T * end() const { return GetData() + Num(); }
+
+protected:
+    static const StorageType& ToStorage(const T& item) { return *reinterpret_cast<const StorageType *>(&item); }
+    static StorageType&& ToStorage(T&& item) { return std::move(*reinterpret_cast<StorageType *>(&item)); }
+
+    std::vector<StorageType> store;
+};
+
+// TPair
+template <typename KeyType, typename ValueType>
+struct TPair {
+    TPair() {}
+    TPair(const KeyType& key_in, const ValueType& value_in) : Key(key_in), Value(value_in) {}
+
+    KeyType Key;
+    ValueType Value;
+};
+
+// TMap, iterates in insertion order like the engine's sparse array backed map
+template <typename KeyType, typename ValueType>
+class TMap {
+public:
+    typedef TPair<KeyType, ValueType> ElementType;
+
+    int32 Num() const { return elements.Num(); }
+
+    ValueType& Add(const KeyType& key_in, const ValueType& value_in)
+    {
+        auto found = key_lookup.find(key_in);
+        if (found != key_lookup.end()) {
+            elements[found->second].Value = value_in;
+            return elements[found->second].Value;
+        }
+
+        key_lookup[key_in] = elements.Add(ElementType(key_in, value_in));
+        return elements.Last().Value;
+    }
+
+    ValueType& Add(const KeyType& key_in)
+    {
+        return Add(key_in, ValueType());
+    }
+
+    bool Contains(const KeyType& key_in) const
+    {
+        return key_lookup.find(key_in) != key_lookup.end();
+    }
+
+    ValueType * Find(const KeyType& key_in)
+    {
+        auto found = key_lookup.find(key_in);
+        return (found != key_lookup.end()) ? &elements[found->second].Value : nullptr;
+    }
+
+    const ValueType * Find(const KeyType& key_in) const
+    {
+        auto found = key_lookup.find(key_in);
+        return (found != key_lookup.end()) ? &elements[found->second].Value : nullptr;
+    }
+
+    ValueType FindRef(const KeyType& key_in) const
+    {
+        const ValueType * found = Find(key_in);
+        return found ? *found : ValueType();
+    }
+
+    ValueType& FindOrAdd(const KeyType& key_in)
+    {
+        ValueType * found = Find(key_in);
+        return found ? *found : Add(key_in);
+    }
+
+    ValueType& FindChecked(const KeyType& key_in)
+    {
+        ValueType * found = Find(key_in);
+        check(found != nullptr);
+        return *found;
+    }
+
+    const ValueType& FindChecked(const KeyType& key_in) const
+    {
+        const ValueType * found = Find(key_in);
+        check(found != nullptr);
+        return *found;
+    }
+
+    ValueType& operator[](const KeyType& key_in) { return FindChecked(key_in); }
+    const ValueType& operator[](const KeyType& key_in) const { return FindChecked(key_in); }
+
+    int32 Remove(const KeyType& key_in)
+    {
+        auto found = key_lookup.find(key_in);
+        if (found == key_lookup.end()) {
+            return 0;
+        }
+
+        elements.RemoveAt(found->second);
+        key_lookup.clear();
+        for (int32 i = 0; i < elements.Num(); i++) {
+            key_lookup[elements[i].Key] = i;
+        }
+
+        return 1;
+    }
+
+    void Empty()
+    {
+        elements.Empty();
+        key_lookup.clear();
+    }
+
+    void Reset() { Empty(); }
+
+    int32 GetKeys(TArray<KeyType>& out_keys) const
+    {
+        out_keys.Reset();
+        for (const auto& cur_item : elements) {
+            out_keys.Add(cur_item.Key);
+        }
+
+        return out_keys.Num();
+    }
+
+    void GenerateValueArray(TArray<ValueType>& out_values) const
+    {
+        out_values.Reset();
+        for (const auto& cur_item : elements) {
+            out_values.Add(cur_item.Value);
+        }
+    }
+
+    ElementType * begin() { return elements.begin(); }
+    ElementType * end() { return elements.end(); }
+    const ElementType * begin() const { return elements.begin(); }
+    const ElementType * end() const { return elements.end(); }
+
+protected:
+    TArray<ElementType> elements;
+    std::unordered_map<KeyType, int32, FCreatureStandaloneHasher> key_lookup;
+};
+
+// TSet
+template <typename T>
+class TSet {
+public:
+    int32 Num() const { return items.Num(); }
+
+    void Add(const T& item)
+    {
+        if (!Contains(item)) {
+            items.Add(item, true);
+        }
+    }
+
+    bool Contains(const T& item) const { return items.Contains(item); }
+
+    int32 Remove(const T& item) { return items.Remove(item); }
+
+    void Empty() { items.Empty(); }
+
+    void Reset() { items.Empty(); }
+
+    struct FIterator {
+        const TPair<T, bool> * cur_ptr;
+        const T& operator*() const { return cur_ptr->Key; }
+        FIterator& operator++() { ++cur_ptr; return *this; }
+        bool operator!=(const FIterator& other) const { return cur_ptr != other.cur_ptr; }
+    };
+
+    FIterator begin() const { return FIterator{ items.begin() }; }
+    FIterator end() const { return FIterator{ items.end() }; }
+
+protected:
+    TMap<T, bool> items;
+};
+
+// TSharedPtr
+namespace ESPMode
+{
+    enum Type {
+        Fast,
+        NotThreadSafe = Fast,
+        ThreadSafe
+    };
+}
+
+template <typename T, ESPMode::Type Mode = ESPMode::Fast>
+class TSharedPtr {
+public:
+    TSharedPtr() {}
+    TSharedPtr(std::nullptr_t) {}
+    explicit TSharedPtr(T * ptr_in) : ptr(ptr_in) {}
+
+    template <typename U, ESPMode::Type OtherMode>
+    TSharedPtr(const TSharedPtr<U, OtherMode>& other) : ptr(other.GetStdPtr()) {}
+
+    T * Get() const { return ptr.get(); }
+    bool IsValid() const { return ptr != nullptr; }
+    explicit operator bool() const { return IsValid(); }
+    void Reset() { ptr.reset(); }
+
+    T * operator->() const { return ptr.get(); }
+    T& operator*() const { return *ptr; }
+
+    bool operator==(const TSharedPtr& other) const { return ptr == other.ptr; }
+    bool operator!=(const TSharedPtr& other) const { return ptr != other.ptr; }
+
+    int32 GetSharedReferenceCount() const { return (int32)ptr.use_count(); }
+
+    const std::shared_ptr<T>& GetStdPtr() const { return ptr; }
+
+protected:
+    std::shared_ptr<T> ptr;
+};
+
+template <typename T>
+TSharedPtr<T> MakeShareable(T * ptr_in)
+{
+    return TSharedPtr<T>(ptr_in);
+}
+
+template <typename T, typename... Args>
+TSharedPtr<T> MakeShared(Args&&... args)
+{
+    return TSharedPtr<T>(new T(std::forward<Args>(args)...));
+}
+
+// Locking, engine critical sections are recursive
+class FCriticalSection {
+public:
+    FCriticalSection() {}
+    FCriticalSection(const FCriticalSection&) = delete;
+    FCriticalSection& operator=(const FCriticalSection&) = delete;
+
+    void Lock() { mutex.lock(); }
+    bool TryLock() { return mutex.try_lock(); }
+    void Unlock() { mutex.unlock(); }
+
+protected:
+    std::recursive_mutex mutex;
+};
+
+class FScopeLock {
+public:
+    explicit FScopeLock(FCriticalSection * section_in) : section(section_in) { section->Lock(); }
+    ~FScopeLock() { section->Unlock(); }
+
+    FScopeLock(const FScopeLock&) = delete;
+    FScopeLock& operator=(const FScopeLock&) = delete;
+
+protected:
+    FCriticalSection * section;
+};
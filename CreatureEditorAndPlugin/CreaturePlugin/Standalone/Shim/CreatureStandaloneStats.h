@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Creature Runtimes - Standalone Shim
+ *
+ * Cycle stats. DECLARE_CYCLE_STAT registers a named accumulator and
+ * SCOPE_CYCLE_COUNTER adds the scope's wall time to it, so the benchmark
+ * harness can report the same per-stage breakdown as "stat Creature".
+ *****************************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+class FCreatureStandaloneStat {
+public:
+    explicit FCreatureStandaloneStat(const char * name_in);
+
+    const char * GetName() const { return name; }
+
+    void AddTime(uint64 nanoseconds_in)
+    {
+        total_ns.fetch_add(nanoseconds_in, std::memory_order_relaxed);
+        call_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64 GetTotalNs() const { return total_ns.load(std::memory_order_relaxed); }
+
+    uint64 GetCallCount() const { return call_count.load(std::memory_order_relaxed); }
+
+    void Clear()
+    {
+        total_ns.store(0, std::memory_order_relaxed);
+        call_count.store(0, std::memory_order_relaxed);
+    }
+
+    // All stats declared so far, in registration order
+    static TArray<FCreatureStandaloneStat *>& GetAllStats();
+
+    static void ClearAllStats();
+
+protected:
+    const char * name;
+    std::atomic<uint64> total_ns;
+    std::atomic<uint64> call_count;
+};
+
+class FCreatureStandaloneScopeCounter {
+public:
+    explicit FCreatureStandaloneScopeCounter(FCreatureStandaloneStat& stat_in)
+        : stat(stat_in), start_time(std::chrono::steady_clock::now())
+    {}
+
+    ~FCreatureStandaloneScopeCounter()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start_time;
+        stat.AddTime((uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+protected:
+    FCreatureStandaloneStat& stat;
+    std::chrono::steady_clock::time_point start_time;
+};
+
+#define CREATURE_STANDALONE_CONCAT_INNER(a, b) a##b
+#define CREATURE_STANDALONE_CONCAT(a, b) CREATURE_STANDALONE_CONCAT_INNER(a, b)
+
+#define DECLARE_STATS_GROUP(GroupDesc, GroupId, GroupCat)
+#define DECLARE_CYCLE_STAT(CounterName, StatId, GroupId) \
+    static FCreatureStandaloneStat StatId(CounterName)
+#define SCOPE_CYCLE_COUNTER(StatId) \
+    FCreatureStandaloneScopeCounter CREATURE_STANDALONE_CONCAT(scope_cycle_counter_, __LINE__)(StatId)
@@ -0,0 +1,26 @@
+/******************************************************************************
+ * Creature Runtimes - Standalone Shim
+ *
+ * Async() runs a callable on its own std::async thread whatever execution is
+ * asked for, and returns a TFuture for its result.
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Future.h"
+
+enum class EAsyncExecution
+{
+    TaskGraph,
+    TaskGraphMainThread,
+    Thread,
+    ThreadPool
+};
+
+template <typename CallableType>
+auto Async(EAsyncExecution, CallableType&& callable) -> TFuture<decltype(callable())>
+{
+    typedef decltype(callable()) ResultType;
+    return TFuture<ResultType>(std::async(std::launch::async, std::forward<CallableType>(callable)).share());
+}
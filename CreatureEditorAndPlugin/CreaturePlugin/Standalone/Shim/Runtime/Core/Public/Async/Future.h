@@ -0,0 +1,31 @@
+/******************************************************************************
+ * Creature Runtimes - Standalone Shim
+ *
+ * TFuture over std::shared_future. Unlike the engine version it is copyable,
+ * which code written against the move only engine type never relies on.
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <chrono>
+#include <future>
+
+template <typename ResultType>
+class TFuture {
+public:
+    TFuture() {}
+    explicit TFuture(std::shared_future<ResultType>&& state_in) : state(std::move(state_in)) {}
+
+    bool IsValid() const { return state.valid(); }
+
+    bool IsReady() const { return state.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+    void Wait() const { state.wait(); }
+
+    // Blocks until the result is set
+    ResultType Get() const { return state.get(); }
+
+protected:
+    std::shared_future<ResultType> state;
+};
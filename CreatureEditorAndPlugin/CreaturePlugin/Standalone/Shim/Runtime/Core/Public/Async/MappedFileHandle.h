@@ -0,0 +1,45 @@
+/******************************************************************************
+ * Creature Runtimes - Standalone Shim
+ *
+ * Read only memory mapped files, matching the engine's IMappedFileHandle /
+ * IMappedFileRegion interface. Handles come from IPlatformFile::OpenMapped().
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#ifndef MAX_int64
+#define MAX_int64 ((int64)0x7fffffffffffffff)
+#endif
+
+class IMappedFileRegion {
+public:
+    IMappedFileRegion(const uint8 * mapped_ptr_in, int64 mapped_size_in)
+        : mapped_ptr(mapped_ptr_in), mapped_size(mapped_size_in)
+    {}
+
+    virtual ~IMappedFileRegion() {}
+
+    const uint8 * GetMappedPtr() const { return mapped_ptr; }
+    int64 GetMappedSize() const { return mapped_size; }
+
+protected:
+    const uint8 * mapped_ptr;
+    int64 mapped_size;
+};
+
+class IMappedFileHandle {
+public:
+    IMappedFileHandle(int64 file_size_in) : file_size(file_size_in) {}
+
+    virtual ~IMappedFileHandle() {}
+
+    int64 GetFileSize() const { return file_size; }
+
+    // Regions must be deleted before the handle
+    virtual IMappedFileRegion * MapRegion(int64 offset = 0, int64 bytes_to_map = MAX_int64, bool preload_hint = false) = 0;
+
+protected:
+    int64 file_size;
+};
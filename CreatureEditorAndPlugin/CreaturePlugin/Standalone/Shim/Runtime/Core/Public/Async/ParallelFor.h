@@ -0,0 +1,19 @@
+/******************************************************************************
+ * Creature Runtimes - Standalone Shim
+ *
+ * ParallelFor over a small persistent worker pool. Like the engine version,
+ * the calling thread takes part in the work and nested calls made from a
+ * worker run serially.
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Number of threads (including the caller) ParallelFor may use
+int32 CreatureStandaloneGetNumWorkerThreads();
+
+// Overrides the thread count, 1 forces every ParallelFor to run inline
+void CreatureStandaloneSetNumWorkerThreads(int32 num_threads_in);
+
+void ParallelFor(int32 num, std::function<void(int32)> body, bool force_single_thread = false);
@@ -0,0 +1,27 @@
+/******************************************************************************
+ * Creature Runtimes - Standalone Shim
+ *
+ * The part of FPlatformFileManager / IPlatformFile the runtime uses: opening
+ * files for memory mapping. Backed by POSIX mmap.
+ *****************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Runtime/Core/Public/Async/MappedFileHandle.h"
+
+class IPlatformFile {
+public:
+    // Returns nullptr if the file does not exist or cannot be mapped
+    IMappedFileHandle * OpenMapped(const TCHAR * filename);
+};
+
+class FPlatformFileManager {
+public:
+    static FPlatformFileManager& Get();
+
+    IPlatformFile& GetPlatformFile() { return platform_file; }
+
+protected:
+    IPlatformFile platform_file;
+};
@@ -33,6 +33,13 @@ static void ReleaseVertexBuffer(FVertexBuffer& VertexBuffer)
 {
 }
 
+// FLocalVertexFactory's manual vertex fetch reads positions from the SRV as three floats a vertex,
+// so half positions only work where the vertex declaration does the fetch
+static bool CanUseHalfPositions(ERHIFeatureLevel::Type InFeatureLevel)
+{
+	return (InFeatureLevel <= ERHIFeatureLevel::ES3_1) || !RHISupportsManualVertexFetch(GShaderPlatformForFeatureLevel[InFeatureLevel]);
+}
+
 /** Vertex Buffer */
 class FProceduralMeshVertexBuffer : public FDynamicPrimitiveResource, public FRenderResource
 {
@@ -49,7 +56,7 @@ public:
 
 	mutable TArray<FDynamicMeshVertex> Vertices;
 
-	FProceduralMeshVertexBuffer(uint32 InNumTexCoords = 1, uint32 InLightmapCoordinateIndex = 0, bool InUse16bitTexCoord = false) : NumTexCoords(InNumTexCoords), LightmapCoordinateIndex(InLightmapCoordinateIndex), Use16bitTexCoord(InUse16bitTexCoord)
+	FProceduralMeshVertexBuffer(uint32 InNumTexCoords = 1, uint32 InLightmapCoordinateIndex = 0, bool InUse16bitTexCoord = false, bool InUseHalfPositions = false, bool InKeepFirstTangents = false) : NumTexCoords(InNumTexCoords), LightmapCoordinateIndex(InLightmapCoordinateIndex), Use16bitTexCoord(InUse16bitTexCoord), UseHalfPositions(InUseHalfPositions), KeepFirstTangents(InKeepFirstTangents)
 	{
 		check(NumTexCoords > 0 && NumTexCoords <= MAX_STATIC_TEXCOORDS);
 		check(LightmapCoordinateIndex < NumTexCoords);
@@ -72,7 +79,7 @@ public:
 
 		if (!buffersAllocated)
 		{
-			PositionBuffer.VertexBufferRHI = AllocVertexBuffer(sizeof(FVector), Vertices.Num());
+			PositionBuffer.VertexBufferRHI = AllocVertexBuffer(GetPositionStride(), Vertices.Num());
 			TangentBuffer.VertexBufferRHI = AllocVertexBuffer(sizeof(FPackedNormal), 2 * Vertices.Num());
 			TexCoordBuffer.VertexBufferRHI = AllocVertexBuffer(TextureStride, NumTexCoords * Vertices.Num());
 			ColorBuffer.VertexBufferRHI = AllocVertexBuffer(sizeof(FColor), Vertices.Num());
@@ -80,24 +87,48 @@ public:
 			TangentBufferSRV = RHICreateShaderResourceView(TangentBuffer.VertexBufferRHI, 4, PF_R8G8B8A8);
 			TexCoordBufferSRV = RHICreateShaderResourceView(TexCoordBuffer.VertexBufferRHI, TextureStride, TextureFormat);
 			ColorBufferSRV = RHICreateShaderResourceView(ColorBuffer.VertexBufferRHI, 4, PF_R8G8B8A8);
-			PositionBufferSRV = RHICreateShaderResourceView(PositionBuffer.VertexBufferRHI, sizeof(float), PF_R32_FLOAT);
+			PositionBufferSRV = UseHalfPositions ?
+				RHICreateShaderResourceView(PositionBuffer.VertexBufferRHI, sizeof(FFloat16), PF_R16F) :
+				RHICreateShaderResourceView(PositionBuffer.VertexBufferRHI, sizeof(float), PF_R32_FLOAT);
 			buffersAllocated = true;
+			tangentsUploaded = false;
 		}
 
+		// the compact format only sends the tangents of the first frame
+		const bool write_tangents = !(KeepFirstTangents && tangentsUploaded);
+		tangentsUploaded = true;
+
 		void* TexCoordBufferData = RHILockVertexBuffer(TexCoordBuffer.VertexBufferRHI, 0, NumTexCoords * TextureStride * Vertices.Num(), RLM_WriteOnly);
 		FVector2D* TexCoordBufferData32 = !Use16bitTexCoord ? static_cast<FVector2D*>(TexCoordBufferData) : nullptr;
 		FVector2DHalf* TexCoordBufferData16 = Use16bitTexCoord ? static_cast<FVector2DHalf*>(TexCoordBufferData) : nullptr;
 
 		// Copy the vertex data into the vertex buffers.
-		FVector* PositionBufferData = static_cast<FVector*>(RHILockVertexBuffer(PositionBuffer.VertexBufferRHI, 0, sizeof(FVector) * Vertices.Num(), RLM_WriteOnly));
-		FPackedNormal* TangentBufferData = static_cast<FPackedNormal*>(RHILockVertexBuffer(TangentBuffer.VertexBufferRHI, 0, 2 * sizeof(FPackedNormal) * Vertices.Num(), RLM_WriteOnly));
+		void* PositionBufferData = RHILockVertexBuffer(PositionBuffer.VertexBufferRHI, 0, GetPositionStride() * Vertices.Num(), RLM_WriteOnly);
+		FVector* PositionBufferData32 = !UseHalfPositions ? static_cast<FVector*>(PositionBufferData) : nullptr;
+		FFloat16* PositionBufferData16 = UseHalfPositions ? static_cast<FFloat16*>(PositionBufferData) : nullptr;
+		FPackedNormal* TangentBufferData = write_tangents ? static_cast<FPackedNormal*>(RHILockVertexBuffer(TangentBuffer.VertexBufferRHI, 0, 2 * sizeof(FPackedNormal) * Vertices.Num(), RLM_WriteOnly)) : nullptr;
 		FColor* ColorBufferData = static_cast<FColor*>(RHILockVertexBuffer(ColorBuffer.VertexBufferRHI, 0, sizeof(FColor) * Vertices.Num(), RLM_WriteOnly));
 
 		for (int32 i = 0; i < Vertices.Num(); i++)
 		{
-			PositionBufferData[i] = Vertices[i].Position;
-			TangentBufferData[2 * i + 0] = Vertices[i].TangentX;
-			TangentBufferData[2 * i + 1] = Vertices[i].TangentZ;
+			if (UseHalfPositions)
+			{
+				// x, depth, y and w as halves, 8 bytes instead of 12
+				PositionBufferData16[4 * i + 0] = FFloat16(Vertices[i].Position.X);
+				PositionBufferData16[4 * i + 1] = FFloat16(Vertices[i].Position.Y);
+				PositionBufferData16[4 * i + 2] = FFloat16(Vertices[i].Position.Z);
+				PositionBufferData16[4 * i + 3] = FFloat16(1.0f);
+			}
+			else
+			{
+				PositionBufferData32[i] = Vertices[i].Position;
+			}
+
+			if (write_tangents)
+			{
+				TangentBufferData[2 * i + 0] = Vertices[i].TangentX;
+				TangentBufferData[2 * i + 1] = Vertices[i].TangentZ;
+			}
 			ColorBufferData[i] = Vertices[i].Color;
 
 			for (uint32 j = 0; j < NumTexCoords; j++)
@@ -114,7 +145,10 @@ public:
 		}
 
 		RHIUnlockVertexBuffer(PositionBuffer.VertexBufferRHI);
-		RHIUnlockVertexBuffer(TangentBuffer.VertexBufferRHI);
+		if (write_tangents)
+		{
+			RHIUnlockVertexBuffer(TangentBuffer.VertexBufferRHI);
+		}
 		RHIUnlockVertexBuffer(TexCoordBuffer.VertexBufferRHI);
 		RHIUnlockVertexBuffer(ColorBuffer.VertexBufferRHI);
 	}
@@ -172,10 +206,23 @@ public:
 	{
 		return Use16bitTexCoord;
 	}
+
+	const bool GetUseHalfPositions() const
+	{
+		return UseHalfPositions;
+	}
+
+	uint32 GetPositionStride() const
+	{
+		return UseHalfPositions ? 4 * sizeof(FFloat16) : sizeof(FVector);
+	}
 private:
 	const uint32 NumTexCoords;
 	const uint32 LightmapCoordinateIndex;
 	const bool Use16bitTexCoord;
+	const bool UseHalfPositions;
+	const bool KeepFirstTangents;
+	bool tangentsUploaded;
 };
 
 /** Index Buffer */
@@ -219,8 +266,8 @@ public:
 			Data.PositionComponent = FVertexStreamComponent(
 				&PooledVertexBuffer->PositionBuffer,
 				0,
-				sizeof(FVector),
-				VET_Float3
+				PooledVertexBuffer->GetPositionStride(),
+				PooledVertexBuffer->GetUseHalfPositions() ? VET_Half4 : VET_Float3
 			);
 
 			Data.NumTexCoords = PooledVertexBuffer->GetNumTexCoords();
@@ -313,9 +360,12 @@ private:
 class FProceduralPackMeshRenderPacket
 {
 public:
-	FProceduralPackMeshRenderPacket(FProceduralPackMeshTriData * data_in, ERHIFeatureLevel::Type InFeatureLevel) :
+	FProceduralPackMeshRenderPacket(FProceduralPackMeshTriData * data_in, ERHIFeatureLevel::Type InFeatureLevel, bool compact_in = false) :
+		VertexBuffer(1, 0, compact_in, compact_in && CanUseHalfPositions(InFeatureLevel), compact_in),
 		VertexFactory(InFeatureLevel, &VertexBuffer)
 	{
+		use_compact_format = compact_in;
+		has_tangents = false;
 		indices = data_in->indices;
 		points = data_in->points;
 		uvs = data_in->uvs;
@@ -367,6 +417,7 @@ public:
 		{
 			VertexCache.Reset(point_num);
 			VertexCache.AddUninitialized(point_num);
+			has_tangents = false;
 		}
 
 #ifdef CREATURE_MULTICORE
@@ -395,6 +446,13 @@ public:
 		}
 #endif
 
+		// the compact format keeps the tangents of the first frame, the mesh is planar
+		if (use_compact_format && has_tangents)
+		{
+			return;
+		}
+		has_tangents = true;
+
 		// Set Tangents
 #ifdef CREATURE_MULTICORE
 		ParallelFor(indices_num / 3, [&](int32 ref_idx) {
@@ -453,6 +511,7 @@ public:
 	TArray<uint8> * region_alphas;
 	TSharedPtr<FCriticalSection, ESPMode::ThreadSafe> update_lock;
 	bool should_release;
+	bool use_compact_format, has_tangents;
 };
 
 /** Scene proxy */
@@ -465,6 +524,7 @@ FCProceduralPackMeshSceneProxy::FCProceduralPackMeshSceneProxy(
 	MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
 {
 	parentComponent = Component;
+	use_compact_format = Component->compact_vertex_format;
 	needs_index_updating = false;
 	needs_index_update_num = -1;
 	active_render_packet_idx = INDEX_NONE;
@@ -523,7 +583,7 @@ void FCProceduralPackMeshSceneProxy::AddRenderPacket(FProceduralPackMeshTriData
 	//FProceduralMeshRenderPacket new_packet(featureLevel);
 	//FProceduralMeshRenderPacket& cur_packet = renderPackets.Add_GetRef(new_packet);
 
-	renderPackets.Add(new FProceduralPackMeshRenderPacket(targetTrisIn, featureLevel));
+	renderPackets.Add(new FProceduralPackMeshRenderPacket(targetTrisIn, featureLevel, use_compact_format));
 	auto packetPtr = &(renderPackets.Last());
 	auto &cur_packet = *packetPtr;
 
@@ -756,6 +816,7 @@ UCustomPackProceduralMeshComponent::UCustomPackProceduralMeshComponent(const FOb
 	PrimaryComponentTick.bCanEverTick = false;
 	bounds_scale = 1.0f;
 	bounds_offset = FVector(0, 0, 0);
+	compact_vertex_format = false;
 	render_proxy_ready = false;
 	calc_local_vec_min = FVector(FLT_MIN, FLT_MIN, FLT_MIN);
 	calc_local_vec_max = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
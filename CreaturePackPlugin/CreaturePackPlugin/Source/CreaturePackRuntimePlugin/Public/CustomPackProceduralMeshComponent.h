@@ -104,6 +104,7 @@ private:
 	bool needs_index_updating;
 	int32 needs_index_update_num;
 	bool needs_material_updating;
+	bool use_compact_format;
 
 	mutable FCriticalSection renderPacketsCS;
 };
@@ -155,6 +156,12 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Collision")
 		class UBodySetup* ModelBodySetup;
 
+	/** Uploads half precision positions and 16 bit uvs and keeps the tangents from the first frame, for bandwidth bound scenes.
+	    Positions are in the local space of the mesh, so keep large offsets on the component transform.
+	    Platforms with manual vertex fetch keep full precision positions */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering")
+		bool compact_vertex_format;
+
 	// Begin Interface_CollisionDataProvider Interface
 	/*
 	virtual bool GetPhysicsTriMeshData(struct FTriMeshCollisionData* CollisionData, bool InUseAllTriData) override;